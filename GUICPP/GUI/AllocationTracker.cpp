@@ -0,0 +1,216 @@
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        // constant initialized, operator new may run before anything else on a thread
+        struct ThreadAllocations
+        {
+            std::array<AllocationSiteCount, AllocationTracker::MaxSites> sites;
+            size_t siteCount;
+            size_t count;
+            size_t bytes;
+            size_t totalCount;
+            size_t frame;
+            const AllocationSite* site;
+            bool isReporting;
+        };
+
+        thread_local constinit ThreadAllocations t_allocations{};
+
+        FrameAllocations& GetLastFrameOfThread()
+        {
+            thread_local FrameAllocations lastFrame;
+            return lastFrame;
+        }
+    }
+
+    void AllocationTracker::Record(size_t bytes)
+    {
+        ThreadAllocations& allocations = t_allocations;
+        ++allocations.totalCount;
+        if (allocations.isReporting)
+            return;
+        ++allocations.count;
+        allocations.bytes += bytes;
+
+        const char* category = allocations.site != nullptr ? allocations.site->category : "";
+        const char* name = allocations.site != nullptr ? allocations.site->name : "";
+        size_t index = 0;
+        while (index < allocations.siteCount
+               && (allocations.sites[index].category != category || allocations.sites[index].name != name))
+        {
+            ++index;
+        }
+        if (index == allocations.siteCount)
+        {
+            if (allocations.siteCount < MaxSites)
+            {
+                ++allocations.siteCount;
+                allocations.sites[index] = { category, name, 0, 0 };
+            }
+            else
+            {
+                index = MaxSites - 1;
+            }
+        }
+        ++allocations.sites[index].count;
+        allocations.sites[index].bytes += bytes;
+    }
+
+    void AllocationTracker::EndFrame()
+    {
+        ThreadAllocations& allocations = t_allocations;
+        // the report allocates, it is not counted in the next frame
+        allocations.isReporting = true;
+        FrameAllocations& frame = GetLastFrameOfThread();
+        frame.frame = ++allocations.frame;
+        frame.count = allocations.count;
+        frame.bytes = allocations.bytes;
+        frame.sites.assign(allocations.sites.begin(), allocations.sites.begin() + static_cast<std::ptrdiff_t>(allocations.siteCount));
+        std::ranges::sort(frame.sites, std::ranges::greater{}, &AllocationSiteCount::count);
+        allocations.isReporting = false;
+
+        allocations.count = 0;
+        allocations.bytes = 0;
+        allocations.siteCount = 0;
+    }
+
+    const FrameAllocations& AllocationTracker::GetLastFrame()
+    {
+        return GetLastFrameOfThread();
+    }
+
+    size_t AllocationTracker::GetTotalCount()
+    {
+        return t_allocations.totalCount;
+    }
+
+    void AllocationTracker::EnterSite(AllocationSite& site)
+    {
+        site.previous = t_allocations.site;
+        t_allocations.site = &site;
+    }
+
+    void AllocationTracker::LeaveSite(const AllocationSite& site)
+    {
+        t_allocations.site = site.previous;
+    }
+
+}
+
+#ifdef GUICPP_TRACK_ALLOCATIONS
+
+namespace
+{
+    void* Allocate(std::size_t size)
+    {
+        GUICPP::AllocationTracker::Record(size);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* AllocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        GUICPP::AllocationTracker::Record(size);
+        const auto align = static_cast<std::size_t>(alignment);
+#ifdef _MSC_VER
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        // aligned_alloc wants a whole number of alignments
+        return std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align);
+#endif
+    }
+
+    void FreeAligned(void* pointer)
+    {
+#ifdef _MSC_VER
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (void* pointer = Allocate(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* pointer = AllocateAligned(size, alignment))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    FreeAligned(pointer);
+}
+
+#endif
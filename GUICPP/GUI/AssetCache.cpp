@@ -0,0 +1,206 @@
+#include "AssetCache.h"
+
+#include <iostream>
+
+#include "Tracer.h"
+
+namespace GUICPP
+{
+
+    AssetCache& AssetCache::GetInstance()
+    {
+        static AssetCache instance;
+        return instance;
+    }
+
+    bool AssetCache::MountPack(const std::string& path)
+    {
+        auto pack = AssetPack::Open(path);
+        if (!pack)
+            return false;
+        MountPack(std::move(pack));
+        return true;
+    }
+
+    void AssetCache::MountPack(std::shared_ptr<const AssetPack> pack)
+    {
+        if (pack)
+            m_packs.push_back(std::move(pack));
+    }
+
+    std::shared_ptr<const sf::Texture> AssetCache::GetTexture(const std::string& path)
+    {
+        const std::string key = AssetPack::NormalizePath(path);
+        auto& entry = m_textures[key];
+        if (auto texture = entry.lock())
+        {
+            return texture;
+        }
+
+        GUICPP_TRACE_SCOPE_DETAIL("asset", "LoadTexture", path);
+        auto texture = std::make_shared<sf::Texture>();
+        const AssetPack* pack = FindPack(key);
+        if (pack != nullptr ? !pack->LoadTexture(key, *texture) : !texture->loadFromFile(path))
+        {
+            std::cout << "Failed to load texture from " << path << std::endl;
+            m_textures.erase(key);
+            return nullptr;
+        }
+        entry = texture;
+        return texture;
+    }
+
+    std::shared_ptr<sf::SoundBuffer> AssetCache::GetSoundBuffer(const std::string& path)
+    {
+        const std::string key = AssetPack::NormalizePath(path);
+        auto& entry = m_soundBuffers[key];
+        if (auto buffer = entry.lock())
+        {
+            return buffer;
+        }
+
+        GUICPP_TRACE_SCOPE_DETAIL("asset", "LoadSoundBuffer", path);
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        const AssetPack* pack = FindPack(key);
+        if (pack != nullptr ? !pack->LoadSoundBuffer(key, *buffer) : !buffer->loadFromFile(path))
+        {
+            std::cout << "Failed to load sound from " << path << std::endl;
+            m_soundBuffers.erase(key);
+            return nullptr;
+        }
+        entry = buffer;
+        return buffer;
+    }
+
+    std::shared_ptr<sf::Font> AssetCache::GetFont(const std::string& path)
+    {
+        const std::string key = AssetPack::NormalizePath(path);
+        auto& entry = m_fonts[key];
+        if (auto font = entry.lock())
+        {
+            return font;
+        }
+
+        GUICPP_TRACE_SCOPE_DETAIL("asset", "LoadFont", path);
+        auto font = std::make_shared<sf::Font>();
+        const AssetPack* pack = FindPack(key);
+        if (pack != nullptr ? !pack->LoadFont(key, *font) : !font->loadFromFile(path))
+        {
+            std::cout << "Failed to load font from " << path << std::endl;
+            m_fonts.erase(key);
+            return nullptr;
+        }
+        entry = font;
+        return font;
+    }
+
+    size_t AssetCache::GetTextureBytes() const
+    {
+        size_t bytes = 0;
+        for (const auto& [path, entry] : m_textures)
+        {
+            if (const auto texture = entry.lock())
+            {
+                bytes += GetTextureBytes(texture.get());
+            }
+        }
+        return bytes;
+    }
+
+    size_t AssetCache::GetSoundBufferBytes() const
+    {
+        size_t bytes = 0;
+        for (const auto& [path, entry] : m_soundBuffers)
+        {
+            if (const auto buffer = entry.lock())
+            {
+                bytes += GetSoundBufferBytes(buffer.get());
+            }
+        }
+        return bytes;
+    }
+
+    std::shared_ptr<const sf::Texture> AssetCache::AddTexture(const std::string& path, const sf::Uint8* pixels, sf::Vector2u size)
+    {
+        auto& entry = m_textures[AssetPack::NormalizePath(path)];
+        if (auto texture = entry.lock())
+        {
+            return texture;
+        }
+
+        auto texture = std::make_shared<sf::Texture>();
+        if (!texture->create(size.x, size.y))
+        {
+            std::cout << "Failed to create texture for " << path << std::endl;
+            m_textures.erase(AssetPack::NormalizePath(path));
+            return nullptr;
+        }
+        texture->update(pixels);
+        entry = texture;
+        return texture;
+    }
+
+    std::shared_ptr<sf::SoundBuffer> AssetCache::AddSoundBuffer(const std::string& path, const sf::Int16* samples, sf::Uint64 sampleCount,
+                                                                unsigned channelCount, unsigned sampleRate)
+    {
+        auto& entry = m_soundBuffers[AssetPack::NormalizePath(path)];
+        if (auto buffer = entry.lock())
+        {
+            return buffer;
+        }
+
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        if (!buffer->loadFromSamples(samples, sampleCount, channelCount, sampleRate))
+        {
+            std::cout << "Failed to load sound from " << path << std::endl;
+            m_soundBuffers.erase(AssetPack::NormalizePath(path));
+            return nullptr;
+        }
+        entry = buffer;
+        return buffer;
+    }
+
+    std::shared_ptr<sf::Font> AssetCache::AddFont(const std::string& path, std::shared_ptr<sf::Font> font)
+    {
+        auto& entry = m_fonts[AssetPack::NormalizePath(path)];
+        if (auto cached = entry.lock())
+        {
+            return cached;
+        }
+        entry = font;
+        return font;
+    }
+
+    const AssetPack* AssetCache::FindPack(const std::string& path) const
+    {
+        for (auto pack = m_packs.rbegin(); pack != m_packs.rend(); ++pack)
+        {
+            if ((*pack)->Find(path) != nullptr)
+                return pack->get();
+        }
+        return nullptr;
+    }
+
+    size_t AssetCache::GetTextureBytes(const sf::Texture* texture)
+    {
+        if (texture == nullptr)
+            return 0;
+        const sf::Vector2u size = texture->getSize();
+        return static_cast<size_t>(size.x) * size.y * 4;
+    }
+
+    size_t AssetCache::GetTextureShare(const std::shared_ptr<const sf::Texture>& texture)
+    {
+        if (!texture)
+            return 0;
+        return GetTextureBytes(texture.get()) / static_cast<size_t>(texture.use_count());
+    }
+
+    size_t AssetCache::GetSoundBufferBytes(const sf::SoundBuffer* buffer)
+    {
+        if (buffer == nullptr)
+            return 0;
+        return static_cast<size_t>(buffer->getSampleCount()) * sizeof(sf::Int16);
+    }
+
+}
@@ -0,0 +1,211 @@
+#include "AssetPack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GUICPP
+{
+
+    std::shared_ptr<AssetPack> AssetPack::Open(const std::string& path)
+    {
+        std::shared_ptr<AssetPack> pack(new AssetPack());
+        if (!pack->Map(path))
+        {
+            std::cout << "Failed to map asset pack " << path << std::endl;
+            return nullptr;
+        }
+        if (!pack->ReadIndex())
+        {
+            std::cout << "Invalid asset pack " << path << std::endl;
+            return nullptr;
+        }
+        return pack;
+    }
+
+    AssetPack::~AssetPack()
+    {
+#ifdef _WIN32
+        if (m_data != nullptr)
+            UnmapViewOfFile(m_data);
+        if (m_mapping != nullptr)
+            CloseHandle(m_mapping);
+        if (m_file != nullptr && m_file != INVALID_HANDLE_VALUE)
+            CloseHandle(m_file);
+#else
+        if (m_data != nullptr)
+            munmap(const_cast<std::byte*>(m_data), m_size);
+        if (m_file != -1)
+            close(m_file);
+#endif
+    }
+
+    const AssetPackEntry* AssetPack::Find(std::string_view path) const
+    {
+        const auto entry = m_index.find(path);
+        return entry != m_index.end() ? entry->second : nullptr;
+    }
+
+    const std::byte* AssetPack::GetData(const AssetPackEntry& entry) const
+    {
+        return m_data + entry.dataOffset;
+    }
+
+    bool AssetPack::LoadTexture(const std::string& path, sf::Texture& texture) const
+    {
+        const AssetPackEntry* entry = Find(NormalizePath(path));
+        if (entry == nullptr)
+            return false;
+
+        switch (entry->payload)
+        {
+        case AssetPackPayload::Rgba:
+            if (!texture.create(entry->width, entry->height))
+                return false;
+            texture.update(reinterpret_cast<const sf::Uint8*>(GetData(*entry)));
+            return true;
+        case AssetPackPayload::Encoded:
+            return texture.loadFromMemory(GetData(*entry), entry->dataSize);
+        default:
+            return false;
+        }
+    }
+
+    bool AssetPack::LoadFont(const std::string& path, sf::Font& font) const
+    {
+        const AssetPackEntry* entry = Find(NormalizePath(path));
+        if (entry == nullptr || entry->payload != AssetPackPayload::Encoded)
+            return false;
+        return font.loadFromMemory(GetData(*entry), entry->dataSize);
+    }
+
+    bool AssetPack::LoadSoundBuffer(const std::string& path, sf::SoundBuffer& buffer) const
+    {
+        const AssetPackEntry* entry = Find(NormalizePath(path));
+        if (entry == nullptr)
+            return false;
+
+        switch (entry->payload)
+        {
+        case AssetPackPayload::Pcm:
+            return buffer.loadFromSamples(reinterpret_cast<const sf::Int16*>(GetData(*entry)),
+                                          entry->dataSize / sizeof(sf::Int16), entry->width, entry->height);
+        case AssetPackPayload::Encoded:
+            return buffer.loadFromMemory(GetData(*entry), entry->dataSize);
+        default:
+            return false;
+        }
+    }
+
+    size_t AssetPack::GetEntryCount() const
+    {
+        return m_index.size();
+    }
+
+    size_t AssetPack::GetMappedBytes() const
+    {
+        return m_size;
+    }
+
+    std::string AssetPack::NormalizePath(std::string_view path)
+    {
+        std::string normalized(path);
+        std::ranges::replace(normalized, '\\', '/');
+        while (normalized.starts_with("./"))
+        {
+            normalized.erase(0, 2);
+        }
+        return normalized;
+    }
+
+    bool AssetPack::Map(const std::string& path)
+    {
+#ifdef _WIN32
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+            return false;
+        m_size = static_cast<size_t>(size.QuadPart);
+
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping == nullptr)
+            return false;
+
+        m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        return m_data != nullptr;
+#else
+        m_file = open(path.c_str(), O_RDONLY);
+        if (m_file == -1)
+            return false;
+
+        struct stat status {};
+        if (fstat(m_file, &status) != 0 || status.st_size == 0)
+            return false;
+        m_size = static_cast<size_t>(status.st_size);
+
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+        if (data == MAP_FAILED)
+            return false;
+        m_data = static_cast<const std::byte*>(data);
+        return true;
+#endif
+    }
+
+    bool AssetPack::ReadIndex()
+    {
+        if (m_size < sizeof(AssetPackHeader))
+            return false;
+
+        AssetPackHeader header;
+        std::memcpy(&header, m_data, sizeof(header));
+        if (std::memcmp(header.magic, "GCPK", 4) != 0 || header.version != Version)
+            return false;
+
+        const uint64_t entriesEnd = sizeof(AssetPackHeader) + static_cast<uint64_t>(header.entryCount) * sizeof(AssetPackEntry);
+        const uint64_t pathTableEnd = entriesEnd + header.pathTableSize;
+        if (pathTableEnd > m_size)
+            return false;
+
+        // the mapping is page aligned and the entries follow a 16 byte header, so they can be read in place
+        const auto* entries = reinterpret_cast<const AssetPackEntry*>(m_data + sizeof(AssetPackHeader));
+        const auto* pathTable = reinterpret_cast<const char*>(m_data + entriesEnd);
+
+        m_index.reserve(header.entryCount);
+        for (uint32_t i = 0; i < header.entryCount; ++i)
+        {
+            const AssetPackEntry& entry = entries[i];
+            if (static_cast<uint64_t>(entry.pathOffset) + entry.pathLength > header.pathTableSize
+                || entry.dataOffset % Alignment != 0
+                || entry.dataOffset > m_size || entry.dataSize > m_size - entry.dataOffset)
+                return false;
+            if (entry.payload == AssetPackPayload::Rgba
+                && static_cast<uint64_t>(entry.width) * entry.height * 4 != entry.dataSize)
+                return false;
+            if (entry.payload == AssetPackPayload::Pcm && (entry.width == 0 || entry.height == 0))
+                return false;
+
+            m_index.emplace(std::string_view(pathTable + entry.pathOffset, entry.pathLength), &entry);
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,253 @@
+#include "AssetPreloader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+
+#include "AssetCache.h"
+#include "Tracer.h"
+
+namespace GUICPP
+{
+
+    AssetPreloader::AssetPreloader(size_t threadCount) : m_threadCount(threadCount), m_nextJob(0), m_decodedCount(0),
+                                                         m_isStarted(false), m_loadedCount(0), m_failedCount(0)
+    {
+        if (m_threadCount == 0)
+        {
+            m_threadCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+            m_threadCount = std::max<size_t>(1, m_threadCount);
+        }
+    }
+
+    AssetPreloader::~AssetPreloader()
+    {
+        for (auto& worker : m_workers)
+        {
+            worker.request_stop();
+        }
+        m_workers.clear();
+    }
+
+    void AssetPreloader::AddTexture(const std::string& path)
+    {
+        AddJob(AssetKind::Texture, path);
+    }
+
+    void AssetPreloader::AddSoundBuffer(const std::string& path)
+    {
+        AddJob(AssetKind::SoundBuffer, path);
+    }
+
+    void AssetPreloader::AddFont(const std::string& path)
+    {
+        AddJob(AssetKind::Font, path);
+    }
+
+    void AssetPreloader::AddJob(AssetKind kind, const std::string& path)
+    {
+        if (m_isStarted)
+            return;
+        Job& job = m_jobs.emplace_back();
+        job.kind = kind;
+        job.path = path;
+    }
+
+    void AssetPreloader::Add(const std::vector<std::string>& paths)
+    {
+        for (const auto& path : paths)
+        {
+            std::string extension = std::filesystem::path(path).extension().string();
+            std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+            if (extension == ".ogg" || extension == ".wav" || extension == ".flac")
+                AddSoundBuffer(path);
+            else if (extension == ".ttf" || extension == ".otf")
+                AddFont(path);
+            else
+                AddTexture(path);
+        }
+    }
+
+    void AssetPreloader::SetProgressCallback(std::function<void(const PreloadProgress&)> callback)
+    {
+        m_progressCallback = std::move(callback);
+    }
+
+    void AssetPreloader::Start()
+    {
+        if (m_isStarted)
+            return;
+        m_isStarted = true;
+
+        // resolve the packs on the render thread, the workers only read the mappings
+        const AssetCache& cache = AssetCache::GetInstance();
+        for (auto& job : m_jobs)
+        {
+            job.pack = cache.FindPack(AssetPack::NormalizePath(job.path));
+        }
+
+        const size_t workerCount = std::min(m_threadCount, m_jobs.size());
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            m_workers.emplace_back([this](const std::stop_token& stopToken) { Work(stopToken); });
+        }
+    }
+
+    bool AssetPreloader::Update(size_t maxUploads)
+    {
+        if (!m_isStarted)
+            return false;
+
+        std::vector<size_t> ready;
+        {
+            std::lock_guard lock(m_readyMutex);
+            const size_t count = std::min(maxUploads, m_ready.size());
+            ready.assign(m_ready.begin(), m_ready.begin() + static_cast<std::ptrdiff_t>(count));
+            m_ready.erase(m_ready.begin(), m_ready.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+
+        for (const size_t index : ready)
+        {
+            Job& job = m_jobs[index];
+            if (job.failed || !Upload(job))
+            {
+                std::cout << "Failed to preload " << job.path << std::endl;
+                ++m_failedCount;
+            }
+            ++m_loadedCount;
+
+            // release the decoded copy, the asset now lives in the cache
+            job.image = sf::Image();
+            job.samples = {};
+            job.font.reset();
+        }
+
+        if (!ready.empty() && m_progressCallback)
+        {
+            m_progressCallback(GetProgress());
+        }
+        return IsDone();
+    }
+
+    void AssetPreloader::Wait()
+    {
+        Start();
+        while (!Update())
+        {
+            std::unique_lock lock(m_readyMutex);
+            m_readyCondition.wait(lock, [this] { return !m_ready.empty(); });
+        }
+    }
+
+    bool AssetPreloader::IsDone() const
+    {
+        return m_isStarted && m_loadedCount == m_jobs.size();
+    }
+
+    PreloadProgress AssetPreloader::GetProgress() const
+    {
+        return { m_jobs.size(), m_decodedCount.load(), m_loadedCount, m_failedCount };
+    }
+
+    void AssetPreloader::Work(const std::stop_token& stopToken)
+    {
+        Tracer::GetInstance().NameThread("AssetPreloader");
+        while (!stopToken.stop_requested())
+        {
+            const size_t index = m_nextJob.fetch_add(1);
+            if (index >= m_jobs.size())
+                return;
+
+            Job& job = m_jobs[index];
+            job.failed = !Decode(job);
+            ++m_decodedCount;
+            {
+                std::lock_guard lock(m_readyMutex);
+                m_ready.push_back(index);
+            }
+            m_readyCondition.notify_one();
+        }
+    }
+
+    bool AssetPreloader::Decode(Job& job)
+    {
+        GUICPP_TRACE_SCOPE_DETAIL("asset", "Decode", job.path);
+        const AssetPackEntry* entry = job.pack != nullptr ? job.pack->Find(AssetPack::NormalizePath(job.path)) : nullptr;
+
+        switch (job.kind)
+        {
+        case AssetKind::Texture:
+            if (entry == nullptr)
+                return job.image.loadFromFile(job.path);
+            // pre-decoded pixels are uploaded straight from the mapping
+            return entry->payload == AssetPackPayload::Rgba
+                || job.image.loadFromMemory(job.pack->GetData(*entry), entry->dataSize);
+
+        case AssetKind::SoundBuffer:
+        {
+            if (entry != nullptr && entry->payload == AssetPackPayload::Pcm)
+                return true;
+
+            sf::InputSoundFile file;
+            if (entry != nullptr ? !file.openFromMemory(job.pack->GetData(*entry), entry->dataSize) : !file.openFromFile(job.path))
+                return false;
+            job.samples.resize(static_cast<size_t>(file.getSampleCount()));
+            job.samples.resize(static_cast<size_t>(file.read(job.samples.data(), job.samples.size())));
+            job.channelCount = file.getChannelCount();
+            job.sampleRate = file.getSampleRate();
+            return true;
+        }
+
+        case AssetKind::Font:
+            job.font = std::make_shared<sf::Font>();
+            return entry != nullptr ? job.pack->LoadFont(job.path, *job.font) : job.font->loadFromFile(job.path);
+        }
+        return false;
+    }
+
+    bool AssetPreloader::Upload(Job& job)
+    {
+        GUICPP_TRACE_SCOPE_DETAIL("asset", "Upload", job.path);
+        AssetCache& cache = AssetCache::GetInstance();
+        const AssetPackEntry* entry = job.pack != nullptr ? job.pack->Find(AssetPack::NormalizePath(job.path)) : nullptr;
+
+        switch (job.kind)
+        {
+        case AssetKind::Texture:
+        {
+            std::shared_ptr<const sf::Texture> texture;
+            if (entry != nullptr && entry->payload == AssetPackPayload::Rgba)
+                texture = cache.AddTexture(job.path, reinterpret_cast<const sf::Uint8*>(job.pack->GetData(*entry)),
+                                           { entry->width, entry->height });
+            else
+                texture = cache.AddTexture(job.path, job.image.getPixelsPtr(), job.image.getSize());
+            if (!texture)
+                return false;
+            m_textures.push_back(std::move(texture));
+            return true;
+        }
+
+        case AssetKind::SoundBuffer:
+        {
+            std::shared_ptr<sf::SoundBuffer> buffer;
+            if (entry != nullptr && entry->payload == AssetPackPayload::Pcm)
+                buffer = cache.AddSoundBuffer(job.path, reinterpret_cast<const sf::Int16*>(job.pack->GetData(*entry)),
+                                              entry->dataSize / sizeof(sf::Int16), entry->width, entry->height);
+            else
+                buffer = cache.AddSoundBuffer(job.path, job.samples.data(), job.samples.size(), job.channelCount, job.sampleRate);
+            if (!buffer)
+                return false;
+            m_soundBuffers.push_back(std::move(buffer));
+            return true;
+        }
+
+        case AssetKind::Font:
+            m_fonts.push_back(cache.AddFont(job.path, job.font));
+            return true;
+        }
+        return false;
+    }
+
+}
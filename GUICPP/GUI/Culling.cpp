@@ -0,0 +1,38 @@
+#include "Culling.h"
+
+#include <algorithm>
+
+namespace GUICPP
+{
+
+    sf::FloatRect GetViewBounds(const sf::View& view)
+    {
+        // the corners of the view are at -1 and 1 once transformed
+        const sf::Transform& transform = view.getInverseTransform();
+        const sf::Vector2f corners[] = {
+            transform.transformPoint(-1.f, -1.f), transform.transformPoint(1.f, -1.f),
+            transform.transformPoint(1.f, 1.f), transform.transformPoint(-1.f, 1.f)
+        };
+
+        sf::Vector2f min = corners[0];
+        sf::Vector2f max = corners[0];
+        for (const sf::Vector2f& corner : corners)
+        {
+            min.x = std::min(min.x, corner.x);
+            min.y = std::min(min.y, corner.y);
+            max.x = std::max(max.x, corner.x);
+            max.y = std::max(max.y, corner.y);
+        }
+        return { min, max - min };
+    }
+
+    sf::FloatRect UniteBounds(const sf::FloatRect& first, const sf::FloatRect& second)
+    {
+        const float left = std::min(first.left, second.left);
+        const float top = std::min(first.top, second.top);
+        const float right = std::max(first.left + first.width, second.left + second.width);
+        const float bottom = std::max(first.top + first.height, second.top + second.height);
+        return { left, top, right - left, bottom - top };
+    }
+
+}
@@ -0,0 +1,117 @@
+#include "DrawCommandList.h"
+
+#include <algorithm>
+
+#include "TextLayout.h"
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        bool IsSameVertex(const sf::Vertex& first, const sf::Vertex& second)
+        {
+            return first.position == second.position && first.color == second.color && first.texCoords == second.texCoords;
+        }
+
+        bool IsSameStates(const sf::RenderStates& first, const sf::RenderStates& second)
+        {
+            return first.blendMode == second.blendMode && first.shader == second.shader
+                && std::equal(first.transform.getMatrix(), first.transform.getMatrix() + 16, second.transform.getMatrix());
+        }
+    }
+
+    void DrawCommandList::Clear()
+    {
+        m_vertices.clear();
+        m_commands.clear();
+        m_retained.clear();
+        ResetCounters();
+
+        // the copies of the glyph pages no longer drawn are released, the others are kept for the next frame
+        std::erase_if(m_glyphCopies, [](const std::unique_ptr<GlyphCopy>& copy) { return !copy->isUsed; });
+        for (const auto& copy : m_glyphCopies)
+        {
+            copy->isUsed = false;
+        }
+    }
+
+    void DrawCommandList::Draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states)
+    {
+        if (vertices == nullptr || count == 0)
+            return;
+        CountDraw(count, states.texture);
+        m_commands.push_back({ type, m_vertices.size(), count, states });
+        m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+    }
+
+    void DrawCommandList::Retain(std::shared_ptr<const void> object)
+    {
+        m_retained.push_back(std::move(object));
+    }
+
+    const sf::Texture* DrawCommandList::GetGlyphTexture(const sf::Texture* texture)
+    {
+        if (texture == nullptr)
+            return nullptr;
+
+        const auto copy = std::ranges::find_if(m_glyphCopies, [texture](const auto& glyphCopy) { return glyphCopy->source == texture; });
+        GlyphCopy& glyphCopy = copy != m_glyphCopies.end() ? **copy : *m_glyphCopies.emplace_back(std::make_unique<GlyphCopy>());
+        glyphCopy.source = texture;
+
+        // the list is not replayed while it is recorded, its copy can be replaced
+        const uint64_t revision = TextLayout::GetGlyphRevision();
+        if (!glyphCopy.isCopied || glyphCopy.revision != revision)
+        {
+            glyphCopy.texture = *texture;
+            glyphCopy.revision = revision;
+            glyphCopy.isCopied = true;
+        }
+        glyphCopy.isUsed = true;
+        return &glyphCopy.texture;
+    }
+
+    const sf::Texture* DrawCommandList::GetRecordedTexture(const sf::Texture* texture) const
+    {
+        const auto copy = std::ranges::find_if(m_glyphCopies, [texture](const auto& glyphCopy) { return &glyphCopy->texture == texture; });
+        return copy != m_glyphCopies.end() ? (*copy)->source : texture;
+    }
+
+    void DrawCommandList::Replay(RenderSink& sink) const
+    {
+        for (const Command& command : m_commands)
+        {
+            sink.Draw(&m_vertices[command.first], command.count, command.type, command.states);
+        }
+    }
+
+    size_t DrawCommandList::FindFirstDifference(const DrawCommandList& other) const
+    {
+        const size_t count = std::min(m_commands.size(), other.m_commands.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Command& command = m_commands[i];
+            const Command& otherCommand = other.m_commands[i];
+            if (command.type != otherCommand.type || command.count != otherCommand.count
+                || !IsSameStates(command.states, otherCommand.states)
+                || GetRecordedTexture(command.states.texture) != other.GetRecordedTexture(otherCommand.states.texture))
+                return i;
+            const auto vertices = m_vertices.begin() + static_cast<std::ptrdiff_t>(command.first);
+            const auto otherVertices = other.m_vertices.begin() + static_cast<std::ptrdiff_t>(otherCommand.first);
+            if (!std::equal(vertices, vertices + static_cast<std::ptrdiff_t>(command.count), otherVertices, IsSameVertex))
+                return i;
+        }
+        return m_commands.size() == other.m_commands.size() ? NoDifference : count;
+    }
+
+    const std::vector<DrawCommandList::Command>& DrawCommandList::GetCommands() const
+    {
+        return m_commands;
+    }
+
+    const std::vector<sf::Vertex>& DrawCommandList::GetVertices() const
+    {
+        return m_vertices;
+    }
+
+}
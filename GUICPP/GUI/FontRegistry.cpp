@@ -0,0 +1,85 @@
+#include "FontRegistry.h"
+
+#include <filesystem>
+#include <iostream>
+
+#include "AssetCache.h"
+#include "TextLayout.h"
+
+namespace GUICPP
+{
+
+    FontRegistry& FontRegistry::GetInstance()
+    {
+        static FontRegistry instance;
+        return instance;
+    }
+
+    FontRegistry::FontRegistry()
+    {
+        RegisterFamily(DefaultFamily, {
+            "C:/Windows/Fonts/arial.ttf",
+            "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
+            "/usr/share/fonts/liberation-sans/LiberationSans-Regular.ttf",
+            "/usr/share/fonts/TTF/LiberationSans-Regular.ttf",
+            "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+            "/usr/share/fonts/dejavu/DejaVuSans.ttf",
+            "/usr/share/fonts/TTF/DejaVuSans.ttf",
+            "/System/Library/Fonts/Supplemental/Arial.ttf",
+            "/Library/Fonts/Arial.ttf"
+        });
+    }
+
+    void FontRegistry::RegisterFamily(const std::string& family, std::vector<std::string> paths)
+    {
+        m_families[family] = std::move(paths);
+    }
+
+    std::shared_ptr<sf::Font> FontRegistry::GetFont(const std::string& familyOrPath)
+    {
+        AssetCache& cache = AssetCache::GetInstance();
+
+        const auto family = m_families.find(familyOrPath);
+        if (family == m_families.end())
+        {
+            return cache.GetFont(familyOrPath);
+        }
+
+        // skip the candidates of other platforms silently, only packed or existing files are loaded
+        for (const auto& path : family->second)
+        {
+            if (cache.FindPack(AssetPack::NormalizePath(path)) == nullptr && !std::filesystem::exists(path))
+                continue;
+            if (auto font = cache.GetFont(path))
+                return font;
+        }
+        std::cout << "No font found for family " << familyOrPath << std::endl;
+        return nullptr;
+    }
+
+    void FontRegistry::Prewarm(const sf::Font& font, const sf::String& characters, const std::vector<unsigned int>& sizes, bool bold)
+    {
+        for (const unsigned int size : sizes)
+        {
+            for (const sf::Uint32 character : characters)
+            {
+                font.getGlyph(character, size, bold);
+            }
+        }
+        TextLayout::ReviseGlyphs();
+    }
+
+    const sf::String& FontRegistry::GetBasicLatin()
+    {
+        static const sf::String basicLatin = [] {
+            sf::String characters;
+            for (sf::Uint32 character = U' '; character <= U'~'; ++character)
+            {
+                characters += character;
+            }
+            return characters;
+        }();
+        return basicLatin;
+    }
+
+}
@@ -1,27 +1,128 @@
 #include "GUI.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <tuple>
+
+#include "AssetCache.h"
+#include "Culling.h"
+#include "FontRegistry.h"
 #include "Widget.h"
 #include "Widgets/button.h"
 
 namespace GUICPP
 {
+
+    namespace
+    {
+        // the canvas holds premultiplied colours, blended once more over the window
+        const sf::BlendMode CanvasBlendMode(sf::BlendMode::SrcAlpha, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add,
+                                            sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add);
+        const sf::BlendMode PremultipliedBlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+        // far from any widget, once the mouse left the window
+        const sf::Vector2i OutsidePointer(std::numeric_limits<int>::min() / 2, std::numeric_limits<int>::min() / 2);
+
+        bool IsSameView(const sf::View& first, const sf::View& second)
+        {
+            return first.getCenter() == second.getCenter() && first.getSize() == second.getSize()
+                && first.getRotation() == second.getRotation() && first.getViewport() == second.getViewport();
+        }
+
+        sf::IntRect UniteAreas(const sf::IntRect& first, const sf::IntRect& second)
+        {
+            const int left = std::min(first.left, second.left);
+            const int top = std::min(first.top, second.top);
+            const int right = std::max(first.left + first.width, second.left + second.width);
+            const int bottom = std::max(first.top + first.height, second.top + second.height);
+            return { left, top, right - left, bottom - top };
+        }
+    }
     
     GUI::GUI(sf::RenderWindow& window) : m_window(window), m_defaultSize(30), m_isLockBy(nullptr), m_isShowingHandCursor(false)
     {
-        m_defaultFont = std::make_shared<sf::Font>();
-        if (!m_defaultFont->loadFromFile("C:/Windows/Fonts/arial.ttf"))
+        m_defaultFont = FontRegistry::GetInstance().GetFont(FontRegistry::DefaultFamily);
+        if (!m_defaultFont)
         {
             throw std::runtime_error("Error loading default font");
         }
+        // rasterize the common glyphs now rather than on the first frames, at the default size and the pressed button size
+        FontRegistry::Prewarm(*m_defaultFont, FontRegistry::GetBasicLatin(), { m_defaultSize, m_defaultSize + 1 });
         m_arrowCursor.loadFromSystem(sf::Cursor::Arrow);
         m_handCursor.loadFromSystem(sf::Cursor::Hand);
+
+        m_frameDurationMetric = &m_metrics.AddHistogram("guicpp_frame_duration_seconds", "Time to draw or record a frame of the GUI.", 1e-6);
+        m_eventsMetric = &m_metrics.AddCounter("guicpp_events_total", "Events handled by the GUI.");
+        m_eventRateMetric = &m_metrics.AddGauge("guicpp_events_per_second", "Events handled by the GUI per second, over the last second with a frame.");
+        m_widgetsMetric = &m_metrics.AddGauge("guicpp_widgets", "Widgets held by the GUI and its groups.");
+        m_textureBytesMetric = &m_metrics.AddGauge("guicpp_texture_bytes", "Memory of the textures of the asset cache.");
+        m_soundBytesMetric = &m_metrics.AddGauge("guicpp_sound_buffer_bytes", "Memory of the sound buffers of the asset cache.");
+        m_voicesMetric = &m_metrics.AddGauge("guicpp_voices", "Voices of the sound pool.");
+        m_activeVoicesMetric = &m_metrics.AddGauge("guicpp_voices_active", "Voices of the sound pool playing.");
+        m_droppedSoundsMetric = &m_metrics.AddCounter("guicpp_sounds_dropped_total", "Sounds not played because every voice was busy.");
+    }
+
+    GUI::~GUI()
+    {
+        // the caller may keep the widgets and groups, which must not point into the destroyed GUI
+        for (const auto& widget : m_widgetList) {
+            DetachWidget(*widget);
+        }
+        for (const auto& group : m_groupList) {
+            if (group->m_drawOrderFlag == &m_isDrawListDirty) {
+                group->m_drawOrderFlag = nullptr;
+            }
+            DetachGroupWidgets(*group);
+        }
     }
 
     void GUI::HandleEvents(const sf::Event& e) {
-        m_isShowingHandCursor = false;
-        const bool tmp = HandleEventsFromWidgetList(e) || HandleEventsFromGroupList(e);
-        if (!m_isShowingHandCursor) {
-            m_isShowingHandCursor = tmp;
+        // the window may have lost its content
+        if (e.type == sf::Event::Resized || e.type == sf::Event::GainedFocus) {
+            RequestRedraw();
+        }
+
+        GUICPP_PROFILE_GUI(HandleEvents);
+        GUICPP_PROFILE_EVENT();
+        GUICPP_TRACE_SCOPE("event", "HandleEvents");
+        m_eventsMetric->Add();
+        UpdatePointer(e);
+        if (m_inputRecorder != nullptr) {
+            m_inputRecorder->Record(e, m_pointer);
+        }
+
+        bool isHandled = false;
+        if (m_window.isOpen()) {
+            UpdateDrawList();
+            // a widget scrolled out of the view while it holds the events still gets them, to release them
+            if (m_isLockBy != nullptr && std::ranges::find(m_drawList, m_isLockBy, &DrawEntry::widget) == m_drawList.end()) {
+                isHandled = Dispatch(*m_isLockBy, e);
+                m_isLockBy->m_isDirty = true;
+                if (!isHandled) {
+                    m_isLockBy = nullptr;
+                }
+            }
+            // from the top, the widget handling the event hides it from the widgets below
+            for (auto entry = m_drawList.rbegin(); entry != m_drawList.rend() && !isHandled; ++entry) {
+                const auto& widget = entry->widget;
+                if (m_isLockBy != nullptr && m_isLockBy != widget)
+                    continue;
+
+                isHandled = Dispatch(*widget, e);
+                // hovering, pressing and leaving change how the widget looks, the widgets moving or
+                // changing texture invalidate themselves, which sorts the draw list again
+                if (isHandled || m_isLockBy == widget) {
+                    widget->m_isDirty = true;
+                }
+                if (isHandled && m_isLockBy == nullptr) {
+                    m_isLockBy = widget;
+                } else if (!isHandled && m_isLockBy == widget) {
+                    m_isLockBy = nullptr;
+                }
+            }
         }
+        m_isShowingHandCursor = isHandled;
 
         if (m_isShowingHandCursor) {
             m_window.setMouseCursor(m_handCursor);
@@ -30,45 +131,282 @@ namespace GUICPP
         }
     }
 
+    void GUI::SetInputRecorder(InputRecorder* recorder)
+    {
+        m_inputRecorder = recorder;
+    }
+
+    void GUI::SetPointerPosition(const sf::Vector2i& pixel)
+    {
+        m_pointer = pixel;
+        m_hasPointer = true;
+    }
+
+    sf::Vector2i GUI::GetPointerPosition() const
+    {
+        return m_pointer;
+    }
+
+    void GUI::UpdatePointer(const sf::Event& e)
+    {
+        // the widgets hit test the position carried by the events, not the live mouse
+        if (!m_hasPointer) {
+            m_pointer = sf::Mouse::getPosition(m_window);
+            m_hasPointer = true;
+        }
+        switch (e.type) {
+        case sf::Event::MouseMoved:
+            m_pointer = { e.mouseMove.x, e.mouseMove.y };
+            break;
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            m_pointer = { e.mouseButton.x, e.mouseButton.y };
+            break;
+        case sf::Event::MouseWheelScrolled:
+            m_pointer = { e.mouseWheelScroll.x, e.mouseWheelScroll.y };
+            break;
+        case sf::Event::MouseLeft:
+            m_pointer = OutsidePointer;
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool GUI::Dispatch(Widget& widget, const sf::Event& e) const
+    {
+        GUICPP_PROFILE_VISIT();
+        GUICPP_PROFILE_WIDGET(&widget, HandleEvents);
+        GUICPP_TRACE_SCOPE("event", widget.GetTypeName());
+        return widget.HandleEvents(e);
+    }
+
     void GUI::Draw(sf::RenderStates& states) const
     {
-        DrawFromWidgetList(states);
-        DrawFromGroupList(states);
+        const sf::Time frameStart = m_clock.getElapsedTime();
+        {
+            GUICPP_PROFILE_GUI(Draw);
+            GUICPP_TRACE_SCOPE("draw", "Draw");
+            UpdateDrawList();
+            m_windowSink.ResetCounters();
+            m_canvasSink.ResetCounters();
+            if (m_isPartialRedraw) {
+                DrawPartially(states);
+            } else {
+                DrawWidgets(m_windowSink, states, nullptr);
+            }
+            FinishFrame();
+        }
+        UpdateMetrics(m_clock.getElapsedTime() - frameStart);
+        GUICPP_PROFILE_END_FRAME(m_windowSink.GetDrawCallCount() + m_canvasSink.GetDrawCallCount(),
+                                 m_windowSink.GetTextureSwitchCount() + m_canvasSink.GetTextureSwitchCount());
+        GUICPP_ALLOCATIONS_END_FRAME();
+    }
+
+    void GUI::Record(RenderSink& sink, sf::RenderStates& states) const
+    {
+        [[maybe_unused]] const size_t drawCalls = sink.GetDrawCallCount();
+        [[maybe_unused]] const size_t textureSwitches = sink.GetTextureSwitchCount();
+        const sf::Time frameStart = m_clock.getElapsedTime();
+        {
+            GUICPP_PROFILE_GUI(Draw);
+            GUICPP_TRACE_SCOPE("draw", "Record");
+            UpdateDrawList();
+            for (const DrawEntry& entry : m_drawList) {
+                const auto& widget = entry.widget;
+                if (m_textBatch.Overlaps(widget->GetGlobalBounds())) {
+                    m_textBatch.Flush(sink, states);
+                }
+                sink.Retain(widget);
+                widget->SetRenderSink(&sink);
+                {
+                    GUICPP_PROFILE_WIDGET(widget.get(), Draw);
+                    GUICPP_TRACE_SCOPE("draw", widget->GetTypeName());
+                    widget->Draw(states);
+                }
+                widget->SetRenderSink(&m_windowSink);
+                // the textures are owned by the style the widget drew with, which the widget may replace
+                // while the next frame is recorded, when it loads or releases its resources or is edited
+                if (widget->m_style) {
+                    sink.Retain(widget->GetSharedStyle());
+                }
+            }
+            m_textBatch.Flush(sink, states);
+            FinishFrame();
+        }
+        UpdateMetrics(m_clock.getElapsedTime() - frameStart);
+        GUICPP_PROFILE_END_FRAME(sink.GetDrawCallCount() - drawCalls, sink.GetTextureSwitchCount() - textureSwitches);
+        GUICPP_ALLOCATIONS_END_FRAME();
+    }
+
+    MetricsRegistry& GUI::GetMetrics()
+    {
+        return m_metrics;
+    }
+
+    void GUI::UpdateMetrics(sf::Time frameDuration) const
+    {
+        m_frameDurationMetric->Record(static_cast<uint64_t>(std::max<sf::Int64>(0, frameDuration.asMicroseconds())));
+
+        // the values walked or shared with other threads are sampled once per second
+        const sf::Time now = m_clock.getElapsedTime();
+        const sf::Time elapsed = now - m_metricsTime;
+        if (elapsed < sf::seconds(1.f))
+            return;
+        const uint64_t eventCount = m_eventsMetric->Get();
+        m_eventRateMetric->Set(static_cast<double>(eventCount - m_metricsEventCount) / elapsed.asSeconds());
+        m_metricsTime = now;
+        m_metricsEventCount = eventCount;
+
+        size_t widgetCount = m_widgetList.size();
+        for (const auto& group : m_groupList) {
+            widgetCount += CountGroupWidgets(*group);
+        }
+        m_widgetsMetric->Set(static_cast<double>(widgetCount));
+
+        const AssetCache& cache = AssetCache::GetInstance();
+        m_textureBytesMetric->Set(static_cast<double>(cache.GetTextureBytes()));
+        m_soundBytesMetric->Set(static_cast<double>(cache.GetSoundBufferBytes()));
+        const SoundPool& pool = SoundPool::GetInstance();
+        m_voicesMetric->Set(static_cast<double>(pool.GetVoiceCount()));
+        m_activeVoicesMetric->Set(static_cast<double>(pool.GetActiveVoiceCount()));
+        m_droppedSoundsMetric->Set(pool.GetDroppedCount());
+    }
+
+    size_t GUI::CountGroupWidgets(const Group& group)
+    {
+        size_t count = group.m_widgetList.size();
+        for (const auto& child : group.m_child) {
+            count += CountGroupWidgets(*child);
+        }
+        return count;
+    }
+
+    void GUI::FinishFrame() const
+    {
+        m_textureResidency.Update(m_groupList);
+
+        // what is shown now, compared by the next NeedsRedraw
+        m_drawnView = m_window.getView();
+        m_drawnSize = m_window.getSize();
+        m_drawnWidgets.clear();
+        for (const DrawEntry& entry : m_drawList) {
+            Widget& widget = *entry.widget;
+            widget.m_isDirty = false;
+            widget.m_isDrawn = true;
+            widget.m_drawnBounds = widget.GetGlobalBounds();
+            widget.m_drawnIndex = m_drawnWidgets.size();
+            m_drawnWidgets.push_back(&widget);
+        }
+        m_hasDrawn = true;
+        if (m_isRedrawScheduled && m_clock.getElapsedTime() >= m_redrawTime) {
+            m_isRedrawScheduled = false;
+        }
+    }
+
+    void GUI::ReserveWidgets(size_t count)
+    {
+        m_widgetList.reserve(count);
+        m_drawList.reserve(count);
+        m_drawnWidgets.reserve(count);
+        m_hitTestWidgets.reserve(count);
+        m_hitTestBatch.Reserve(count);
     }
 
     void GUI::AddWidgetToGui(const std::shared_ptr<Widget>& widget) {
         widget->SetWindow(&m_window);
+        widget->SetRenderSink(&m_windowSink);
+        widget->SetTextBatch(&m_textBatch);
+        widget->SetPointer(&m_pointer);
+        widget->BindResources();
 
-        // if widget is a button, set the default font
+        // if widget is a button without a styled font, set the default font
         const auto button = dynamic_cast<Button*>(widget.get());
-        if (button != nullptr) {
-            button->SetFont(*m_defaultFont);
+        if (button != nullptr && button->GetStyle().GetFont() == nullptr) {
+            button->SetFont(m_defaultFont);
+            button->SetSdfFont(m_sdfFont);
         }
     
+        widget->m_drawOrderFlag = &m_isDrawListDirty;
         m_widgetList.push_back(widget);
+        m_isDrawListDirty = true;
     }
 
     void GUI::RemoveWidgetFromGui(const std::shared_ptr<Widget>& widget) {
+        DetachWidget(*widget);
         std::erase(m_widgetList, widget);
+        m_isDrawListDirty = true;
     }
 
     void GUI::AddGroupToGui(const std::shared_ptr<Group>& group)
     {
         m_groupList.push_back(group);
+        group->m_drawOrderFlag = &m_isDrawListDirty;
+        m_isDrawListDirty = true;
 
-        for (auto& widget : group->GetWidgetList()) {
+        // hidden groups load their resources when they are first shown
+        if (group->GetGroupVisibility()) {
+            group->BindResources();
+        }
+
+        AttachGroupWidgets(*group);
+    }
+
+    void GUI::AttachGroupWidgets(const Group& group)
+    {
+        for (auto& widget : group.GetWidgetList()) {
             widget->SetWindow(&m_window);
-            // if widget is a button, set the default font
+            widget->SetRenderSink(&m_windowSink);
+            widget->SetTextBatch(&m_textBatch);
+            widget->SetPointer(&m_pointer);
+            // if widget is a button without a styled font, set the default font
             const auto button = dynamic_cast<Button*>(widget.get());
-            if (button != nullptr) {
-                button->SetFont(*m_defaultFont);
+            if (button != nullptr && button->GetStyle().GetFont() == nullptr) {
+                button->SetFont(m_defaultFont);
+                button->SetSdfFont(m_sdfFont);
             }
         }
+        // the widgets of the child groups are handled and drawn with the group
+        for (const auto& child : group.m_child) {
+            AttachGroupWidgets(*child);
+        }
+    }
+
+    void GUI::DetachWidget(Widget& widget) const
+    {
+        // only clear what still points into this GUI, the widget may have been attached to another since
+        if (widget.m_sink == &m_windowSink || widget.m_sink == &m_canvasSink) {
+            widget.SetRenderSink(nullptr);
+        }
+        if (widget.m_textBatch == &m_textBatch) {
+            widget.m_textBatch = nullptr;
+        }
+        if (widget.m_pointer == &m_pointer) {
+            widget.m_pointer = nullptr;
+        }
+        if (widget.m_drawOrderFlag == &m_isDrawListDirty) {
+            widget.m_drawOrderFlag = nullptr;
+        }
+    }
+
+    void GUI::DetachGroupWidgets(const Group& group) const
+    {
+        for (const auto& widget : group.GetWidgetList()) {
+            DetachWidget(*widget);
+        }
+        for (const auto& child : group.m_child) {
+            DetachGroupWidgets(*child);
+        }
     }
 
     void GUI::RemoveGroupFromGui(const std::shared_ptr<Group>& group)
     {
+        if (group->m_drawOrderFlag == &m_isDrawListDirty) {
+            group->m_drawOrderFlag = nullptr;
+        }
+        DetachGroupWidgets(*group);
         std::erase(m_groupList, group);
+        m_isDrawListDirty = true;
     }
 
     sf::Font* GUI::GetFont() const
@@ -81,50 +419,514 @@ namespace GUICPP
         return m_defaultSize;
     }
 
-    bool GUI::HandleEventsFromWidgetList(const sf::Event& e) {
-        if (m_window.isOpen()) {
-            for (auto& widget : m_widgetList) {
-                bool tmp = false;
+    void GUI::ApplyTheme()
+    {
+        for (const auto& widget : m_widgetList) {
+            widget->ApplyStyle();
+        }
+        for (const auto& group : m_groupList) {
+            ApplyThemeToGroup(*group);
+        }
+    }
 
-                if (m_isLockBy == widget || m_isLockBy == nullptr) {
-                    tmp = widget->HandleEvents(e);
-                }
-                if (!m_isShowingHandCursor) {
-                    m_isShowingHandCursor = tmp;
-                    if ((tmp && m_isLockBy == nullptr)) {
-                        m_isLockBy = widget;
-                    } else if (!tmp && m_isLockBy == widget) {
-                        m_isLockBy = nullptr;
-                    }
-                }
+    TextureResidency& GUI::GetTextureResidency()
+    {
+        return m_textureResidency;
+    }
+
+    bool GUI::SetSdfText(bool isEnabled)
+    {
+        if (isEnabled) {
+            if (!m_sdfAtlas) {
+                m_sdfAtlas = std::make_shared<SdfFont>(m_defaultFont);
             }
-            return m_isShowingHandCursor;
+            if (!m_sdfAtlas->IsAvailable()) {
+                return false;
+            }
+            m_sdfFont = m_sdfAtlas;
         } else {
+            m_sdfFont = nullptr;
+        }
+
+        // the same buttons as the ones given the default font
+        for (const auto& widget : m_widgetList) {
+            const auto button = dynamic_cast<Button*>(widget.get());
+            if (button != nullptr && button->GetStyle().GetFont() == nullptr) {
+                button->SetSdfFont(m_sdfFont);
+            }
+        }
+        for (const auto& group : m_groupList) {
+            ApplySdfFontToGroup(*group);
+        }
+        return true;
+    }
+
+    void GUI::ApplySdfFontToGroup(const Group& group) const
+    {
+        for (const auto& widget : group.m_widgetList) {
+            const auto button = dynamic_cast<Button*>(widget.get());
+            if (button != nullptr && button->GetStyle().GetFont() == nullptr) {
+                button->SetSdfFont(m_sdfFont);
+            }
+        }
+        // the widgets of the child groups were given the default font with the group
+        for (const auto& child : group.m_child) {
+            ApplySdfFontToGroup(*child);
+        }
+    }
+
+    const TextBatch& GUI::GetTextBatch() const
+    {
+        return m_textBatch;
+    }
+
+    bool GUI::NeedsRedraw() const
+    {
+        if (m_isRedrawScheduled && m_clock.getElapsedTime() >= m_redrawTime)
+            return true;
+        if (!m_window.isOpen())
             return false;
+
+        // a changed draw list is drawn, there is no need to sort it to find out
+        if (m_isDrawListDirty)
+            return true;
+        return IsDrawListChanged() || std::ranges::any_of(m_drawList, [](const DrawEntry& entry) { return entry.widget->m_isDirty; });
+    }
+
+    void GUI::RequestRedraw(sf::Time delay)
+    {
+        const sf::Time time = m_clock.getElapsedTime() + delay;
+        if (!m_isRedrawScheduled || time < m_redrawTime) {
+            m_redrawTime = time;
+            m_isRedrawScheduled = true;
         }
     }
 
-    void GUI::DrawFromWidgetList(sf::RenderStates& states) const
+    bool GUI::WaitEvent(sf::Event& event) const
     {
-        for (auto& widget : m_widgetList) {
-            widget->Draw(states);
+        if (!m_window.isOpen())
+            return false;
+        if (NeedsRedraw())
+            return m_window.pollEvent(event);
+        // nothing to draw until an event comes
+        if (!m_isRedrawScheduled)
+            return m_window.waitEvent(event);
+
+        // SFML cannot wait for an event with a timeout, sleep in short steps until the redraw is due
+        while (!m_window.pollEvent(event)) {
+            const sf::Time remaining = m_redrawTime - m_clock.getElapsedTime();
+            if (remaining <= sf::Time::Zero)
+                return false;
+            sf::sleep(std::min(remaining, sf::milliseconds(1)));
         }
+        return true;
     }
 
-    bool GUI::HandleEventsFromGroupList(sf::Event e) const
+    bool GUI::SetPartialRedraw(bool isEnabled, float fullRedrawRatio)
     {
-        for (auto& group : m_groupList) {
-            if (group->HandleEvents(e)) {
+        RequestRedraw();
+        m_fullRedrawRatio = fullRedrawRatio;
+        m_isCanvasValid = false;
+        m_isPartialRedraw = false;
+        if (!isEnabled) {
+            return true;
+        }
+
+        const sf::Vector2u size = m_window.getSize();
+        if (m_canvas.getSize() != size && !m_canvas.create(size.x, size.y)) {
+            std::cout << "Error creating the texture of the partial redraw" << std::endl;
+            return false;
+        }
+        m_isPartialRedraw = true;
+        return true;
+    }
+
+    const std::vector<sf::IntRect>& GUI::GetRedrawnAreas() const
+    {
+        return m_redrawnAreas;
+    }
+
+    size_t GUI::GetLastDrawCallCount() const
+    {
+        return m_windowSink.GetDrawCallCount() + m_canvasSink.GetDrawCallCount();
+    }
+
+    const std::vector<DrawEntry>& GUI::GetDrawOrder() const
+    {
+        return m_drawList;
+    }
+
+    Widget* GUI::GetWidgetAt(sf::Vector2f point) const
+    {
+        // the widgets may have been added, removed or reordered since the last frame
+        UpdateDrawList();
+        // packed for the first query after the draw list changed, the events walk the widgets themselves
+        if (m_isHitTestBatchDirty) {
+            PackHitTestBatch();
+        }
+        const size_t index = m_hitTestBatch.FindTopmost(point);
+        return index == HitTestBatch::NoHit ? nullptr : m_hitTestWidgets[index];
+    }
+
+    MemoryReport GUI::GetMemoryReport() const
+    {
+        MemoryReport report;
+        for (const auto& widget : m_widgetList) {
+            AccountWidget(*widget, report);
+        }
+        for (const auto& group : m_groupList) {
+            AccountGroup(*group, report);
+        }
+
+        const AssetCache& cache = AssetCache::GetInstance();
+        report.sharedTableBytes = cache.GetTextureBytes() + cache.GetSoundBufferBytes();
+        return report;
+    }
+
+    void GUI::AccountWidget(const Widget& widget, MemoryReport& report)
+    {
+        const MemoryUsage usage = widget.GetMemoryUsage();
+        const std::string typeName = widget.GetTypeName();
+
+        auto entry = std::ranges::find(report.types, typeName, &MemoryReportEntry::typeName);
+        if (entry == report.types.end()) {
+            report.types.push_back({ typeName, usage.objectBytes, 0, {} });
+            entry = std::prev(report.types.end());
+        }
+        ++entry->instanceCount;
+        entry->usage += usage;
+        report.total += usage;
+    }
+
+    void GUI::AccountGroup(const Group& group, MemoryReport& report)
+    {
+        for (const auto& widget : group.m_widgetList) {
+            AccountWidget(*widget, report);
+        }
+        for (const auto& child : group.m_child) {
+            AccountGroup(*child, report);
+        }
+    }
+
+    void GUI::ApplyThemeToGroup(const Group& group)
+    {
+        for (const auto& widget : group.m_widgetList) {
+            widget->ApplyStyle();
+        }
+        for (const auto& child : group.m_child) {
+            ApplyThemeToGroup(*child);
+        }
+    }
+
+    void GUI::SetCulling(bool isEnabled)
+    {
+        m_isCulling = isEnabled;
+        m_isDrawListDirty = true;
+    }
+
+    size_t GUI::GetCulledCount() const
+    {
+        return m_culledCount;
+    }
+
+    void GUI::UpdateDrawList() const
+    {
+        if (m_isDrawListDirty || (m_isCulling && GetViewBounds(m_window.getView()) != m_viewBounds)) {
+            SortDrawList();
+        }
+    }
+
+    void GUI::SortDrawList() const
+    {
+        m_isDrawListDirty = false;
+        m_isHitTestBatchDirty = true;
+        m_drawList.clear();
+        m_culledCount = 0;
+        m_viewBounds = GetViewBounds(m_window.getView());
+        for (const auto& widget : m_widgetList) {
+            AddToDrawList(widget, 0);
+        }
+        for (const auto& group : m_groupList) {
+            AddGroupToDrawList(*group, 0);
+        }
+        // the levels stack the overlapping widgets of a layer and depth in the order they were added
+        std::ranges::sort(m_drawList, {}, [](const DrawEntry& entry) {
+            return std::tie(entry.key.layer, entry.key.depth, entry.key.sequence);
+        });
+        for (size_t first = 0; first < m_drawList.size();) {
+            size_t last = first + 1;
+            while (last < m_drawList.size() && m_drawList[last].key.layer == m_drawList[first].key.layer
+                   && m_drawList[last].key.depth == m_drawList[first].key.depth) {
+                ++last;
+            }
+            LevelDrawList(first, last);
+            first = last;
+        }
+        // the sequences are unique, equal keys cannot reorder between frames
+        std::ranges::sort(m_drawList, {}, &DrawEntry::key);
+    }
+
+    void GUI::LevelDrawList(size_t first, size_t last) const
+    {
+        if (last - first == 1) {
+            m_drawList[first].key.level = 0;
+            return;
+        }
+
+        // cells about the size of the widgets, each widget is then found in a few of them
+        float size = 0.f;
+        for (size_t i = first; i < last; ++i) {
+            const sf::FloatRect bounds = m_drawList[i].widget->GetGlobalBounds();
+            size += std::abs(bounds.width) + std::abs(bounds.height);
+        }
+        m_levelGrid.Clear();
+        m_levelGrid.SetCellSize(size / static_cast<float>(2 * (last - first)));
+
+        for (size_t i = first; i < last; ++i) {
+            const sf::FloatRect bounds = m_drawList[i].widget->GetGlobalBounds();
+            int level = 0;
+            m_levelGrid.ForEachOverlap(bounds, [&](size_t below) {
+                level = std::max(level, m_drawList[below].key.level + 1);
                 return true;
+            });
+            m_drawList[i].key.level = level;
+            m_levelGrid.Add(bounds, i);
+        }
+    }
+
+    void GUI::AddToDrawList(const std::shared_ptr<Widget>& widget, int layer) const
+    {
+        if (m_isCulling && !widget->GetGlobalBounds().intersects(m_viewBounds)) {
+            ++m_culledCount;
+            return;
+        }
+        DrawKey key;
+        key.layer = layer + widget->GetLayer();
+        key.depth = widget->GetDepth();
+        key.material = reinterpret_cast<std::uintptr_t>(widget->GetMaterial());
+        key.sequence = m_drawList.size();
+        m_drawList.push_back({ key, widget });
+    }
+
+    void GUI::AddGroupToDrawList(const Group& group, int layer) const
+    {
+        GUICPP_TRACE_SCOPE("group", "Group");
+        if (!group.m_isVisible)
+            return;
+        // a whole group out of the view is skipped without looking at its widgets
+        if (m_isCulling && !group.GetGroupBounds().intersects(m_viewBounds)) {
+            ++m_culledCount;
+            return;
+        }
+        layer += group.m_layer;
+        for (const auto& widget : group.m_widgetList) {
+            AddToDrawList(widget, layer);
+        }
+        for (const auto& child : group.m_child) {
+            AddGroupToDrawList(*child, layer);
+        }
+    }
+
+    void GUI::DrawWidgets(RenderSink& sink, sf::RenderStates& states, const sf::FloatRect* area) const
+    {
+        for (const DrawEntry& entry : m_drawList) {
+            Widget& widget = *entry.widget;
+            const sf::FloatRect bounds = widget.GetGlobalBounds();
+            if (area != nullptr && !bounds.intersects(*area))
+                continue;
+            // the labels are drawn one draw call per glyph page, before a widget covering one of them
+            if (m_textBatch.Overlaps(bounds)) {
+                m_textBatch.Flush(sink, states);
+            }
+            widget.SetRenderSink(&sink);
+            GUICPP_PROFILE_WIDGET(&widget, Draw);
+            GUICPP_TRACE_SCOPE("draw", widget.GetTypeName());
+            widget.Draw(states);
+        }
+        m_textBatch.Flush(sink, states);
+    }
+
+    void GUI::DrawPartially(sf::RenderStates& states) const
+    {
+        const sf::Vector2u size = m_window.getSize();
+        if (m_canvas.getSize() != size) {
+            if (!m_canvas.create(size.x, size.y)) {
+                DrawWidgets(m_windowSink, states, nullptr);
+                return;
+            }
+            m_isCanvasValid = false;
+        }
+
+        // the canvas holds the widgets drawn by the last Draw, with the same view
+        const sf::View& view = m_window.getView();
+        if (IsCanvasStale()) {
+            m_isCanvasValid = false;
+        }
+
+        const sf::IntRect canvasArea(0, 0, static_cast<int>(size.x), static_cast<int>(size.y));
+        m_redrawnAreas.clear();
+        if (m_isCanvasValid) {
+            for (const DrawEntry& entry : m_drawList) {
+                const Widget& widget = *entry.widget;
+                if (!widget.m_isDrawn || widget.m_isDirty) {
+                    AddRedrawnArea(widget.GetGlobalBounds(), view, canvasArea);
+                }
+                if (widget.m_isDrawn && widget.m_isDirty) {
+                    AddRedrawnArea(widget.m_drawnBounds, view, canvasArea);
+                }
+            }
+
+            // overlapping areas are redrawn once, too large a part of the window is redrawn whole
+            for (bool isMerged = true; isMerged;) {
+                isMerged = false;
+                for (size_t i = 0; i < m_redrawnAreas.size() && !isMerged; ++i) {
+                    for (size_t j = i + 1; j < m_redrawnAreas.size() && !isMerged; ++j) {
+                        if (m_redrawnAreas[i].intersects(m_redrawnAreas[j])) {
+                            m_redrawnAreas[i] = UniteAreas(m_redrawnAreas[i], m_redrawnAreas[j]);
+                            m_redrawnAreas.erase(m_redrawnAreas.begin() + static_cast<std::ptrdiff_t>(j));
+                            isMerged = true;
+                        }
+                    }
+                }
+            }
+            float redrawnPixels = 0.f;
+            for (const sf::IntRect& area : m_redrawnAreas) {
+                redrawnPixels += static_cast<float>(area.width) * static_cast<float>(area.height);
+            }
+            if (redrawnPixels > m_fullRedrawRatio * static_cast<float>(size.x) * static_cast<float>(size.y)) {
+                m_isCanvasValid = false;
+            }
+        }
+
+        sf::RenderStates canvasStates = states;
+        canvasStates.blendMode = CanvasBlendMode;
+        if (!m_isCanvasValid) {
+            m_redrawnAreas.assign(1, canvasArea);
+            m_canvas.clear(sf::Color::Transparent);
+            m_canvas.setView(view);
+            DrawWidgets(m_canvasSink, canvasStates, nullptr);
+        } else {
+            const sf::FloatRect viewport(
+                view.getViewport().left * size.x, view.getViewport().top * size.y,
+                view.getViewport().width * size.x, view.getViewport().height * size.y);
+            for (const sf::IntRect& area : m_redrawnAreas) {
+                const sf::FloatRect areaBounds(area);
+                const sf::FloatRect areaViewport(areaBounds.left / size.x, areaBounds.top / size.y,
+                                                 areaBounds.width / size.x, areaBounds.height / size.y);
+
+                // erase the area, the viewport keeps the drawing inside it
+                sf::View pixelView(areaBounds);
+                pixelView.setViewport(areaViewport);
+                m_canvas.setView(pixelView);
+                sf::RectangleShape eraser({ areaBounds.width, areaBounds.height });
+                eraser.setPosition(areaBounds.left, areaBounds.top);
+                eraser.setFillColor(sf::Color::Transparent);
+                m_canvas.draw(eraser, sf::RenderStates(sf::BlendNone));
+
+                // the part of the window view shown by the area
+                sf::View areaView = view;
+                const sf::Vector2f center(areaBounds.left + areaBounds.width / 2.f, areaBounds.top + areaBounds.height / 2.f);
+                areaView.setCenter(view.getInverseTransform().transformPoint(
+                    -1.f + 2.f * (center.x - viewport.left) / viewport.width,
+                    1.f - 2.f * (center.y - viewport.top) / viewport.height));
+                areaView.setSize(view.getSize().x * areaBounds.width / viewport.width,
+                                 view.getSize().y * areaBounds.height / viewport.height);
+                areaView.setViewport(areaViewport);
+                m_canvas.setView(areaView);
+                const sf::FloatRect worldArea = GetViewBounds(areaView);
+                DrawWidgets(m_canvasSink, canvasStates, &worldArea);
             }
+            m_canvas.setView(view);
+        }
+        m_canvas.display();
+
+        m_isCanvasValid = true;
+
+        // the canvas covers the window pixel for pixel
+        m_window.setView(sf::View(sf::FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y))));
+        sf::RenderStates blitStates = states;
+        blitStates.transform = sf::Transform::Identity;
+        blitStates.blendMode = PremultipliedBlendMode;
+        m_window.draw(sf::Sprite(m_canvas.getTexture()), blitStates);
+        m_window.setView(view);
+    }
+
+    bool GUI::IsDrawListChanged() const
+    {
+        return !m_hasDrawn || m_window.getSize() != m_drawnSize || !IsSameView(m_window.getView(), m_drawnView)
+            || !std::ranges::equal(m_drawnWidgets, m_drawList, {}, {}, [](const DrawEntry& entry) { return entry.widget.get(); });
+    }
+
+    bool GUI::IsCanvasStale() const
+    {
+        if (!IsDrawListChanged())
+            return false;
+        if (!m_hasDrawn || m_window.getSize() != m_drawnSize || !IsSameView(m_window.getView(), m_drawnView))
+            return true;
+
+        // the same widgets as drawn, each found at the position it was drawn at
+        if (m_drawList.size() != m_drawnWidgets.size())
+            return true;
+        float size = 0.f;
+        for (const DrawEntry& entry : m_drawList) {
+            const Widget& widget = *entry.widget;
+            if (widget.m_drawnIndex >= m_drawnWidgets.size() || m_drawnWidgets[widget.m_drawnIndex] != &widget)
+                return true;
+            const sf::FloatRect bounds = widget.GetGlobalBounds();
+            size += std::abs(bounds.width) + std::abs(bounds.height);
+        }
+
+        // a widget drawn above one it overlaps must still be, the others are redrawn with their areas
+        m_orderGrid.Clear();
+        m_orderGrid.SetCellSize(size / static_cast<float>(2 * std::max<size_t>(m_drawList.size(), 1)));
+        for (size_t i = 0; i < m_drawList.size(); ++i) {
+            const Widget& widget = *m_drawList[i].widget;
+            const sf::FloatRect bounds = widget.GetGlobalBounds();
+            bool isSwapped = false;
+            m_orderGrid.ForEachOverlap(bounds, [&](size_t below) {
+                isSwapped = m_drawList[below].widget->m_drawnIndex > widget.m_drawnIndex;
+                return !isSwapped;
+            });
+            if (isSwapped)
+                return true;
+            m_orderGrid.Add(bounds, i);
         }
         return false;
     }
 
-    void GUI::DrawFromGroupList(sf::RenderStates& states) const
+    void GUI::AddRedrawnArea(const sf::FloatRect& bounds, const sf::View& view, const sf::IntRect& canvasArea) const
+    {
+        const sf::Vector2i corners[] = {
+            m_canvas.mapCoordsToPixel({ bounds.left, bounds.top }, view),
+            m_canvas.mapCoordsToPixel({ bounds.left + bounds.width, bounds.top }, view),
+            m_canvas.mapCoordsToPixel({ bounds.left + bounds.width, bounds.top + bounds.height }, view),
+            m_canvas.mapCoordsToPixel({ bounds.left, bounds.top + bounds.height }, view)
+        };
+        sf::Vector2i min = corners[0];
+        sf::Vector2i max = corners[0];
+        for (const sf::Vector2i& corner : corners) {
+            min.x = std::min(min.x, corner.x);
+            min.y = std::min(min.y, corner.y);
+            max.x = std::max(max.x, corner.x);
+            max.y = std::max(max.y, corner.y);
+        }
+
+        // one more pixel around for the smoothed edges
+        const sf::IntRect area(min.x - 1, min.y - 1, max.x - min.x + 3, max.y - min.y + 3);
+        sf::IntRect visibleArea;
+        if (area.intersects(canvasArea, visibleArea)) {
+            m_redrawnAreas.push_back(visibleArea);
+        }
+    }
+
+    void GUI::PackHitTestBatch() const
     {
-        for (auto& group : m_groupList) {
-            group->Draw(states);
+        m_isHitTestBatchDirty = false;
+        m_hitTestBatch.Clear();
+        m_hitTestWidgets.clear();
+        for (const auto& entry : m_drawList) {
+            m_hitTestBatch.Add(entry.widget->GetGlobalBounds());
+            m_hitTestWidgets.push_back(entry.widget.get());
         }
     }
 
@@ -1,4 +1,6 @@
 #include "Group.h"
+#include "AssetPreloader.h"
+#include "Culling.h"
 #include "Widget.h"
 
 using namespace GUICPP;
@@ -15,8 +17,17 @@ bool Group::HandleEvents(sf::Event& event)
     bool handled = false;
     if (m_isVisible)
     {
+        // the widgets out of the view cannot be under the mouse
+        const sf::RenderWindow* window = m_widgetList.empty() ? nullptr : m_widgetList.front()->m_window;
+        const bool isCulling = window != nullptr;
+        const sf::FloatRect viewBounds = isCulling ? GetViewBounds(window->getView()) : sf::FloatRect();
+        if (isCulling && !GetGroupBounds().intersects(viewBounds))
+            return false;
+
         for (auto& widget : m_widgetList)
         {
+            if (isCulling && !widget->GetGlobalBounds().intersects(viewBounds))
+                continue;
             if(widget->HandleEvents(event) && !handled)
             {
                 handled = true;
@@ -36,25 +47,52 @@ bool Group::HandleEvents(sf::Event& event)
 
 void Group::Draw(sf::RenderStates& states)
 {
-    if (m_isVisible)
+    if (!m_isVisible)
+        return;
+
+    // the widgets share the window of the GUI, what its view does not show is skipped
+    const sf::RenderWindow* window = m_widgetList.empty() ? nullptr : m_widgetList.front()->m_window;
+    const bool isCulling = window != nullptr;
+    const sf::FloatRect viewBounds = isCulling ? GetViewBounds(window->getView()) : sf::FloatRect();
+    if (isCulling && !GetGroupBounds().intersects(viewBounds))
+        return;
+
+    for (auto& widget : m_widgetList)
     {
-        for (auto& widget : m_widgetList)
+        if (!isCulling || widget->GetGlobalBounds().intersects(viewBounds))
         {
             widget->Draw(states);
         }
-        for (auto& child : m_child)
+    }
+    for (auto& child : m_child)
+    {
+        child->Draw(states);
+    }
+}
+
+Group::~Group()
+{
+    for (auto& widget : m_widgetList)
+    {
+        if (widget->m_group == this)
         {
-            child->Draw(states);
+            widget->m_group = nullptr;
         }
     }
+    for (auto& child : m_child)
+    {
+        child->m_parent = nullptr;
+    }
 }
 
 void Group::AddWidgetToGroup(std::shared_ptr<Widget> widget)
 {
+    widget->m_group = this;
     m_widgetList.push_back(widget);
     sf::Vector2f widgetGlobalPosition = widget->GetPosition();
     widgetGlobalPosition += m_globalPosition;
     widget->SetPosition(widgetGlobalPosition);
+    InvalidateBounds();
 }
 
 void Group::RemoveWidgetFromGroup(const Widget* widget)
@@ -63,20 +101,36 @@ void Group::RemoveWidgetFromGroup(const Widget* widget)
         std::remove_if(
             m_widgetList.begin(),
             m_widgetList.end(),
-            [widget](const auto& w) { return w.get() == widget; }),
+            [this, widget](const auto& w) {
+                if (w.get() != widget)
+                    return false;
+                if (w->m_group == this)
+                {
+                    w->m_group = nullptr;
+                }
+                return true;
+            }),
         m_widgetList.end());
+    InvalidateBounds();
 }
 
 void Group::AddChildGroup(std::shared_ptr<Group> child)
 {
     m_child.push_back(child);
+    child->m_parent = this;
     sf::Vector2f newPosition = m_globalPosition + child->m_relativePosition;
     child->SetGroupGlobalPosition(newPosition);
+    InvalidateBounds();
 }
 
 void Group::SetGroupVisibility(bool visibility)
 {
     m_isVisible = visibility;
+    InvalidateDrawOrder();
+    if (m_isVisible)
+    {
+        BindResources();
+    }
 }
 
 bool Group::GetGroupVisibility() const
@@ -84,15 +138,122 @@ bool Group::GetGroupVisibility() const
     return m_isVisible;
 }
 
+void Group::SetGroupLayer(int layer)
+{
+    m_layer = layer;
+    InvalidateDrawOrder();
+}
+
+int Group::GetGroupLayer() const
+{
+    return m_layer;
+}
+
+sf::FloatRect Group::GetGroupBounds() const
+{
+    if (m_isBoundsDirty)
+    {
+        m_hasBounds = false;
+        m_bounds = sf::FloatRect();
+        for (const auto& widget : m_widgetList)
+        {
+            const sf::FloatRect bounds = widget->GetGlobalBounds();
+            m_bounds = m_hasBounds ? UniteBounds(m_bounds, bounds) : bounds;
+            m_hasBounds = true;
+        }
+        for (const auto& child : m_child)
+        {
+            const sf::FloatRect bounds = child->GetGroupBounds();
+            if (child->m_hasBounds)
+            {
+                m_bounds = m_hasBounds ? UniteBounds(m_bounds, bounds) : bounds;
+                m_hasBounds = true;
+            }
+        }
+        m_isBoundsDirty = false;
+    }
+    return m_bounds;
+}
+
+void Group::InvalidateBounds()
+{
+    // the widgets culled and stacked by the draw list depend on the bounds
+    InvalidateDrawOrder();
+    for (Group* group = this; group != nullptr && !group->m_isBoundsDirty; group = group->m_parent)
+    {
+        group->m_isBoundsDirty = true;
+    }
+}
+
+void Group::InvalidateDrawOrder() const
+{
+    const Group* root = this;
+    while (root->m_parent != nullptr)
+    {
+        root = root->m_parent;
+    }
+    if (root->m_drawOrderFlag != nullptr)
+    {
+        *root->m_drawOrderFlag = true;
+    }
+}
+
+void Group::BindResources()
+{
+    for (auto& widget : m_widgetList)
+    {
+        widget->BindResources();
+    }
+    for (auto& child : m_child)
+    {
+        if (child->m_isVisible)
+        {
+            child->BindResources();
+        }
+    }
+}
+
+void Group::PrefetchResources()
+{
+    for (auto& widget : m_widgetList)
+    {
+        widget->BindResources();
+    }
+    for (auto& child : m_child)
+    {
+        child->PrefetchResources();
+    }
+}
+
+void Group::PrefetchResources(AssetPreloader& preloader) const
+{
+    std::vector<std::string> paths;
+    for (const auto& widget : m_widgetList)
+    {
+        widget->CollectResources(paths);
+    }
+    preloader.Add(paths);
+    for (const auto& child : m_child)
+    {
+        child->PrefetchResources(preloader);
+    }
+}
+
 void Group::RemoveChildFromGroup()
 {
+    for (auto& child : m_child)
+    {
+        child->m_parent = nullptr;
+    }
     m_child.clear();
+    InvalidateBounds();
 }
 
 // setters
 void Group::SetGroupGlobalPosition(const sf::Vector2f& position)
 {
     m_globalPosition = position;
+    InvalidateBounds();
 
     for (auto& widget : m_widgetList)
     {
@@ -0,0 +1,118 @@
+#include "HitMask.h"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+namespace GUICPP
+{
+
+    std::shared_ptr<const HitMask> HitMask::Get(const std::shared_ptr<const sf::Texture>& texture, sf::Uint8 alphaThreshold,
+                                                unsigned int levelCount)
+    {
+        struct Entry
+        {
+            std::weak_ptr<const sf::Texture> texture;
+            std::shared_ptr<const HitMask> mask;
+        };
+        static std::map<std::tuple<const sf::Texture*, sf::Uint8, unsigned int>, Entry> masks;
+
+        if (!texture)
+            return nullptr;
+
+        // forget the masks of released textures first, their address may be reused
+        std::erase_if(masks, [](const auto& entry) { return entry.second.texture.expired(); });
+
+        Entry& entry = masks[{ texture.get(), alphaThreshold, levelCount }];
+        if (!entry.mask)
+        {
+            entry.texture = texture;
+            entry.mask = std::make_shared<const HitMask>(texture->copyToImage(), alphaThreshold, levelCount);
+        }
+        return entry.mask;
+    }
+
+    HitMask::HitMask(const sf::Image& image, sf::Uint8 alphaThreshold, unsigned int levelCount)
+    {
+        const sf::Vector2u size = image.getSize();
+        const sf::Uint8* pixels = image.getPixelsPtr();
+
+        Level& full = m_levels.emplace_back(size.x, size.y);
+        for (unsigned int y = 0; y < size.y; ++y)
+        {
+            for (unsigned int x = 0; x < size.x; ++x)
+            {
+                if (pixels[(static_cast<size_t>(y) * size.x + x) * 4 + 3] >= alphaThreshold)
+                    full.Set(x, y);
+            }
+        }
+
+        // each coarser bit covers four finer ones, set if any of them is
+        for (unsigned int levelIndex = 1; levelIndex < levelCount; ++levelIndex)
+        {
+            const Level& finer = m_levels.back();
+            if (finer.width <= 1 && finer.height <= 1)
+                break;
+
+            Level coarser((finer.width + 1) / 2, (finer.height + 1) / 2);
+            for (unsigned int y = 0; y < finer.height; ++y)
+            {
+                for (unsigned int x = 0; x < finer.width; ++x)
+                {
+                    if (finer.Test(x, y))
+                        coarser.Set(x / 2, y / 2);
+                }
+            }
+            m_levels.push_back(std::move(coarser));
+        }
+    }
+
+    bool HitMask::Contains(sf::Vector2f point, unsigned int level) const
+    {
+        if (point.x < 0.f || point.y < 0.f)
+            return false;
+
+        level = std::min(level, GetLevelCount() - 1);
+        const Level& mask = m_levels[level];
+        const unsigned int x = static_cast<unsigned int>(point.x) >> level;
+        const unsigned int y = static_cast<unsigned int>(point.y) >> level;
+        return x < mask.width && y < mask.height && mask.Test(x, y);
+    }
+
+    unsigned int HitMask::GetLevelCount() const
+    {
+        return static_cast<unsigned int>(m_levels.size());
+    }
+
+    sf::Vector2u HitMask::GetSize(unsigned int level) const
+    {
+        const Level& mask = m_levels[std::min(level, GetLevelCount() - 1)];
+        return { mask.width, mask.height };
+    }
+
+    size_t HitMask::GetMemoryBytes() const
+    {
+        size_t bytes = sizeof(HitMask);
+        for (const Level& level : m_levels)
+        {
+            bytes += sizeof(Level) + level.bits.size() * sizeof(std::uint64_t);
+        }
+        return bytes;
+    }
+
+    HitMask::Level::Level(unsigned int width, unsigned int height)
+        : width(width), height(height), wordsPerRow((width + 63) / 64), bits(static_cast<size_t>(wordsPerRow) * height, 0)
+    {
+    }
+
+    bool HitMask::Level::Test(unsigned int x, unsigned int y) const
+    {
+        return (bits[static_cast<size_t>(y) * wordsPerRow + x / 64] >> (x % 64)) & 1u;
+    }
+
+    void HitMask::Level::Set(unsigned int x, unsigned int y)
+    {
+        bits[static_cast<size_t>(y) * wordsPerRow + x / 64] |= std::uint64_t(1) << (x % 64);
+    }
+
+}
@@ -0,0 +1,126 @@
+#include "HitTestBatch.h"
+
+#include <algorithm>
+#include <bit>
+
+#if !defined(GUICPP_NO_SIMD) && defined(__AVX__)
+#define GUICPP_HIT_TEST_AVX
+#include <immintrin.h>
+#elif !defined(GUICPP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GUICPP_HIT_TEST_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        // the widest block any instruction set tests, the arrays are padded to it
+        constexpr size_t BlockSize = 8;
+    }
+
+    void HitTestBatch::Clear()
+    {
+        m_left.clear();
+        m_top.clear();
+        m_right.clear();
+        m_bottom.clear();
+        m_count = 0;
+    }
+
+    void HitTestBatch::Reserve(size_t count)
+    {
+        const size_t padded = (count + BlockSize - 1) / BlockSize * BlockSize;
+        m_left.reserve(padded);
+        m_top.reserve(padded);
+        m_right.reserve(padded);
+        m_bottom.reserve(padded);
+    }
+
+    size_t HitTestBatch::Add(const sf::FloatRect& bounds)
+    {
+        // a new block is filled with rectangles containing no point
+        if (m_count == m_left.size())
+        {
+            const size_t padded = m_count + BlockSize;
+            m_left.resize(padded, 1.f);
+            m_top.resize(padded, 1.f);
+            m_right.resize(padded, 0.f);
+            m_bottom.resize(padded, 0.f);
+        }
+
+        // normalized as sf::Rect::contains does for negative sizes
+        m_left[m_count] = std::min(bounds.left, bounds.left + bounds.width);
+        m_top[m_count] = std::min(bounds.top, bounds.top + bounds.height);
+        m_right[m_count] = std::max(bounds.left, bounds.left + bounds.width);
+        m_bottom[m_count] = std::max(bounds.top, bounds.top + bounds.height);
+        return m_count++;
+    }
+
+    size_t HitTestBatch::GetSize() const
+    {
+        return m_count;
+    }
+
+    size_t HitTestBatch::FindTopmost(sf::Vector2f point) const
+    {
+        // the blocks are tested from the top, the highest hit of the first block hit is the topmost
+#if defined(GUICPP_HIT_TEST_AVX)
+        const __m256 x = _mm256_set1_ps(point.x);
+        const __m256 y = _mm256_set1_ps(point.y);
+        for (size_t block = m_left.size(); block > 0; block -= 8)
+        {
+            const size_t first = block - 8;
+            const __m256 inside = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&m_left[first]), x, _CMP_LE_OQ),
+                              _mm256_cmp_ps(x, _mm256_loadu_ps(&m_right[first]), _CMP_LT_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&m_top[first]), y, _CMP_LE_OQ),
+                              _mm256_cmp_ps(y, _mm256_loadu_ps(&m_bottom[first]), _CMP_LT_OQ)));
+            const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(inside));
+            if (mask != 0)
+                return first + 31 - std::countl_zero(mask);
+        }
+        return NoHit;
+#elif defined(GUICPP_HIT_TEST_SSE2)
+        const __m128 x = _mm_set1_ps(point.x);
+        const __m128 y = _mm_set1_ps(point.y);
+        for (size_t block = m_left.size(); block > 0; block -= 4)
+        {
+            const size_t first = block - 4;
+            const __m128 inside = _mm_and_ps(
+                _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&m_left[first]), x), _mm_cmplt_ps(x, _mm_loadu_ps(&m_right[first]))),
+                _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&m_top[first]), y), _mm_cmplt_ps(y, _mm_loadu_ps(&m_bottom[first]))));
+            const unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(inside));
+            if (mask != 0)
+                return first + 31 - std::countl_zero(mask);
+        }
+        return NoHit;
+#else
+        return FindTopmostScalar(point);
+#endif
+    }
+
+    size_t HitTestBatch::FindTopmostScalar(sf::Vector2f point) const
+    {
+        for (size_t index = m_count; index > 0; --index)
+        {
+            const size_t i = index - 1;
+            if (m_left[i] <= point.x && point.x < m_right[i] && m_top[i] <= point.y && point.y < m_bottom[i])
+                return i;
+        }
+        return NoHit;
+    }
+
+    const char* HitTestBatch::GetInstructionSet()
+    {
+#if defined(GUICPP_HIT_TEST_AVX)
+        return "AVX";
+#elif defined(GUICPP_HIT_TEST_SSE2)
+        return "SSE2";
+#else
+        return "Scalar";
+#endif
+    }
+
+}
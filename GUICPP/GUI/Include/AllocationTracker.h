@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * The global operator new of the program is replaced to count the allocations only when
+ * GUICPP_TRACK_ALLOCATIONS is defined, the macro below expands to nothing otherwise.
+ */
+#ifdef GUICPP_TRACK_ALLOCATIONS
+/** End the frame of the calling thread. */
+#define GUICPP_ALLOCATIONS_END_FRAME() GUICPP::AllocationTracker::EndFrame()
+#else
+#define GUICPP_ALLOCATIONS_END_FRAME() static_cast<void>(0)
+#endif
+
+namespace GUICPP
+{
+    /**
+     * @brief The allocations made under a call site during a frame.
+     */
+    struct AllocationSiteCount
+    {
+        const char* category = ""; ///< The category of the innermost traced span, empty outside any span.
+        const char* name = ""; ///< The name of the innermost traced span, such as the type of a widget.
+        size_t count = 0; ///< The number of allocations.
+        size_t bytes = 0; ///< The bytes allocated.
+    };
+
+    /**
+     * @brief A call site the allocations are counted under.
+     */
+    struct AllocationSite
+    {
+        const char* category = ""; ///< The category of the site.
+        const char* name = ""; ///< The name of the site.
+        const AllocationSite* previous = nullptr; ///< The call site of the thread before this one.
+    };
+
+    /**
+     * @brief The allocations a thread made during a frame.
+     */
+    struct FrameAllocations
+    {
+        size_t frame = 0; ///< The number of the frame, from 1.
+        size_t count = 0; ///< The number of allocations.
+        size_t bytes = 0; ///< The bytes allocated.
+        std::vector<AllocationSiteCount> sites; ///< The call sites that allocated, from the one allocating the most.
+    };
+
+    /**
+     * @class AllocationTracker
+     * @brief Counts the allocations of each thread, frame by frame and call site by call site, when built with GUICPP_TRACK_ALLOCATIONS.
+     *
+     * @details The replaced operator new counts every allocation on the thread making it. The call
+     * site is the innermost span declared with GUICPP_TRACE_SCOPE, whether a trace is written or not:
+     * GUI::HandleEvents and the widget offered the event, the widget drawn, the delegate, the asset
+     * loaded. The GUI ends the frame of its thread after each Draw or Record. The counters stay at
+     * zero without GUICPP_TRACK_ALLOCATIONS.
+     */
+    class AllocationTracker
+    {
+    public:
+        static constexpr size_t MaxSites = 64; ///< The call sites told apart per frame, the others are added to the last one.
+
+        /**
+         * @brief Check whether the allocations are counted.
+         *
+         * @return bool True when built with GUICPP_TRACK_ALLOCATIONS.
+         */
+        static constexpr bool IsEnabled()
+        {
+#ifdef GUICPP_TRACK_ALLOCATIONS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Count an allocation of the calling thread, called by operator new.
+         *
+         * @param bytes The size of the allocation.
+         */
+        static void Record(size_t bytes);
+
+        /**
+         * @brief Complete the frame of the calling thread, which becomes its last frame.
+         */
+        static void EndFrame();
+
+        /**
+         * @brief Get the last completed frame of the calling thread.
+         *
+         * @return const FrameAllocations& The frame, empty before the first one.
+         */
+        [[nodiscard]] static const FrameAllocations& GetLastFrame();
+
+        /**
+         * @brief Get the allocations of the calling thread since it started.
+         *
+         * @return size_t The number of allocations.
+         */
+        [[nodiscard]] static size_t GetTotalCount();
+
+        /**
+         * @brief Make a site the call site of the allocations of the calling thread, used by TraceScope.
+         *
+         * @param site The site, it must stay in place until LeaveSite.
+         */
+        static void EnterSite(AllocationSite& site);
+
+        /**
+         * @brief Give the calling thread the call site it had before EnterSite back.
+         *
+         * @param site The site given to the matching EnterSite.
+         */
+        static void LeaveSite(const AllocationSite& site);
+    };
+}
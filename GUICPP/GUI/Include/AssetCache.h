@@ -0,0 +1,162 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+
+#include "AssetPack.h"
+
+namespace GUICPP
+{
+    /**
+     * @class AssetCache
+     * @brief Process-wide table of textures and sound buffers shared by normalized path.
+     *
+     * @details Widgets loading the same file get the same object, so a screen with thousands of
+     * identical bitmap widgets holds each texture once. Entries are released when the last widget
+     * referencing them is destroyed. Assets are looked up in the mounted packs first, most recently
+     * mounted first, then loaded from the file system.
+     *
+     * The cache is not locked. Every call, including AssetPreloader::Update which uploads into it,
+     * must be made from the render thread; the preloader workers only read the packs found by Start.
+     */
+    class AssetCache
+    {
+    public:
+        /**
+         * @brief Get the process-wide asset cache.
+         *
+         * @return AssetCache& The asset cache.
+         */
+        static AssetCache& GetInstance();
+
+        /**
+         * @brief Mount a pack file so that the assets it contains are loaded from it.
+         *
+         * @param path The path of the pack file.
+         * @return bool Returns true if the pack was mapped and mounted.
+         */
+        bool MountPack(const std::string& path);
+
+        /**
+         * @brief Mount a pack so that the assets it contains are loaded from it.
+         *
+         * @param pack The pack to mount, kept alive while mounted.
+         */
+        void MountPack(std::shared_ptr<const AssetPack> pack);
+
+        /**
+         * @brief Get the texture loaded from a file, loading it on first use.
+         *
+         * @param path The path of the texture file.
+         * @return std::shared_ptr<const sf::Texture> The shared texture, nullptr if the file could not be loaded.
+         */
+        std::shared_ptr<const sf::Texture> GetTexture(const std::string& path);
+
+        /**
+         * @brief Get the sound buffer loaded from a file, loading it on first use.
+         *
+         * @param path The path of the sound file.
+         * @return std::shared_ptr<sf::SoundBuffer> The shared sound buffer, nullptr if the file could not be loaded.
+         */
+        std::shared_ptr<sf::SoundBuffer> GetSoundBuffer(const std::string& path);
+
+        /**
+         * @brief Get the font loaded from a file, loading it on first use.
+         *
+         * @param path The path of the font file.
+         * @return std::shared_ptr<sf::Font> The shared font, nullptr if the file could not be loaded.
+         */
+        std::shared_ptr<sf::Font> GetFont(const std::string& path);
+
+        /**
+         * @brief Upload decoded pixels as the texture of a path, unless the path is already cached.
+         *
+         * @param path The path of the texture file the pixels were decoded from.
+         * @param pixels The 32-bit RGBA pixels.
+         * @param size The size of the texture in pixels.
+         * @return std::shared_ptr<const sf::Texture> The shared texture, nullptr if it could not be created.
+         */
+        std::shared_ptr<const sf::Texture> AddTexture(const std::string& path, const sf::Uint8* pixels, sf::Vector2u size);
+
+        /**
+         * @brief Load decoded samples as the sound buffer of a path, unless the path is already cached.
+         *
+         * @param path The path of the sound file the samples were decoded from.
+         * @param samples The 16-bit samples.
+         * @param sampleCount The number of samples.
+         * @param channelCount The number of channels.
+         * @param sampleRate The sample rate in Hz.
+         * @return std::shared_ptr<sf::SoundBuffer> The shared sound buffer, nullptr if it could not be loaded.
+         */
+        std::shared_ptr<sf::SoundBuffer> AddSoundBuffer(const std::string& path, const sf::Int16* samples, sf::Uint64 sampleCount,
+                                                        unsigned channelCount, unsigned sampleRate);
+
+        /**
+         * @brief Cache a loaded font as the font of a path, unless the path is already cached.
+         *
+         * @param path The path of the font file.
+         * @param font The loaded font.
+         * @return std::shared_ptr<sf::Font> The shared font.
+         */
+        std::shared_ptr<sf::Font> AddFont(const std::string& path, std::shared_ptr<sf::Font> font);
+
+        /**
+         * @brief Find the mounted pack containing an asset.
+         *
+         * @param path The normalized path of the asset.
+         * @return const AssetPack* The most recently mounted pack containing the asset, nullptr if none does.
+         */
+        [[nodiscard]] const AssetPack* FindPack(const std::string& path) const;
+
+        /**
+         * @brief Get the GPU memory used by the live cached textures.
+         *
+         * @return size_t The texture memory in bytes.
+         */
+        [[nodiscard]] size_t GetTextureBytes() const;
+
+        /**
+         * @brief Get the memory used by the samples of the live cached sound buffers.
+         *
+         * @return size_t The sample memory in bytes.
+         */
+        [[nodiscard]] size_t GetSoundBufferBytes() const;
+
+        /**
+         * @brief Get the GPU memory used by a texture, assuming 32-bit RGBA texels.
+         *
+         * @param texture The texture to measure, may be nullptr.
+         * @return size_t The texture memory in bytes.
+         */
+        static size_t GetTextureBytes(const sf::Texture* texture);
+
+        /**
+         * @brief Get the share of a referencing object in the GPU memory of a cached texture.
+         *
+         * @param texture The shared texture, may be nullptr.
+         * @return size_t The texture memory divided by the number of objects referencing it.
+         */
+        static size_t GetTextureShare(const std::shared_ptr<const sf::Texture>& texture);
+
+        /**
+         * @brief Get the memory used by the samples of a sound buffer.
+         *
+         * @param buffer The sound buffer to measure, may be nullptr.
+         * @return size_t The sample memory in bytes.
+         */
+        static size_t GetSoundBufferBytes(const sf::SoundBuffer* buffer);
+
+    private:
+        AssetCache() = default;
+
+        std::vector<std::shared_ptr<const AssetPack>> m_packs; ///< The mounted packs, in mount order.
+
+        std::unordered_map<std::string, std::weak_ptr<sf::Texture>> m_textures; ///< Live textures by normalized path.
+        std::unordered_map<std::string, std::weak_ptr<sf::SoundBuffer>> m_soundBuffers; ///< Live sound buffers by normalized path.
+        std::unordered_map<std::string, std::weak_ptr<sf::Font>> m_fonts; ///< Live fonts by normalized path.
+    };
+}
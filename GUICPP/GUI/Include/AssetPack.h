@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+
+namespace GUICPP
+{
+    /**
+     * @brief The kind of payload stored for an asset of a pack.
+     */
+    enum class AssetPackPayload : uint32_t
+    {
+        Encoded, ///< The original file bytes (PNG, OGG, TTF...), decoded by SFML when loaded.
+        Rgba, ///< Pre-decoded 32-bit RGBA pixels, width and height are set.
+        Pcm ///< Pre-decoded 16-bit PCM samples, channel count and sample rate are set.
+    };
+
+    /**
+     * @brief The header at the start of a pack file.
+     */
+    struct AssetPackHeader
+    {
+        char magic[4]; ///< Always "GCPK".
+        uint32_t version; ///< The version of the format, see AssetPack::Version.
+        uint32_t entryCount; ///< The number of entries following the header.
+        uint32_t pathTableSize; ///< The size in bytes of the path table following the entries.
+    };
+
+    /**
+     * @brief The index entry of an asset of a pack.
+     */
+    struct AssetPackEntry
+    {
+        uint64_t dataOffset; ///< The offset of the payload from the start of the file, a multiple of AssetPack::Alignment.
+        uint64_t dataSize; ///< The size of the payload in bytes.
+        uint32_t pathOffset; ///< The offset of the path in the path table.
+        uint32_t pathLength; ///< The length of the path, without terminator.
+        AssetPackPayload payload; ///< The kind of payload.
+        uint32_t width; ///< The width of Rgba payloads, the channel count of Pcm payloads.
+        uint32_t height; ///< The height of Rgba payloads, the sample rate of Pcm payloads.
+        uint32_t reserved; ///< Always 0.
+    };
+
+    static_assert(sizeof(AssetPackHeader) == 16, "AssetPackHeader must match the file layout");
+    static_assert(sizeof(AssetPackEntry) == 40, "AssetPackEntry must match the file layout");
+
+    /**
+     * @class AssetPack
+     * @brief Read-only archive of assets, memory-mapped as a whole.
+     *
+     * @details A pack is a header, an index of entries, a path table and the payloads, each aligned
+     * on AssetPack::Alignment bytes. Loading an asset hands SFML a pointer into the mapping, so
+     * nothing is read or copied until SFML decodes or uploads it. Fonts keep reading from that
+     * memory, so a pack must outlive the fonts loaded from it. Packs are built by the AssetPacker
+     * tool and mounted with AssetCache::MountPack.
+     */
+    class AssetPack
+    {
+    public:
+        static constexpr uint32_t Version = 1; ///< The version of the format written by the packer.
+        static constexpr uint64_t Alignment = 64; ///< The alignment of every payload in the file.
+
+        /**
+         * @brief Map a pack file and read its index.
+         *
+         * @param path The path of the pack file.
+         * @return std::shared_ptr<AssetPack> The pack, nullptr if the file could not be mapped or is not a valid pack.
+         */
+        static std::shared_ptr<AssetPack> Open(const std::string& path);
+
+        AssetPack(const AssetPack&) = delete;
+        AssetPack& operator=(const AssetPack&) = delete;
+
+        /**
+         * @brief Unmap the pack file.
+         */
+        ~AssetPack();
+
+        /**
+         * @brief Find the entry of an asset.
+         *
+         * @param path The path of the asset, normalized with NormalizePath.
+         * @return const AssetPackEntry* The entry, nullptr if the pack does not contain the asset.
+         */
+        [[nodiscard]] const AssetPackEntry* Find(std::string_view path) const;
+
+        /**
+         * @brief Get the payload of an entry, pointing into the mapping.
+         *
+         * @param entry The entry of the asset.
+         * @return const std::byte* The first byte of the payload.
+         */
+        [[nodiscard]] const std::byte* GetData(const AssetPackEntry& entry) const;
+
+        /**
+         * @brief Load a texture from the pack.
+         *
+         * @param path The path of the asset.
+         * @param texture The texture to load into.
+         * @return bool Returns true if the pack contains the asset and it was loaded.
+         */
+        bool LoadTexture(const std::string& path, sf::Texture& texture) const;
+
+        /**
+         * @brief Load a font from the pack, the font keeps reading from the mapping.
+         *
+         * @param path The path of the asset.
+         * @param font The font to load into.
+         * @return bool Returns true if the pack contains the asset and it was loaded.
+         */
+        bool LoadFont(const std::string& path, sf::Font& font) const;
+
+        /**
+         * @brief Load a sound buffer from the pack.
+         *
+         * @param path The path of the asset.
+         * @param buffer The sound buffer to load into.
+         * @return bool Returns true if the pack contains the asset and it was loaded.
+         */
+        bool LoadSoundBuffer(const std::string& path, sf::SoundBuffer& buffer) const;
+
+        /**
+         * @brief Get the number of assets in the pack.
+         *
+         * @return size_t The number of assets.
+         */
+        [[nodiscard]] size_t GetEntryCount() const;
+
+        /**
+         * @brief Get the size of the mapping.
+         *
+         * @return size_t The size of the pack file in bytes.
+         */
+        [[nodiscard]] size_t GetMappedBytes() const;
+
+        /**
+         * @brief Normalize an asset path the way the packer stores it: forward slashes, no leading "./".
+         *
+         * @param path The path to normalize.
+         * @return std::string The normalized path.
+         */
+        static std::string NormalizePath(std::string_view path);
+
+    private:
+        AssetPack() = default;
+
+        /**
+         * @brief Map a file into memory.
+         *
+         * @param path The path of the file.
+         * @return bool Returns true if the file was mapped.
+         */
+        bool Map(const std::string& path);
+
+        /**
+         * @brief Check the header and the entries, then build the index.
+         *
+         * @return bool Returns true if the mapping is a valid pack.
+         */
+        bool ReadIndex();
+
+        const std::byte* m_data = nullptr; ///< The first byte of the mapping.
+        size_t m_size = 0; ///< The size of the mapping in bytes.
+        std::unordered_map<std::string_view, const AssetPackEntry*> m_index; ///< The entries by path, both pointing into the mapping.
+#ifdef _WIN32
+        void* m_file = nullptr; ///< The handle of the mapped file.
+        void* m_mapping = nullptr; ///< The handle of the file mapping.
+#else
+        int m_file = -1; ///< The descriptor of the mapped file.
+#endif
+    };
+}
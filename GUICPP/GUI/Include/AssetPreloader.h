@@ -0,0 +1,216 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+
+#include "AssetPack.h"
+
+namespace GUICPP
+{
+    /**
+     * @brief The progress of an asset preloader.
+     */
+    struct PreloadProgress
+    {
+        size_t total = 0; ///< The number of assets in the manifest.
+        size_t decoded = 0; ///< The number of assets decoded by the worker threads.
+        size_t loaded = 0; ///< The number of assets handed to the asset cache, including the failed ones.
+        size_t failed = 0; ///< The number of assets that could not be loaded.
+
+        /**
+         * @brief Get the fraction of the manifest that is loaded, for a progress bar.
+         *
+         * @return float The fraction between 0 and 1.
+         */
+        [[nodiscard]] float GetRatio() const
+        {
+            return total == 0 ? 1.f : static_cast<float>(loaded) / static_cast<float>(total);
+        }
+    };
+
+    /**
+     * @class AssetPreloader
+     * @brief Loads a manifest of textures, sounds and fonts into the asset cache on worker threads.
+     *
+     * @details The worker threads read and decode the files (images to pixels, sounds to samples,
+     * fonts to glyph faces). Only the upload to the GPU and the audio device happens on the thread
+     * calling Update, which must be the render thread. The preloader keeps the loaded assets alive,
+     * so widgets created while it exists share them through the asset cache without touching the
+     * disk. No pack may be mounted while a preload is running.
+     */
+    class AssetPreloader
+    {
+    public:
+        /**
+         * @brief Construct an empty preloader.
+         *
+         * @param threadCount The number of worker threads, 0 for one less than the number of cores.
+         */
+        explicit AssetPreloader(size_t threadCount = 0);
+
+        AssetPreloader(const AssetPreloader&) = delete;
+        AssetPreloader& operator=(const AssetPreloader&) = delete;
+
+        /**
+         * @brief Stop the worker threads, the assets already loaded are released.
+         */
+        ~AssetPreloader();
+
+        /**
+         * @brief Add a texture to the manifest.
+         *
+         * @param path The path of the texture file.
+         */
+        void AddTexture(const std::string& path);
+
+        /**
+         * @brief Add a sound to the manifest.
+         *
+         * @param path The path of the sound file.
+         */
+        void AddSoundBuffer(const std::string& path);
+
+        /**
+         * @brief Add a font to the manifest.
+         *
+         * @param path The path of the font file.
+         */
+        void AddFont(const std::string& path);
+
+        /**
+         * @brief Add a list of assets to the manifest, the type of each asset is guessed from its extension.
+         *
+         * @param paths The paths of the asset files.
+         */
+        void Add(const std::vector<std::string>& paths);
+
+        /**
+         * @brief Set the function called on the render thread each time the progress changes.
+         *
+         * @param callback The function to call.
+         */
+        void SetProgressCallback(std::function<void(const PreloadProgress&)> callback);
+
+        /**
+         * @brief Start decoding the manifest on the worker threads, assets added afterwards are ignored.
+         *
+         * @details Looks the assets up in the packs of the asset cache, on the render thread like Update.
+         */
+        void Start();
+
+        /**
+         * @brief Upload the decoded assets to the asset cache, to be called once per frame on the render thread.
+         *
+         * @details The asset cache is not locked, so this must be the thread that makes every other use of it.
+         *
+         * @param maxUploads The maximum number of assets to upload during this call, to bound the frame time.
+         * @return bool Returns true once every asset of the manifest is loaded.
+         */
+        bool Update(size_t maxUploads = SIZE_MAX);
+
+        /**
+         * @brief Block the render thread until every asset of the manifest is loaded, starting the preload if needed.
+         */
+        void Wait();
+
+        /**
+         * @brief Check whether every asset of the manifest is loaded.
+         *
+         * @return bool Returns true if the preload is complete.
+         */
+        [[nodiscard]] bool IsDone() const;
+
+        /**
+         * @brief Get the progress of the preload.
+         *
+         * @return PreloadProgress The progress.
+         */
+        [[nodiscard]] PreloadProgress GetProgress() const;
+
+    private:
+        /**
+         * @brief The kind of asset of a job.
+         */
+        enum class AssetKind
+        {
+            Texture,
+            SoundBuffer,
+            Font
+        };
+
+        /**
+         * @brief An asset of the manifest and the result of its decoding.
+         */
+        struct Job
+        {
+            AssetKind kind = AssetKind::Texture; ///< The kind of asset.
+            std::string path; ///< The path of the asset.
+            const AssetPack* pack = nullptr; ///< The mounted pack containing the asset, nullptr to read the file.
+            sf::Image image; ///< The decoded pixels of a texture read from a file or an encoded payload.
+            std::vector<sf::Int16> samples; ///< The decoded samples of a sound read from a file or an encoded payload.
+            unsigned channelCount = 0; ///< The channel count of the decoded samples.
+            unsigned sampleRate = 0; ///< The sample rate of the decoded samples.
+            std::shared_ptr<sf::Font> font; ///< The loaded font.
+            bool failed = false; ///< Whether the asset could not be decoded.
+        };
+
+        /**
+         * @brief Add an asset to the manifest unless the preload was started.
+         *
+         * @param kind The kind of asset.
+         * @param path The path of the asset file.
+         */
+        void AddJob(AssetKind kind, const std::string& path);
+
+        /**
+         * @brief Decode the jobs of the manifest until none are left, run by each worker thread.
+         *
+         * @param stopToken The token requesting the worker to stop.
+         */
+        void Work(const std::stop_token& stopToken);
+
+        /**
+         * @brief Read and decode the asset of a job.
+         *
+         * @param job The job to decode.
+         * @return bool Returns true if the asset was decoded.
+         */
+        static bool Decode(Job& job);
+
+        /**
+         * @brief Hand a decoded asset to the asset cache.
+         *
+         * @param job The decoded job.
+         * @return bool Returns true if the asset was loaded.
+         */
+        bool Upload(Job& job);
+
+        size_t m_threadCount; ///< The number of worker threads.
+        std::vector<Job> m_jobs; ///< The manifest, not resized once started.
+        std::vector<std::jthread> m_workers; ///< The worker threads.
+        std::atomic<size_t> m_nextJob; ///< The index of the next job to decode.
+        std::atomic<size_t> m_decodedCount; ///< The number of decoded jobs.
+
+        mutable std::mutex m_readyMutex; ///< Guards m_ready.
+        std::condition_variable m_readyCondition; ///< Signaled when a job is decoded.
+        std::vector<size_t> m_ready; ///< The decoded jobs waiting for an upload.
+
+        bool m_isStarted; ///< Whether the workers were started.
+        size_t m_loadedCount; ///< The number of uploaded jobs, including the failed ones.
+        size_t m_failedCount; ///< The number of failed jobs.
+        std::function<void(const PreloadProgress&)> m_progressCallback; ///< Called when the progress changes.
+
+        std::vector<std::shared_ptr<const sf::Texture>> m_textures; ///< The loaded textures, kept alive.
+        std::vector<std::shared_ptr<sf::SoundBuffer>> m_soundBuffers; ///< The loaded sound buffers, kept alive.
+        std::vector<std::shared_ptr<sf::Font>> m_fonts; ///< The loaded fonts, kept alive.
+    };
+}
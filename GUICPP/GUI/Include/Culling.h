@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+namespace GUICPP
+{
+    /**
+     * @brief Get the area of the world shown by a view.
+     *
+     * @details The rectangle contains the corners of a rotated view, it is larger than the view then.
+     *
+     * @param view The view.
+     * @return sf::FloatRect The world rectangle shown by the view.
+     */
+    sf::FloatRect GetViewBounds(const sf::View& view);
+
+    /**
+     * @brief Get the smallest rectangle containing two rectangles.
+     *
+     * @param first The first rectangle.
+     * @param second The second rectangle.
+     * @return sf::FloatRect The rectangle containing both.
+     */
+    sf::FloatRect UniteBounds(const sf::FloatRect& first, const sf::FloatRect& second);
+}
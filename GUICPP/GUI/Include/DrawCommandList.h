@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "RenderSink.h"
+
+namespace GUICPP
+{
+    /**
+     * @class DrawCommandList
+     * @brief The draws of a frame recorded with their geometry and states, to be replayed later or on another thread.
+     *
+     * @details The sink recording the draws it receives. The vertices of every draw are copied into
+     * one buffer, in the local space of the drawn object, and each command keeps the transform,
+     * texture and shader it was drawn with. The buffers keep their capacity when the list is cleared.
+     * Textures and shaders are referenced, not copied: the objects owning them are retained with the
+     * list until it is cleared. Glyph pages and atlases are the exception, as the recording thread
+     * adds glyphs to them while another list may be replayed: the list draws them from copies of its
+     * own, taken again only when TextLayout::GetGlyphRevision says glyphs may have been added.
+     */
+    class DrawCommandList : public RenderSink
+    {
+    public:
+        static constexpr size_t NoDifference = static_cast<size_t>(-1); ///< Returned by FindFirstDifference for identical lists.
+
+        /**
+         * @struct Command
+         * @brief One recorded draw call.
+         */
+        struct Command
+        {
+            sf::PrimitiveType type; ///< The primitive type of the vertices.
+            size_t first; ///< The index of the first vertex in the buffer of the list.
+            size_t count; ///< The number of vertices.
+            sf::RenderStates states; ///< The states to draw the vertices with.
+        };
+
+        /**
+         * @brief Remove every command, release the retained objects and reset the counters, keeping the memory.
+         */
+        void Clear();
+
+        using RenderSink::Draw;
+
+        /**
+         * @brief Record a draw of vertices.
+         *
+         * @param vertices The vertices, copied.
+         * @param count The number of vertices.
+         * @param type The primitive type of the vertices.
+         * @param states The states to draw with.
+         */
+        void Draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states) override;
+
+        /**
+         * @brief Keep an object alive until the list is cleared.
+         *
+         * @param object The object to retain.
+         */
+        void Retain(std::shared_ptr<const void> object) override;
+
+        /**
+         * @brief Get the copy of a glyph page or atlas owned by the list, copying it if glyphs may have been added since.
+         *
+         * @param texture The glyph page or atlas.
+         * @return const sf::Texture* The copy, kept until the list is cleared.
+         */
+        const sf::Texture* GetGlyphTexture(const sf::Texture* texture) override;
+
+        /**
+         * @brief Send every command to another sink, in the recorded order.
+         *
+         * @param sink The sink to replay into, a TargetSink to draw the frame.
+         */
+        void Replay(RenderSink& sink) const;
+
+        /**
+         * @brief Find the first command differing from another list, to compare two frames.
+         *
+         * @details The commands are compared by their type, vertices and states. Textures and shaders
+         * are compared by address, a copied glyph page by the address of the page.
+         *
+         * @param other The list to compare with.
+         * @return size_t The index of the first differing command, NoDifference if the lists are the same.
+         */
+        [[nodiscard]] size_t FindFirstDifference(const DrawCommandList& other) const;
+
+        /**
+         * @brief Get the recorded commands.
+         *
+         * @return const std::vector<Command>& The commands, in drawing order.
+         */
+        [[nodiscard]] const std::vector<Command>& GetCommands() const;
+
+        /**
+         * @brief Get the recorded vertices, indexed by the commands.
+         *
+         * @return const std::vector<sf::Vertex>& The vertices.
+         */
+        [[nodiscard]] const std::vector<sf::Vertex>& GetVertices() const;
+
+    private:
+        /**
+         * @struct GlyphCopy
+         * @brief A copy of a glyph page or atlas, replayed instead of the texture updated by the recording thread.
+         */
+        struct GlyphCopy
+        {
+            const sf::Texture* source = nullptr; ///< The glyph page or atlas copied.
+            uint64_t revision = 0; ///< The glyph revision when it was copied.
+            sf::Texture texture; ///< The copy.
+            bool isCopied = false; ///< Whether the texture holds a copy of the source.
+            bool isUsed = false; ///< Whether a command drew the copy since the last Clear.
+        };
+
+        /**
+         * @brief Get the texture a command was recorded with, the glyph page of a copy.
+         *
+         * @param texture The texture of the command.
+         * @return const sf::Texture* The copied texture, or the texture itself.
+         */
+        [[nodiscard]] const sf::Texture* GetRecordedTexture(const sf::Texture* texture) const;
+
+        std::vector<sf::Vertex> m_vertices; ///< The vertices of every command.
+        std::vector<Command> m_commands; ///< The commands, in drawing order.
+        std::vector<std::shared_ptr<const void>> m_retained; ///< The objects kept alive until Clear.
+        std::vector<std::unique_ptr<GlyphCopy>> m_glyphCopies; ///< The copies drawn since the last Clear or the one before, kept at their address.
+    };
+}
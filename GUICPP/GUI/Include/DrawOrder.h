@@ -0,0 +1,44 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace GUICPP
+{
+    class Widget;
+
+    /**
+     * @struct DrawKey
+     * @brief The position of a widget in the drawing order of a GUI, from the bottom to the top.
+     *
+     * @details Widgets are ordered by layer, then by depth inside a layer. Widgets sharing a layer and
+     * a depth are stacked in levels: a widget is one level above the highest widget added before it
+     * that it overlaps, so the widgets of a level never overlap. Inside a level, they are grouped by
+     * material to draw the widgets using the same texture one after another. Overlapping widgets thus
+     * keep the order they were added in, and only the others are reordered. The sequence, the order
+     * the widgets were added in, keeps the order stable between frames. Hit testing walks the same
+     * order from the top.
+     */
+    struct DrawKey
+    {
+        int layer = 0; ///< The layer of the widget, added to the layers of its groups.
+        int depth = 0; ///< The depth of the widget inside its layer, higher is drawn above.
+        int level = 0; ///< The level of the widget above the widgets it overlaps with the same layer and depth.
+        std::uintptr_t material = 0; ///< The address of the texture the widget draws with, 0 for none.
+        size_t sequence = 0; ///< The index of the widget in the GUI, widget list first then groups.
+
+        auto operator<=>(const DrawKey&) const = default;
+    };
+
+    /**
+     * @struct DrawEntry
+     * @brief A widget of a GUI with its key, in the sorted drawing order.
+     */
+    struct DrawEntry
+    {
+        DrawKey key; ///< The position of the widget in the order.
+        std::shared_ptr<Widget> widget; ///< The widget.
+    };
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace GUICPP
+{
+    /**
+     * @class FontRegistry
+     * @brief Process-wide table of fonts shared by path or family name.
+     *
+     * @details A family is a list of candidate files tried in order, so the same name resolves to
+     * Arial on Windows and to a metric compatible font on Linux or macOS. Fonts are loaded through
+     * the asset cache, so every GUI and widget asking for the same file shares one sf::Font.
+     */
+    class FontRegistry
+    {
+    public:
+        static constexpr const char* DefaultFamily = "Default"; ///< The family of the default font of the GUI.
+
+        /**
+         * @brief Get the process-wide font registry.
+         *
+         * @return FontRegistry& The font registry.
+         */
+        static FontRegistry& GetInstance();
+
+        /**
+         * @brief Register the candidate files of a family, replacing the previous ones.
+         *
+         * @param family The name of the family.
+         * @param paths The paths of the candidate files, the first one found is used.
+         */
+        void RegisterFamily(const std::string& family, std::vector<std::string> paths);
+
+        /**
+         * @brief Get a shared font by family name or by path.
+         *
+         * @param familyOrPath The name of a registered family, or the path of a font file.
+         * @return std::shared_ptr<sf::Font> The shared font, nullptr if no candidate could be loaded.
+         */
+        std::shared_ptr<sf::Font> GetFont(const std::string& familyOrPath);
+
+        /**
+         * @brief Rasterize glyphs ahead of time, so the first draw of a text does not stall on the glyph pages.
+         *
+         * @param font The font to prewarm.
+         * @param characters The characters to rasterize.
+         * @param sizes The character sizes to rasterize them at.
+         * @param bold Whether to rasterize the bold glyphs.
+         */
+        static void Prewarm(const sf::Font& font, const sf::String& characters, const std::vector<unsigned int>& sizes,
+                            bool bold = false);
+
+        /**
+         * @brief Get the printable ASCII characters, a common set to prewarm.
+         *
+         * @return const sf::String& The characters from space to tilde.
+         */
+        static const sf::String& GetBasicLatin();
+
+    private:
+        /**
+         * @brief Construct the registry with the default family.
+         */
+        FontRegistry();
+
+        std::unordered_map<std::string, std::vector<std::string>> m_families; ///< The candidate files by family name.
+    };
+}
@@ -4,7 +4,22 @@
 #include <string>
 #include <SFML/Graphics.hpp>
 
+#include "AssetCache.h"
+#include "AssetPreloader.h"
+#include "DrawCommandList.h"
+#include "RenderSink.h"
+#include "DrawOrder.h"
+#include "FontRegistry.h"
 #include "Group.h"
+#include "HitTestBatch.h"
+#include "InputLog.h"
+#include "MemoryUsage.h"
+#include "Metrics.h"
+#include "OverlapGrid.h"
+#include "Profiler.h"
+#include "RenderThread.h"
+#include "TextBatch.h"
+#include "TextureResidency.h"
 #include "Widgets/BitmapButton.h"
 #include "Widgets/BitmapCheckBox.h"
 #include "Widgets/BitmapSlider.h"
@@ -23,6 +38,11 @@ namespace GUICPP
          */
         GUI(sf::RenderWindow& window);
 
+        /**
+         * @brief Detach the widgets and groups from the GUI, which they may outlive.
+         */
+        ~GUI();
+
         /**
          * @brief Handle incoming SFML events.
          * @param e SFML Event to handle.
@@ -34,12 +54,28 @@ namespace GUICPP
          * @param states The states to draw the GUI onto.
          */
         void Draw(sf::RenderStates& states) const;
+
+        /**
+         * @brief Send the draws of the GUI to a sink instead of the window.
+         * @details The partial redraw is not used, every shown widget is sent. A DrawCommandList records
+         * the frame for a RenderThread or to compare it with another, a NullSink only counts the draws.
+         * The sink retains the widgets and the styles owning the textures they drew with.
+         * @param sink The sink to draw into.
+         * @param states The states to draw the GUI with.
+         */
+        void Record(RenderSink& sink, sf::RenderStates& states) const;
     
         /**
          * @brief Add a widget to the GUI.
          * @param widget The widget to add.
          */
         void AddWidgetToGui(const std::shared_ptr<Widget>& widget);
+
+        /**
+         * @brief Reserve the lists of the GUI for a number of widgets, so adding them and drawing them does not grow the lists.
+         * @param count The number of widgets, in the GUI and in its groups.
+         */
+        void ReserveWidgets(size_t count);
         
         /**
          * @brief Remove a widget from the GUI.
@@ -70,6 +106,136 @@ namespace GUICPP
          * @return The default size as an unsigned integer.
          */
         [[nodiscard]] unsigned int GetDefaultSize() const;
+
+        /**
+         * @brief Get the memory footprint of every widget of the GUI, per widget type.
+         * @return The memory report, including the shared tables referenced by the widgets.
+         */
+        [[nodiscard]] MemoryReport GetMemoryReport() const;
+
+        /**
+         * @brief Get the metrics of the GUI, to export them or to add the metrics of the application.
+         * @return The registry, updated by HandleEvents and by each Draw or Record.
+         */
+        [[nodiscard]] MetricsRegistry& GetMetrics();
+
+        /**
+         * @brief Refresh every widget of the GUI from its style, after the styles of a theme were changed.
+         */
+        void ApplyTheme();
+
+        /**
+         * @brief Get the manager keeping the textures of hidden groups under a memory budget.
+         * @return The texture residency manager, updated after each Draw.
+         */
+        TextureResidency& GetTextureResidency();
+
+        /**
+         * @brief Get the batch the widgets append their labels to, drawn before a widget covering one of them and at the end of Draw.
+         * @return The text batch, for its statistics.
+         */
+        [[nodiscard]] const TextBatch& GetTextBatch() const;
+
+        /**
+         * @brief Draw the buttons using the default font from its SDF atlas, sharp at every size without rasterizing each one.
+         * @param isEnabled Whether to use the SDF atlas, it is built on first use.
+         * @return False if the atlas cannot be drawn on this machine, the bitmap font is kept.
+         */
+        bool SetSdfText(bool isEnabled);
+
+        /**
+         * @brief Skip the widgets and the groups out of the view of the window when drawing and dispatching events.
+         * @param isEnabled Whether to skip them, enabled by default.
+         */
+        void SetCulling(bool isEnabled);
+
+        /**
+         * @brief Get the number of widgets and whole groups skipped by the last Draw or HandleEvents.
+         * @return The number of widgets and groups out of the view, a skipped group counts once.
+         */
+        [[nodiscard]] size_t GetCulledCount() const;
+
+        /**
+         * @brief Set the recorder the handled events are written to, with the pointer position they are hit tested with.
+         * @param recorder The recorder, it must outlive the GUI or be unset, nullptr to stop recording.
+         */
+        void SetInputRecorder(InputRecorder* recorder);
+
+        /**
+         * @brief Set the pointer position the widgets hit test, until the next mouse event.
+         * @details Used by InputReplayer to replay the positions recorded with the events.
+         * @param pixel The position in pixels of the window.
+         */
+        void SetPointerPosition(const sf::Vector2i& pixel);
+
+        /**
+         * @brief Get the pointer position the widgets hit test.
+         * @return The position in pixels of the window, from the last mouse event handled.
+         */
+        [[nodiscard]] sf::Vector2i GetPointerPosition() const;
+
+        /**
+         * @brief Check whether the GUI looks different from what the last Draw showed.
+         * @details True when a widget changed, when widgets were shown, hidden, added or removed, when the view
+         * or the size of the window changed, or when a redraw requested with RequestRedraw is due.
+         * @return True if the GUI should be drawn and presented again.
+         */
+        [[nodiscard]] bool NeedsRedraw() const;
+
+        /**
+         * @brief Ask for a redraw, for changes the GUI cannot see such as an animation or the scene behind it.
+         * @param delay The time from now the redraw is due, the next frame of an animation. Zero by default.
+         */
+        void RequestRedraw(sf::Time delay = sf::Time::Zero);
+
+        /**
+         * @brief Wait for the next event of the window, as long as nothing needs to be drawn.
+         * @details Blocks without using the processor while the GUI is unchanged and no redraw is requested,
+         * and returns without waiting once NeedsRedraw is true. A main loop handles the events while it
+         * returns true, then draws if NeedsRedraw:
+         * @code
+         * while (gui.WaitEvent(event)) { gui.HandleEvents(event); }
+         * if (gui.NeedsRedraw()) { window.clear(); gui.Draw(states); window.display(); }
+         * @endcode
+         * @param event The event filled when one comes.
+         * @return True if an event was filled, false when it is time to draw.
+         */
+        bool WaitEvent(sf::Event& event) const;
+
+        /**
+         * @brief Draw the GUI into a texture kept between frames, redrawing only the areas of the widgets that changed.
+         * @details The texture is drawn over the window by each Draw. It is redrawn whole when the view or the
+         * shown widgets change, or when the changed areas cover too much of the window.
+         * @param isEnabled Whether to redraw partially, disabled by default.
+         * @param fullRedrawRatio The part of the window above which the changed areas are redrawn as a full frame.
+         * @return False if the texture cannot be created, every widget is then drawn each frame.
+         */
+        bool SetPartialRedraw(bool isEnabled, float fullRedrawRatio = 0.5f);
+
+        /**
+         * @brief Get the areas redrawn into the texture by the last Draw, when redrawing partially.
+         * @return The areas in pixels of the window, the whole window after a full redraw.
+         */
+        [[nodiscard]] const std::vector<sf::IntRect>& GetRedrawnAreas() const;
+
+        /**
+         * @brief Get the number of draw calls the widgets and their labels made during the last Draw.
+         * @return The draw calls sent to the window and to the texture of the partial redraw.
+         */
+        [[nodiscard]] size_t GetLastDrawCallCount() const;
+
+        /**
+         * @brief Get the widgets of the GUI in the order they are drawn, from the bottom, see DrawKey.
+         * @return The widgets of the widget list and of the visible groups in the view, as sorted by the last Draw or HandleEvents.
+         */
+        [[nodiscard]] const std::vector<DrawEntry>& GetDrawOrder() const;
+
+        /**
+         * @brief Find the topmost widget under a point, sorting the draw list first if it changed.
+         * @param point The point, in world coordinates.
+         * @return The widget, nullptr if no widget of a visible group contains the point.
+         */
+        [[nodiscard]] Widget* GetWidgetAt(sf::Vector2f point) const;
     private:
         sf::RenderWindow& m_window;
 
@@ -77,37 +243,203 @@ namespace GUICPP
         
         std::vector<std::shared_ptr<Widget>> m_widgetList;
         std::shared_ptr<sf::Font> m_defaultFont;
+        std::shared_ptr<SdfFont> m_sdfAtlas; ///< SDF atlas of the default font, built by the first SetSdfText.
+        std::shared_ptr<SdfFont> m_sdfFont; ///< The atlas while SDF text is enabled, nullptr otherwise.
         unsigned int m_defaultSize;
         std::shared_ptr<Widget> m_isLockBy;
 
         bool m_isShowingHandCursor;
+        sf::Vector2i m_pointer; ///< The pointer position in pixels, from the last mouse event handled.
+        bool m_hasPointer = false; ///< Whether m_pointer was read from the mouse once.
+        InputRecorder* m_inputRecorder = nullptr; ///< The recorder of the handled events, nullptr when not recording.
         sf::Cursor m_arrowCursor;
         sf::Cursor m_handCursor;
+        mutable TextureResidency m_textureResidency; ///< Updated by Draw, which is const for the callers.
+        mutable TextBatch m_textBatch; ///< Filled by the widgets and flushed by Draw.
+        mutable HitTestBatch m_hitTestBatch; ///< Bounds of the widgets of the draw list, packed again by the first query after it changed.
+        mutable bool m_isHitTestBatchDirty = true; ///< Whether the draw list was sorted again since the hit test batch was packed.
+        mutable std::vector<Widget*> m_hitTestWidgets; ///< The widget of each bounds of the hit test batch.
+        mutable std::vector<DrawEntry> m_drawList; ///< The widgets in drawing order, sorted again by Draw and HandleEvents when it changed.
+        mutable bool m_isDrawListDirty = true; ///< Whether a widget, a group or the lists changed since the draw list was sorted.
+        mutable OverlapGrid m_levelGrid; ///< The bounds of the widgets of a layer and depth, to find the level of the next one.
+        mutable OverlapGrid m_orderGrid; ///< The bounds of the widgets below the next one, to find the overlapping ones it was drawn below.
+        bool m_isCulling = true; ///< Whether the widgets and groups out of the view are skipped.
+        mutable sf::FloatRect m_viewBounds; ///< The world rectangle shown when the draw list was sorted.
+        mutable size_t m_culledCount = 0; ///< The widgets and groups skipped when the draw list was sorted.
+        bool m_isPartialRedraw = false; ///< Whether the widgets are drawn into the canvas, only where they changed.
+        float m_fullRedrawRatio = 0.5f; ///< The part of the window above which the canvas is redrawn whole.
+        mutable sf::RenderTexture m_canvas; ///< The widgets as drawn by the last Draw, in premultiplied colours.
+        mutable TargetSink m_windowSink{ m_window }; ///< The sink the widgets draw into the window with.
+        mutable TargetSink m_canvasSink{ m_canvas }; ///< The sink the widgets draw into the canvas with.
+        mutable bool m_isCanvasValid = false; ///< Whether the canvas can be updated instead of redrawn whole.
+        mutable std::vector<sf::IntRect> m_redrawnAreas; ///< The areas of the canvas redrawn by the last Draw.
+        mutable bool m_hasDrawn = false; ///< Whether Draw was called once.
+        mutable sf::View m_drawnView; ///< The view of the window the last Draw used.
+        mutable sf::Vector2u m_drawnSize; ///< The size of the window at the last Draw.
+        mutable std::vector<const Widget*> m_drawnWidgets; ///< The widgets drawn by the last Draw, in drawing order.
+        sf::Clock m_clock; ///< The time the scheduled redraws are compared with.
+        mutable bool m_isRedrawScheduled = false; ///< Whether RequestRedraw asked for a redraw not drawn yet.
+        mutable sf::Time m_redrawTime; ///< The time of the earliest requested redraw.
+        MetricsRegistry m_metrics; ///< The metrics of the GUI.
+        MetricHistogram* m_frameDurationMetric; ///< The time of each Draw or Record, in microseconds.
+        MetricCounter* m_eventsMetric; ///< The events handled.
+        MetricGauge* m_eventRateMetric; ///< The events handled per second.
+        MetricGauge* m_widgetsMetric; ///< The widgets of the GUI and its groups.
+        MetricGauge* m_textureBytesMetric; ///< The memory of the cached textures.
+        MetricGauge* m_soundBytesMetric; ///< The memory of the cached sound buffers.
+        MetricGauge* m_voicesMetric; ///< The voices of the sound pool.
+        MetricGauge* m_activeVoicesMetric; ///< The voices of the sound pool playing.
+        MetricCounter* m_droppedSoundsMetric; ///< The sounds dropped by the sound pool.
+        mutable sf::Time m_metricsTime; ///< The time the sampled metrics were last updated.
+        mutable uint64_t m_metricsEventCount = 0; ///< The events handled when the sampled metrics were last updated.
         
         /**
-         * @brief Handle events from widget list.
-         * @param e SFML Event to handle.
-         * @return True if the event has been handled by any widget.
+         * @brief Add the memory usage of a widget to a report.
+         * @param widget The widget to account.
+         * @param report The report to fill.
          */
-        bool HandleEventsFromWidgetList(const sf::Event& e);
-        
+        static void AccountWidget(const Widget& widget, MemoryReport& report);
+
         /**
-         * @brief Draw widgets from widget list onto provided render states.
-         * @param states The states to draw the widgets onto.
+         * @brief Add the memory usage of a group and its children to a report.
+         * @param group The group to account.
+         * @param report The report to fill.
          */
-        void DrawFromWidgetList(sf::RenderStates& states) const;
+        static void AccountGroup(const Group& group, MemoryReport& report);
 
         /**
-         * @brief Handle events from group list.
-         * @param e SFML Event to handle.
-         * @return True if the event has been handled by any group.
+         * @brief Refresh every widget of a group and its children from its style.
+         * @param group The group to refresh.
          */
-        bool HandleEventsFromGroupList(sf::Event e) const;
-        
+        static void ApplyThemeToGroup(const Group& group);
+
+        /**
+         * @brief Give the SDF font, or none, to the buttons of a group and its children without a styled font.
+         * @param group The group holding the buttons.
+         */
+        void ApplySdfFontToGroup(const Group& group) const;
+
+        /**
+         * @brief Count the widgets of a group and its children.
+         * @param group The group to count.
+         * @return The number of widgets.
+         */
+        static size_t CountGroupWidgets(const Group& group);
+
+        /**
+         * @brief Record the time of a frame, and sample the other metrics once per second.
+         * @param frameDuration The time the frame took.
+         */
+        void UpdateMetrics(sf::Time frameDuration) const;
+
+        /**
+         * @brief Collect the widgets of the widget list and of the visible groups in the view, and sort them by DrawKey.
+         */
+        void SortDrawList() const;
+
+        /**
+         * @brief Sort the draw list again if a widget or a group changed, or the view moved while culling.
+         */
+        void UpdateDrawList() const;
+
+        /**
+         * @brief Set the levels of a run of the draw list, sorted by sequence and sharing a layer and a depth.
+         * @param first The index of the first widget of the run.
+         * @param last The index after the last widget of the run.
+         */
+        void LevelDrawList(size_t first, size_t last) const;
+
+        /**
+         * @brief Append a widget to the draw list, keyed after the widgets already in it.
+         * @param widget The widget to append.
+         * @param layer The layer of the groups holding the widget.
+         */
+        void AddToDrawList(const std::shared_ptr<Widget>& widget, int layer) const;
+
+        /**
+         * @brief Append the widgets of a visible group and of its visible children to the draw list.
+         * @param group The group to append.
+         * @param layer The layer of the parents of the group.
+         */
+        void AddGroupToDrawList(const Group& group, int layer) const;
+
+        /**
+         * @brief Give the widgets of a group and of its child groups the window, batch and pointer of the GUI.
+         * @param group The group added to the GUI.
+         */
+        void AttachGroupWidgets(const Group& group);
+
+        /**
+         * @brief Clear the pointers a widget keeps into the GUI, so it holds none once removed.
+         * @param widget The widget removed from the GUI.
+         */
+        void DetachWidget(Widget& widget) const;
+
+        /**
+         * @brief Detach the widgets of a group and of its child groups from the GUI.
+         * @param group The group removed from the GUI.
+         */
+        void DetachGroupWidgets(const Group& group) const;
+
+        /**
+         * @brief Offer an event to a widget.
+         * @param widget The widget.
+         * @param e The event.
+         * @return Whether the widget handled the event.
+         */
+        bool Dispatch(Widget& widget, const sf::Event& e) const;
+
+        /**
+         * @brief Keep the pointer position carried by a mouse event, read by the widgets to hit test.
+         * @param e The event handled.
+         */
+        void UpdatePointer(const sf::Event& e);
+
+        /**
+         * @brief Update the texture residency, the hit test batch and what the next NeedsRedraw compares with.
+         */
+        void FinishFrame() const;
+
+        /**
+         * @brief Draw the widgets of the draw list, flushing their labels before a widget covering one of them.
+         * @param sink The sink to draw into.
+         * @param states The states to draw the widgets with.
+         * @param area The world area to redraw, nullptr to draw every widget.
+         */
+        void DrawWidgets(RenderSink& sink, sf::RenderStates& states, const sf::FloatRect* area) const;
+
+        /**
+         * @brief Redraw the areas of the canvas where widgets changed, then draw the canvas over the window.
+         * @param states The states to draw the widgets with.
+         */
+        void DrawPartially(sf::RenderStates& states) const;
+
+        /**
+         * @brief Check whether the window or the sorted draw list differ from the last Draw.
+         * @return True if the widgets drawn, their order, the view or the size of the window changed.
+         */
+        [[nodiscard]] bool IsDrawListChanged() const;
+
+        /**
+         * @brief Check whether the canvas must be redrawn whole rather than where the widgets changed.
+         * @details A widget only moving in the draw list, as one changing texture does, is redrawn with its
+         * area. The canvas is stale when widgets were shown or hidden, or when a widget now goes above or
+         * below a widget it overlaps.
+         * @return True if the view, the size of the window or the widgets drawn changed, or overlapping widgets swapped.
+         */
+        [[nodiscard]] bool IsCanvasStale() const;
+
+        /**
+         * @brief Add the pixels of the canvas showing a world rectangle to the areas to redraw.
+         * @param bounds The world rectangle.
+         * @param view The view the canvas is drawn with.
+         * @param canvasArea The area of the whole canvas, the pixels out of it are left out.
+         */
+        void AddRedrawnArea(const sf::FloatRect& bounds, const sf::View& view, const sf::IntRect& canvasArea) const;
+
         /**
-         * @brief Draw groups from group list onto provided render states.
-         * @param states The states to draw the groups onto.
+         * @brief Pack the bounds of the widgets of the draw list into the hit test batch.
          */
-        void DrawFromGroupList(sf::RenderStates& states) const;
+        void PackHitTestBatch() const;
     };
 }
@@ -3,12 +3,14 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
 #include <memory>
 
 namespace GUICPP
 {
     class Widget;
+    class AssetPreloader;
 
     /**
      * @brief This class represents a group of widgets. The group can contain child groups.
@@ -22,6 +24,11 @@ namespace GUICPP
          */
         Group();
 
+        /**
+         * @brief Destructor, detaching the widgets and the children still pointing at this group.
+         */
+        ~Group();
+
         /**
          * @brief Handle SFML events for this group.
          * 
@@ -61,6 +68,8 @@ namespace GUICPP
         /**
          * @brief Set the visibility of this group.
          * 
+         * @details Showing the group loads the deferred resources of its widgets and of its visible children.
+         *
          * @param visibility The visibility state to set.
          */
         void SetGroupVisibility(bool visibility);
@@ -72,6 +81,56 @@ namespace GUICPP
          */
         bool GetGroupVisibility() const;
 
+        /**
+         * @brief Set the layer of this group, added to the layers of its widgets and of its children.
+         *
+         * @param layer The layer of this group, 0 by default.
+         */
+        void SetGroupLayer(int layer);
+
+        /**
+         * @brief Get the layer of this group.
+         *
+         * @return int Returns the layer of this group, without the layers of its parents.
+         */
+        int GetGroupLayer() const;
+
+        /**
+         * @brief Get the world rectangle containing the widgets of this group and of all its children.
+         *
+         * @details The rectangle is cached, and computed again after the group changes or one of its
+         * widgets calls Widget::Invalidate, as their setters do.
+         *
+         * @return sf::FloatRect Returns the bounds of the group, empty if it holds no widget.
+         */
+        sf::FloatRect GetGroupBounds() const;
+
+        /**
+         * @brief Compute the bounds of this group and of its parents again on their next use.
+         */
+        void InvalidateBounds();
+
+        /**
+         * @brief Load the deferred resources of the widgets of this group and of its visible children.
+         */
+        void BindResources();
+
+        /**
+         * @brief Load the deferred resources of this group and of all its children now, even if hidden.
+         *
+         * @details A hint for groups that are about to be shown, to avoid loading while the first frame is drawn.
+         */
+        void PrefetchResources();
+
+        /**
+         * @brief Add the deferred resources of this group and of all its children to a preloader.
+         *
+         * @details The files are then decoded in the background, and binding the widgets later finds them in the cache.
+         *
+         * @param preloader The preloader to add the files to, before it is started.
+         */
+        void PrefetchResources(AssetPreloader& preloader) const;
+
         /**
          * @brief Remove a child group from this group.
          */
@@ -113,14 +172,28 @@ namespace GUICPP
         size_t GetWidgetListSize() const;
 
     private:
+        /**
+         * @brief Make the GUI holding the root of this group sort its draw list again.
+         */
+        void InvalidateDrawOrder() const;
+
         std::vector< std::shared_ptr<Group>> m_child; ///< The child groups of this group.
         std::vector<std::shared_ptr<Widget>> m_widgetList; ///< The list of widgets in this group.
         sf::Vector2f m_relativePosition; ///< The relative position of this group.
         sf::Vector2f m_globalPosition; ///< The global position of this group.
         bool m_isVisible; ///< The visibility state of this group.
+        int m_layer = 0; ///< The layer of this group in the drawing order.
+        Group* m_parent = nullptr; ///< The group this group was added to, nullptr for a root group.
+        bool* m_drawOrderFlag = nullptr; ///< The flag raised to make the GUI holding this root group sort its draw list again.
+        mutable sf::FloatRect m_bounds; ///< The cached bounds of the widgets of this group and of its children.
+        mutable bool m_hasBounds = false; ///< Whether the cached bounds contain at least one widget.
+        mutable bool m_isBoundsDirty = true; ///< Whether the cached bounds must be computed again.
         sf::RenderWindow* m_window = nullptr; ///< The render window to draw this group on.
+        uint64_t m_lastDrawnFrame = 0; ///< The last frame this group was shown, stamped by the texture residency manager.
+        bool m_isEvicted = false; ///< Whether the textures of this group were evicted while it was hidden.
         
         friend class GUI;
+        friend class TextureResidency;
         friend class Widget;
     };
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace GUICPP
+{
+    /**
+     * @class HitMask
+     * @brief Packed 1-bit map of the opaque pixels of a texture, for pixel accurate hit tests.
+     *
+     * @details A pixel is opaque when its alpha reaches the threshold. Each lower resolution level
+     * halves the size, a bit being set if any of the four pixels it covers is, so a miss on a
+     * coarse level is a miss on every finer one. Testing a point reads a single bit.
+     */
+    class HitMask
+    {
+    public:
+        /**
+         * @brief Get the shared mask of a texture, generating it on first use.
+         *
+         * @details The mask is kept as long as the texture is alive.
+         *
+         * @param texture The texture, its pixels are read back once.
+         * @param alphaThreshold The alpha from which a pixel is opaque. Default is 128.
+         * @param levelCount The number of levels, including the full resolution one. Default is 1.
+         * @return std::shared_ptr<const HitMask> The shared mask, nullptr if the texture is nullptr.
+         */
+        static std::shared_ptr<const HitMask> Get(const std::shared_ptr<const sf::Texture>& texture, sf::Uint8 alphaThreshold = 128,
+                                                  unsigned int levelCount = 1);
+
+        /**
+         * @brief Build the mask of an image, use Get to share the mask of a texture.
+         *
+         * @param image The image.
+         * @param alphaThreshold The alpha from which a pixel is opaque. Default is 128.
+         * @param levelCount The number of levels, including the full resolution one. Default is 1.
+         */
+        explicit HitMask(const sf::Image& image, sf::Uint8 alphaThreshold = 128, unsigned int levelCount = 1);
+
+        /**
+         * @brief Test whether a point of the texture is opaque.
+         *
+         * @param point The point, in pixels of the texture.
+         * @param level The level to test, clamped to the coarsest one. Default is the full resolution.
+         * @return true if the point hits an opaque pixel, false if it is transparent or outside the texture.
+         */
+        [[nodiscard]] bool Contains(sf::Vector2f point, unsigned int level = 0) const;
+
+        /**
+         * @brief Get the number of levels.
+         *
+         * @return unsigned int The number of levels, including the full resolution one.
+         */
+        [[nodiscard]] unsigned int GetLevelCount() const;
+
+        /**
+         * @brief Get the size of a level.
+         *
+         * @param level The level. Default is the full resolution.
+         * @return sf::Vector2u The size in bits.
+         */
+        [[nodiscard]] sf::Vector2u GetSize(unsigned int level = 0) const;
+
+        /**
+         * @brief Get the memory used by the levels.
+         *
+         * @return size_t The memory in bytes.
+         */
+        [[nodiscard]] size_t GetMemoryBytes() const;
+
+    private:
+        /**
+         * @struct Level
+         * @brief One resolution of the mask, its rows padded to whole words.
+         */
+        struct Level
+        {
+            unsigned int width = 0; ///< The width in bits.
+            unsigned int height = 0; ///< The height in bits.
+            unsigned int wordsPerRow = 0; ///< The number of words of a row.
+            std::vector<std::uint64_t> bits; ///< The rows, one bit per pixel.
+
+            /**
+             * @brief Construct an empty level.
+             *
+             * @param width The width in bits.
+             * @param height The height in bits.
+             */
+            Level(unsigned int width, unsigned int height);
+
+            /**
+             * @brief Test a bit.
+             *
+             * @param x The column, in range.
+             * @param y The row, in range.
+             * @return true if the bit is set.
+             */
+            [[nodiscard]] bool Test(unsigned int x, unsigned int y) const;
+
+            /**
+             * @brief Set a bit.
+             *
+             * @param x The column, in range.
+             * @param y The row, in range.
+             */
+            void Set(unsigned int x, unsigned int y);
+        };
+
+        std::vector<Level> m_levels; ///< The levels, from the full resolution to the coarsest.
+    };
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace GUICPP
+{
+    /**
+     * @class HitTestBatch
+     * @brief Bounds of many widgets packed for testing a point against all of them at once.
+     *
+     * @details The bounds are stored as separate arrays of left, top, right and bottom edges, so a
+     * single comparison instruction tests 8 rectangles with AVX, or 4 with SSE2. The instruction set
+     * is chosen at compile time, and a scalar loop is used when neither is enabled or when
+     * GUICPP_NO_SIMD is defined. Rectangles are added in drawing order, the last one being on top.
+     */
+    class HitTestBatch
+    {
+    public:
+        static constexpr size_t NoHit = static_cast<size_t>(-1); ///< Returned when no rectangle contains the point.
+
+        /**
+         * @brief Remove every rectangle, keeping the memory.
+         */
+        void Clear();
+
+        /**
+         * @brief Reserve memory for a number of rectangles.
+         *
+         * @param count The number of rectangles.
+         */
+        void Reserve(size_t count);
+
+        /**
+         * @brief Add a rectangle above the previous ones.
+         *
+         * @param bounds The rectangle, in global coordinates.
+         * @return size_t The index of the rectangle.
+         */
+        size_t Add(const sf::FloatRect& bounds);
+
+        /**
+         * @brief Get the number of rectangles.
+         *
+         * @return size_t The number of rectangles.
+         */
+        [[nodiscard]] size_t GetSize() const;
+
+        /**
+         * @brief Find the topmost rectangle containing a point, with the same edges as sf::Rect::contains.
+         *
+         * @param point The point, in global coordinates.
+         * @return size_t The index of the rectangle, NoHit if none contains the point.
+         */
+        [[nodiscard]] size_t FindTopmost(sf::Vector2f point) const;
+
+        /**
+         * @brief Find the topmost rectangle containing a point one rectangle at a time, as a reference.
+         *
+         * @param point The point, in global coordinates.
+         * @return size_t The index of the rectangle, NoHit if none contains the point.
+         */
+        [[nodiscard]] size_t FindTopmostScalar(sf::Vector2f point) const;
+
+        /**
+         * @brief Get the name of the instruction set FindTopmost uses.
+         *
+         * @return const char* "AVX", "SSE2" or "Scalar".
+         */
+        static const char* GetInstructionSet();
+
+    private:
+        std::vector<float> m_left; ///< The left edges, padded to whole blocks with empty rectangles.
+        std::vector<float> m_top; ///< The top edges.
+        std::vector<float> m_right; ///< The right edges.
+        std::vector<float> m_bottom; ///< The bottom edges.
+        size_t m_count = 0; ///< The number of rectangles, without the padding.
+    };
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace GUICPP
+{
+    class GUI;
+
+    /**
+     * @brief An event handled by a GUI, as stored in an input log.
+     */
+    struct InputRecord
+    {
+        sf::Time time; ///< The time of the event since the recording started, to the microsecond.
+        sf::Vector2i pointer; ///< The pointer position the widgets hit tested, in pixels of the window.
+        sf::Event event; ///< The event.
+    };
+
+    /**
+     * @class InputRecorder
+     * @brief Writes the events handled by a GUI to a compact binary log, see GUI::SetInputRecorder.
+     *
+     * @details The log starts with "GCIN", the format version and the size of the window, then one
+     * record per event: the microseconds since the previous record, the event type, the pointer
+     * position and the fields of the event, integers stored as variable length. A mouse move takes
+     * 4 to 8 bytes. Joystick, touch and sensor events are not recorded. The records are buffered
+     * and written by blocks.
+     */
+    class InputRecorder
+    {
+    public:
+        static constexpr uint32_t Version = 1; ///< The version of the format written by the recorder.
+
+        /**
+         * @brief Flush the buffered records and close the log.
+         */
+        ~InputRecorder();
+
+        /**
+         * @brief Start a new log, the time of the records starts from now.
+         *
+         * @param path The path of the log file, replaced if it exists.
+         * @param windowSize The size of the window the events come from, the pointer positions are in its pixels.
+         * @return bool False if the file could not be opened.
+         */
+        bool Open(const std::string& path, const sf::Vector2u& windowSize);
+
+        /**
+         * @brief Flush the buffered records and close the log.
+         */
+        void Close();
+
+        /**
+         * @brief Check whether a log is open.
+         *
+         * @return bool True between Open and Close.
+         */
+        [[nodiscard]] bool IsRecording() const;
+
+        /**
+         * @brief Append an event to the log, called by the GUI before dispatching it.
+         *
+         * @param event The event.
+         * @param pointer The pointer position the widgets hit test the event with.
+         * @return bool False if no log is open or the event type is not recorded.
+         */
+        bool Record(const sf::Event& event, const sf::Vector2i& pointer);
+
+        /**
+         * @brief Write the buffered records to the file.
+         */
+        void Flush();
+
+        /**
+         * @brief Get the number of events recorded since Open.
+         *
+         * @return size_t The number of records.
+         */
+        [[nodiscard]] size_t GetRecordCount() const;
+
+    private:
+        std::ofstream m_file; ///< The log file.
+        std::vector<uint8_t> m_buffer; ///< The records not written yet.
+        sf::Clock m_clock; ///< The time since Open.
+        int64_t m_lastTime = 0; ///< The time of the last record, in microseconds.
+        size_t m_recordCount = 0; ///< The events recorded since Open.
+    };
+
+    /**
+     * @class InputReplayer
+     * @brief Reads an input log and feeds its events back to a GUI.
+     *
+     * @details Before each event, the pointer of the GUI is set to the recorded position, so the
+     * widgets hit test the same points as when the log was recorded. With a window of the size
+     * recorded and the same widgets, a replay leaves the GUI in the same state each time.
+     */
+    class InputReplayer
+    {
+    public:
+        /**
+         * @brief Read a whole log.
+         *
+         * @param path The path of the log file.
+         * @return bool False if the file could not be read or is not an input log of a known version.
+         */
+        bool Open(const std::string& path);
+
+        /**
+         * @brief Read the next record.
+         *
+         * @param record The record read.
+         * @return bool False at the end of the log, or if the rest of it is corrupted.
+         */
+        bool Next(InputRecord& record);
+
+        /**
+         * @brief Go back to the first record.
+         */
+        void Rewind();
+
+        /**
+         * @brief Feed the records up to a time of the recording to a GUI.
+         *
+         * @param gui The GUI handling the events.
+         * @param time The time reached, the records after it stay for the next call.
+         * @return size_t The number of events fed.
+         */
+        size_t ReplayUntil(GUI& gui, sf::Time time);
+
+        /**
+         * @brief Feed every remaining record to a GUI, as fast as it handles them.
+         *
+         * @param gui The GUI handling the events.
+         * @return size_t The number of events fed.
+         */
+        size_t ReplayAll(GUI& gui);
+
+        /**
+         * @brief Check whether every record was read.
+         *
+         * @return bool True at the end of the log.
+         */
+        [[nodiscard]] bool IsFinished() const;
+
+        /**
+         * @brief Get the size of the window the log was recorded with.
+         *
+         * @return sf::Vector2u The size in pixels.
+         */
+        [[nodiscard]] sf::Vector2u GetWindowSize() const;
+
+    private:
+        std::vector<uint8_t> m_data; ///< The whole log.
+        size_t m_start = 0; ///< The offset of the first record.
+        size_t m_offset = 0; ///< The offset of the next record.
+        int64_t m_time = 0; ///< The time of the last record read, in microseconds.
+        sf::Vector2u m_windowSize; ///< The size of the window of the recording.
+        bool m_hasPending = false; ///< Whether m_pending was read but not fed yet.
+        InputRecord m_pending{}; ///< The record read past the time of the last ReplayUntil.
+    };
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace GUICPP
+{
+    /**
+     * @brief Memory footprint of a widget instance or of a group of widgets.
+     *
+     * @details Memory of shared tables (cached textures, sound sets...) is split between the objects
+     * referencing it and reported in sharedBytes, so summing many instances does not count it more than once.
+     */
+    struct MemoryUsage
+    {
+        size_t objectBytes = 0; ///< Size of the object itself (sizeof).
+        size_t heapBytes = 0; ///< Heap memory owned exclusively by the object.
+        size_t gpuBytes = 0; ///< GPU memory owned exclusively by the object.
+        size_t sharedBytes = 0; ///< The share of the object in the memory of the shared tables it references.
+
+        /**
+         * @brief Accumulate another usage into this one.
+         *
+         * @param other The usage to add.
+         * @return MemoryUsage& Reference to this usage.
+         */
+        MemoryUsage& operator+=(const MemoryUsage& other)
+        {
+            objectBytes += other.objectBytes;
+            heapBytes += other.heapBytes;
+            gpuBytes += other.gpuBytes;
+            sharedBytes += other.sharedBytes;
+            return *this;
+        }
+
+        /**
+         * @brief Get the bytes owned by the object, shared tables excluded.
+         *
+         * @return size_t objectBytes + heapBytes + gpuBytes.
+         */
+        [[nodiscard]] size_t GetOwnedBytes() const
+        {
+            return objectBytes + heapBytes + gpuBytes;
+        }
+    };
+
+    /**
+     * @brief Memory usage of every instance of one widget type.
+     */
+    struct MemoryReportEntry
+    {
+        std::string typeName; ///< The name of the widget type.
+        size_t instanceSize = 0; ///< sizeof one instance of the type.
+        size_t instanceCount = 0; ///< The number of live instances.
+        MemoryUsage usage; ///< The summed usage of all instances.
+    };
+
+    /**
+     * @brief Memory usage of a whole GUI, per widget type.
+     */
+    struct MemoryReport
+    {
+        std::vector<MemoryReportEntry> types; ///< One entry per widget type.
+        MemoryUsage total; ///< The summed usage of all widgets.
+        size_t sharedTableBytes = 0; ///< The deduplicated size of the shared tables (asset cache, sound sets).
+    };
+}
@@ -0,0 +1,389 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GUICPP
+{
+    /**
+     * @brief The kinds of metrics, as exported.
+     */
+    enum class MetricType
+    {
+        Counter, ///< A total that only grows.
+        Gauge, ///< A value that goes up and down.
+        Histogram ///< A distribution of values.
+    };
+
+    /**
+     * @class Metric
+     * @brief A named value of a MetricsRegistry, updated by the thread of the GUI and read by an exporter without locks.
+     */
+    class Metric
+    {
+    public:
+        /**
+         * @brief Construct a metric.
+         *
+         * @param name The name of the metric, such as guicpp_events_total.
+         * @param help What the metric measures, one line.
+         */
+        Metric(std::string name, std::string help);
+
+        virtual ~Metric() = default;
+
+        Metric(const Metric&) = delete;
+        Metric& operator=(const Metric&) = delete;
+
+        /**
+         * @brief Get the kind of the metric.
+         *
+         * @return MetricType The kind.
+         */
+        [[nodiscard]] virtual MetricType GetType() const = 0;
+
+        /**
+         * @brief Get the name of the metric.
+         *
+         * @return const std::string& The name.
+         */
+        [[nodiscard]] const std::string& GetName() const;
+
+        /**
+         * @brief Get what the metric measures.
+         *
+         * @return const std::string& The help line.
+         */
+        [[nodiscard]] const std::string& GetHelp() const;
+
+    private:
+        std::string m_name; ///< The name of the metric.
+        std::string m_help; ///< What the metric measures.
+    };
+
+    /**
+     * @class MetricCounter
+     * @brief A total that only grows, such as the events handled.
+     */
+    class MetricCounter : public Metric
+    {
+    public:
+        using Metric::Metric;
+
+        [[nodiscard]] MetricType GetType() const override;
+
+        /**
+         * @brief Add to the total.
+         *
+         * @param value The amount added.
+         */
+        void Add(uint64_t value = 1);
+
+        /**
+         * @brief Set the total, for a total counted elsewhere such as the dropped sounds of the SoundPool.
+         *
+         * @param value The total.
+         */
+        void Set(uint64_t value);
+
+        /**
+         * @brief Get the total.
+         *
+         * @return uint64_t The total.
+         */
+        [[nodiscard]] uint64_t Get() const;
+
+    private:
+        std::atomic<uint64_t> m_value{ 0 }; ///< The total.
+    };
+
+    /**
+     * @class MetricGauge
+     * @brief A value that goes up and down, such as the memory of the textures.
+     */
+    class MetricGauge : public Metric
+    {
+    public:
+        using Metric::Metric;
+
+        [[nodiscard]] MetricType GetType() const override;
+
+        /**
+         * @brief Set the value.
+         *
+         * @param value The value.
+         */
+        void Set(double value);
+
+        /**
+         * @brief Get the value.
+         *
+         * @return double The value.
+         */
+        [[nodiscard]] double Get() const;
+
+    private:
+        std::atomic<double> m_value{ 0.0 }; ///< The value.
+    };
+
+    /**
+     * @class MetricHistogram
+     * @brief A distribution of integer values, such as the frame times in microseconds.
+     *
+     * @details As in an HDR histogram, each power of two is split into 16 buckets, so a quantile is
+     * known within 1/16 of its value, from 0 to the largest 64-bit value, with a fixed set of counters.
+     * The histogram is exported with a bucket per power of two of the recorded values, from 1 to
+     * 2^ExportedPowers, a value equal to a bound counted in the next bucket.
+     */
+    class MetricHistogram : public Metric
+    {
+    public:
+        static constexpr int SubBucketBits = 4; ///< The log2 of the buckets per power of two.
+        static constexpr size_t SubBucketCount = size_t{ 1 } << SubBucketBits; ///< The buckets per power of two.
+        static constexpr size_t BucketCount = SubBucketCount * (64 - SubBucketBits + 1); ///< The buckets of the histogram.
+        static constexpr int ExportedPowers = 24; ///< The exported buckets, 2^24 microseconds is 16 seconds.
+
+        /**
+         * @brief Construct a histogram.
+         *
+         * @param name The name of the metric, its unit included, such as guicpp_frame_duration_seconds.
+         * @param help What the metric measures, one line.
+         * @param unit The exported value of 1, such as 1e-6 for values recorded in microseconds and exported in seconds.
+         */
+        MetricHistogram(std::string name, std::string help, double unit = 1.0);
+
+        [[nodiscard]] MetricType GetType() const override;
+
+        /**
+         * @brief Add a value to the distribution.
+         *
+         * @param value The value, in the recorded unit.
+         */
+        void Record(uint64_t value);
+
+        /**
+         * @brief Get the number of values recorded.
+         *
+         * @return uint64_t The number of values.
+         */
+        [[nodiscard]] uint64_t GetCount() const;
+
+        /**
+         * @brief Get the sum of the values recorded.
+         *
+         * @return uint64_t The sum, in the recorded unit.
+         */
+        [[nodiscard]] uint64_t GetSum() const;
+
+        /**
+         * @brief Get the number of values recorded below a bound.
+         *
+         * @param bound The bound, a power of two or at most 16 for an exact count.
+         * @return uint64_t The number of values smaller than the bound, or of the buckets entirely below it.
+         */
+        [[nodiscard]] uint64_t GetCountBelow(uint64_t bound) const;
+
+        /**
+         * @brief Estimate a quantile of the values recorded.
+         *
+         * @param quantile The quantile, from 0 to 1, such as 0.99.
+         * @return uint64_t The upper bound of the bucket holding the quantile, 0 if nothing was recorded.
+         */
+        [[nodiscard]] uint64_t GetQuantile(double quantile) const;
+
+        /**
+         * @brief Get the exported value of 1.
+         *
+         * @return double The unit.
+         */
+        [[nodiscard]] double GetUnit() const;
+
+    private:
+        /**
+         * @brief Get the bucket of a value.
+         *
+         * @param value The value.
+         * @return size_t The index of the bucket.
+         */
+        static size_t GetBucket(uint64_t value);
+
+        /**
+         * @brief Get the largest value of a bucket.
+         *
+         * @param bucket The index of the bucket.
+         * @return uint64_t The largest value.
+         */
+        static uint64_t GetBucketMax(size_t bucket);
+
+        double m_unit; ///< The exported value of 1.
+        std::array<std::atomic<uint64_t>, BucketCount> m_buckets{}; ///< The values recorded in each bucket.
+        std::atomic<uint64_t> m_count{ 0 }; ///< The number of values.
+        std::atomic<uint64_t> m_sum{ 0 }; ///< The sum of the values.
+    };
+
+    class MetricsRegistry;
+
+    /**
+     * @class MetricsExporter
+     * @brief Publishes the metrics of a registry, called periodically by the export thread of the registry.
+     */
+    class MetricsExporter
+    {
+    public:
+        virtual ~MetricsExporter() = default;
+
+        /**
+         * @brief Publish the current values of the metrics.
+         *
+         * @param registry The registry.
+         * @return bool False if the metrics could not be published.
+         */
+        virtual bool Export(const MetricsRegistry& registry) = 0;
+    };
+
+    /**
+     * @class PrometheusFileExporter
+     * @brief Writes the metrics in the Prometheus text format to a file, for the textfile collector of node_exporter or any agent reading it.
+     *
+     * @details The file is written next to its path and renamed over it, so a reader never sees it half written.
+     */
+    class PrometheusFileExporter : public MetricsExporter
+    {
+    public:
+        /**
+         * @brief Construct an exporter writing a file.
+         *
+         * @param path The path of the file, such as gui.prom.
+         */
+        explicit PrometheusFileExporter(std::string path);
+
+        /**
+         * @brief Write the metrics to the file.
+         *
+         * @param registry The registry.
+         * @return bool False if the file could not be written.
+         */
+        bool Export(const MetricsRegistry& registry) override;
+
+        /**
+         * @brief Format the metrics of a registry in the Prometheus text format.
+         *
+         * @param registry The registry.
+         * @return std::string The metrics, one HELP and TYPE line and the samples per metric.
+         */
+        static std::string Format(const MetricsRegistry& registry);
+
+    private:
+        std::string m_path; ///< The path of the file.
+    };
+
+    /**
+     * @class MetricsRegistry
+     * @brief The metrics of a GUI, and the thread exporting them.
+     *
+     * @details Adding a metric takes a lock, updating one does not: the GUI updates its metrics on its
+     * thread as it handles the events and draws, and the export thread reads them at its own pace,
+     * so a slow exporter never holds the GUI up. The metrics live as long as the registry.
+     */
+    class MetricsRegistry
+    {
+    public:
+        MetricsRegistry() = default;
+
+        /**
+         * @brief Stop the export thread.
+         */
+        ~MetricsRegistry();
+
+        MetricsRegistry(const MetricsRegistry&) = delete;
+        MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+        /**
+         * @brief Add a counter.
+         *
+         * @param name The name of the counter, ending with _total.
+         * @param help What the counter measures.
+         * @return MetricCounter& The counter.
+         */
+        MetricCounter& AddCounter(const std::string& name, const std::string& help);
+
+        /**
+         * @brief Add a gauge.
+         *
+         * @param name The name of the gauge.
+         * @param help What the gauge measures.
+         * @return MetricGauge& The gauge.
+         */
+        MetricGauge& AddGauge(const std::string& name, const std::string& help);
+
+        /**
+         * @brief Add a histogram.
+         *
+         * @param name The name of the histogram.
+         * @param help What the histogram measures.
+         * @param unit The exported value of 1.
+         * @return MetricHistogram& The histogram.
+         */
+        MetricHistogram& AddHistogram(const std::string& name, const std::string& help, double unit = 1.0);
+
+        /**
+         * @brief Find a metric by name.
+         *
+         * @param name The name of the metric.
+         * @return const Metric* The metric, nullptr if there is none of that name.
+         */
+        [[nodiscard]] const Metric* Find(const std::string& name) const;
+
+        /**
+         * @brief Get the metrics, in the order they were added.
+         *
+         * @return std::vector<const Metric*> The metrics.
+         */
+        [[nodiscard]] std::vector<const Metric*> GetMetrics() const;
+
+        /**
+         * @brief Start exporting the metrics periodically from a thread of the registry, stopping the previous export.
+         *
+         * @param exporter The exporter.
+         * @param interval The time between two exports.
+         */
+        void StartExport(std::unique_ptr<MetricsExporter> exporter, std::chrono::milliseconds interval = std::chrono::seconds(10));
+
+        /**
+         * @brief Export once more and stop the export thread.
+         */
+        void StopExport();
+
+    private:
+        /**
+         * @brief Add a metric.
+         *
+         * @param metric The metric.
+         * @return Metric& The metric added.
+         */
+        Metric& Add(std::unique_ptr<Metric> metric);
+
+        /**
+         * @brief Export every interval until the export stops.
+         *
+         * @param stopToken The token stopping the export.
+         */
+        void Run(std::stop_token stopToken);
+
+        mutable std::mutex m_mutex; ///< Guards the metric list.
+        std::vector<std::unique_ptr<Metric>> m_metrics; ///< The metrics.
+        std::unique_ptr<MetricsExporter> m_exporter; ///< The exporter, nullptr when not exporting.
+        std::chrono::milliseconds m_interval{ 0 }; ///< The time between two exports.
+        std::condition_variable_any m_wakeUp; ///< Wakes the export thread up when the export stops.
+        std::mutex m_wakeUpMutex; ///< The mutex of m_wakeUp.
+        std::jthread m_exportThread; ///< The export thread.
+    };
+}
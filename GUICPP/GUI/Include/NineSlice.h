@@ -0,0 +1,160 @@
+#pragma once
+
+#include <array>
+#include <SFML/Graphics.hpp>
+
+namespace GUICPP
+{
+    class HitMask;
+
+    /**
+     * @brief The borders of a texture kept unstretched by a nine-slice, in texture pixels.
+     */
+    struct NineSliceBorders
+    {
+        float left = 0.f; ///< The width of the left column.
+        float top = 0.f; ///< The height of the top row.
+        float right = 0.f; ///< The width of the right column.
+        float bottom = 0.f; ///< The height of the bottom row.
+
+        /**
+         * @brief Compare two borders.
+         *
+         * @param other The borders to compare to.
+         * @return bool Returns true if every border is equal.
+         */
+        bool operator==(const NineSliceBorders& other) const = default;
+    };
+
+    /**
+     * @class NineSlice
+     * @brief Sprite drawn at any size by stretching only the middle of its texture.
+     *
+     * @details The corners keep their size, the edges stretch along one axis and the centre along
+     * both, so one small texture serves every widget size. The nine quads are built as a single
+     * block of vertices drawn in one call, like a sprite. Without borders the whole texture is
+     * stretched, as a scaled sprite.
+     */
+    class NineSlice : public sf::Drawable, public sf::Transformable
+    {
+    public:
+        static constexpr size_t VertexCount = 9 * 6; ///< Two triangles per slice.
+
+        /**
+         * @brief Construct an untextured nine-slice of size zero.
+         */
+        NineSlice();
+
+        /**
+         * @brief Set the texture, the size is kept.
+         *
+         * @param texture The texture, nullptr to draw nothing.
+         */
+        void SetTexture(const sf::Texture* texture);
+
+        /**
+         * @brief Set the borders kept unstretched.
+         *
+         * @param borders The borders, in texture pixels.
+         */
+        void SetBorders(const NineSliceBorders& borders);
+
+        /**
+         * @brief Set the size the texture is drawn at, before the transform.
+         *
+         * @param size The size in pixels.
+         */
+        void SetSize(const sf::Vector2f& size);
+
+        /**
+         * @brief Set the colour the texture is modulated with.
+         *
+         * @param color The colour.
+         */
+        void SetColor(const sf::Color& color);
+
+        /**
+         * @brief Get the texture.
+         *
+         * @return const sf::Texture* The texture, nullptr if none is set.
+         */
+        [[nodiscard]] const sf::Texture* GetTexture() const;
+
+        /**
+         * @brief Get the size the texture is drawn at, before the transform.
+         *
+         * @return const sf::Vector2f& The size in pixels.
+         */
+        [[nodiscard]] const sf::Vector2f& GetSize() const;
+
+        /**
+         * @brief Get the colour the texture is modulated with.
+         *
+         * @return const sf::Color& The colour.
+         */
+        [[nodiscard]] const sf::Color& GetColor() const;
+
+        /**
+         * @brief Get the bounds before the transform.
+         *
+         * @return sf::FloatRect The bounds, from the origin to the size.
+         */
+        [[nodiscard]] sf::FloatRect GetLocalBounds() const;
+
+        /**
+         * @brief Get the bounds after the transform.
+         *
+         * @return sf::FloatRect The bounds.
+         */
+        [[nodiscard]] sf::FloatRect GetGlobalBounds() const;
+
+        /**
+         * @brief Map a point of the nine-slice, before the transform, to the texture pixel drawn there.
+         *
+         * @param point The point, in local coordinates.
+         * @return sf::Vector2f The point in pixels of the texture.
+         */
+        [[nodiscard]] sf::Vector2f MapToTexture(sf::Vector2f point) const;
+
+        /**
+         * @brief Test whether a point hits the nine-slice.
+         *
+         * @param point The point, in global coordinates.
+         * @param mask The hit mask of the texture, nullptr to test the bounds only.
+         * @return true if the point is inside the nine-slice, on an opaque pixel if a mask is given.
+         */
+        [[nodiscard]] bool Contains(sf::Vector2f point, const HitMask* mask = nullptr) const;
+
+        /**
+         * @brief Get the block of vertices, before the transform.
+         *
+         * @return const std::array<sf::Vertex, VertexCount>& The vertices of the nine quads.
+         */
+        [[nodiscard]] const std::array<sf::Vertex, VertexCount>& GetVertices() const;
+
+    protected:
+        /**
+         * @brief Draw the nine quads in one call.
+         *
+         * @param target The target to draw onto.
+         * @param states The states to draw with.
+         */
+        void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    private:
+        const sf::Texture* m_texture = nullptr; ///< The texture, nullptr to draw nothing.
+        NineSliceBorders m_borders; ///< The borders kept unstretched.
+        sf::Vector2f m_size; ///< The size the texture is drawn at.
+        sf::Color m_color = sf::Color::White; ///< The colour the texture is modulated with.
+        std::array<sf::Vertex, VertexCount> m_vertices; ///< The vertices of the nine quads.
+        std::array<float, 4> m_columns{}; ///< The local edges of the three columns.
+        std::array<float, 4> m_rows{}; ///< The local edges of the three rows.
+        std::array<float, 4> m_textureColumns{}; ///< The texture edges of the three columns.
+        std::array<float, 4> m_textureRows{}; ///< The texture edges of the three rows.
+
+        /**
+         * @brief Rebuild the positions and texture coordinates of the quads.
+         */
+        void UpdateGeometry();
+    };
+}
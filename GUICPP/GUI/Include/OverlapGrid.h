@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace GUICPP
+{
+    /**
+     * @class OverlapGrid
+     * @brief Rectangles bucketed by the cells of a uniform grid, to find those overlapping another one without testing them all.
+     *
+     * @details A rectangle is stored in every cell it covers, the cells being hashed to a fixed number
+     * of buckets. A rectangle covering too many cells is kept in a list tested by every query. The
+     * storage keeps its memory when cleared, so once warmed up, filling and querying allocate nothing.
+     * Rectangles overlap as for sf::Rect::intersects, sharing an edge is not overlapping.
+     */
+    class OverlapGrid
+    {
+    public:
+        /**
+         * @brief Construct an empty grid.
+         *
+         * @param cellSize The width and height of a cell, about the size of the rectangles added.
+         */
+        explicit OverlapGrid(float cellSize = 64.f);
+
+        /**
+         * @brief Remove every rectangle, keeping the memory.
+         */
+        void Clear();
+
+        /**
+         * @brief Set the size of the cells, the grid must be empty.
+         *
+         * @param cellSize The width and height of a cell, about the size of the rectangles added.
+         */
+        void SetCellSize(float cellSize);
+
+        /**
+         * @brief Add a rectangle.
+         *
+         * @param rect The rectangle.
+         * @param value The value given back by the queries overlapping the rectangle.
+         */
+        void Add(const sf::FloatRect& rect, size_t value);
+
+        /**
+         * @brief Check whether the grid holds no rectangle.
+         *
+         * @return bool Returns true if no rectangle was added since the last Clear.
+         */
+        [[nodiscard]] bool IsEmpty() const;
+
+        /**
+         * @brief Check whether a rectangle overlaps one of the grid.
+         *
+         * @param rect The rectangle.
+         * @return bool Returns true if a rectangle of the grid overlaps it.
+         */
+        [[nodiscard]] bool Overlaps(const sf::FloatRect& rect) const;
+
+        /**
+         * @brief Visit the values of the rectangles overlapping a rectangle.
+         *
+         * @details A value may be visited more than once, once per cell its rectangle shares with the query.
+         *
+         * @param rect The rectangle.
+         * @param visit The function called with each value, returning false to stop the query.
+         */
+        template <typename Visit>
+        void ForEachOverlap(const sf::FloatRect& rect, const Visit& visit) const;
+
+    private:
+        static constexpr size_t BucketCount = 1024; ///< The number of buckets the cells are hashed to, a power of two.
+        static constexpr int64_t MaxCellsPerRect = 64; ///< The cells above which a rectangle is kept in the large list.
+        static constexpr uint32_t NoNode = UINT32_MAX; ///< The end of a list of nodes.
+
+        /**
+         * @struct Node
+         * @brief A rectangle stored in a bucket or in the large list.
+         */
+        struct Node
+        {
+            sf::FloatRect rect; ///< The rectangle.
+            size_t value; ///< The value of the rectangle.
+            uint32_t next; ///< The next node of the list, NoNode for the last one.
+        };
+
+        /**
+         * @struct CellRange
+         * @brief The cells covered by a rectangle.
+         */
+        struct CellRange
+        {
+            int64_t left, top, right, bottom; ///< The first and last columns and rows, included.
+
+            [[nodiscard]] int64_t GetCount() const { return (right - left + 1) * (bottom - top + 1); }
+        };
+
+        /**
+         * @brief Get the cells covered by a rectangle.
+         *
+         * @param rect The rectangle.
+         * @return CellRange The cells.
+         */
+        [[nodiscard]] CellRange GetCells(const sf::FloatRect& rect) const;
+
+        /**
+         * @brief Get the bucket of a cell.
+         *
+         * @param column The column of the cell.
+         * @param row The row of the cell.
+         * @return size_t The index of the bucket.
+         */
+        static size_t GetBucket(int64_t column, int64_t row);
+
+        float m_cellSize; ///< The width and height of a cell.
+        std::array<uint32_t, BucketCount> m_buckets; ///< The first node of each bucket.
+        uint32_t m_large = NoNode; ///< The first node of the rectangles covering too many cells.
+        std::vector<Node> m_nodes; ///< Every node, kept with its capacity.
+    };
+
+    template <typename Visit>
+    void OverlapGrid::ForEachOverlap(const sf::FloatRect& rect, const Visit& visit) const
+    {
+        if (m_nodes.empty())
+            return;
+
+        const auto visitList = [&](uint32_t node) {
+            for (; node != NoNode; node = m_nodes[node].next)
+            {
+                if (m_nodes[node].rect.intersects(rect) && !visit(m_nodes[node].value))
+                    return false;
+            }
+            return true;
+        };
+
+        // a query covering more cells than there are nodes tests every node once
+        const CellRange cells = GetCells(rect);
+        if (cells.GetCount() > MaxCellsPerRect)
+        {
+            for (const Node& node : m_nodes)
+            {
+                if (node.rect.intersects(rect) && !visit(node.value))
+                    return;
+            }
+            return;
+        }
+
+        if (!visitList(m_large))
+            return;
+        for (int64_t row = cells.top; row <= cells.bottom; ++row)
+        {
+            for (int64_t column = cells.left; column <= cells.right; ++column)
+            {
+                if (!visitList(m_buckets[GetBucket(column, row)]))
+                    return;
+            }
+        }
+    }
+}
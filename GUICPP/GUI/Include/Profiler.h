@@ -0,0 +1,199 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The instrumentation of the GUI and of the widgets is compiled only when GUICPP_PROFILE is defined,
+ * the macros below expand to nothing otherwise.
+ */
+#ifdef GUICPP_PROFILE
+#define GUICPP_PROFILE_CONCAT_INNER(a, b) a##b
+#define GUICPP_PROFILE_CONCAT(a, b) GUICPP_PROFILE_CONCAT_INNER(a, b)
+/** Time the rest of the scope as a section of a widget. */
+#define GUICPP_PROFILE_WIDGET(widget, section) \
+    const GUICPP::ProfileScope GUICPP_PROFILE_CONCAT(guicppProfileScope, __LINE__)(widget, GUICPP::ProfileSection::section)
+/** Time the rest of the scope as a section of the GUI. */
+#define GUICPP_PROFILE_GUI(section) \
+    const GUICPP::ProfileScope GUICPP_PROFILE_CONCAT(guicppProfileScope, __LINE__)(nullptr, GUICPP::ProfileSection::section)
+/** Count an event dispatched by the GUI. */
+#define GUICPP_PROFILE_EVENT() GUICPP::Profiler::GetInstance().CountEvent()
+/** Count a widget offered an event. */
+#define GUICPP_PROFILE_VISIT() GUICPP::Profiler::GetInstance().CountVisit()
+/** End the frame with the draw calls and texture switches it issued. */
+#define GUICPP_PROFILE_END_FRAME(drawCalls, textureSwitches) GUICPP::Profiler::GetInstance().EndFrame(drawCalls, textureSwitches)
+#else
+#define GUICPP_PROFILE_WIDGET(widget, section) static_cast<void>(0)
+#define GUICPP_PROFILE_GUI(section) static_cast<void>(0)
+#define GUICPP_PROFILE_EVENT() static_cast<void>(0)
+#define GUICPP_PROFILE_VISIT() static_cast<void>(0)
+#define GUICPP_PROFILE_END_FRAME(drawCalls, textureSwitches) static_cast<void>(0)
+#endif
+
+namespace GUICPP
+{
+    class Widget;
+
+    /**
+     * @brief The parts of the work of a frame timed by the profiler.
+     */
+    enum class ProfileSection
+    {
+        HandleEvents, ///< Handling an event, the delegates it calls included.
+        Draw, ///< Drawing, or recording the draws.
+        Delegate, ///< Running the delegate of a widget.
+        Count ///< The number of sections.
+    };
+
+    /**
+     * @brief The time a widget took during a frame.
+     */
+    struct WidgetProfile
+    {
+        const Widget* widget = nullptr; ///< The widget, only to identify it, it may be gone.
+        const char* typeName = ""; ///< The type of the widget.
+        std::array<std::chrono::nanoseconds, static_cast<size_t>(ProfileSection::Count)> times{}; ///< The time spent in each section.
+        std::array<size_t, static_cast<size_t>(ProfileSection::Count)> calls{}; ///< The number of times each section ran.
+    };
+
+    /**
+     * @brief What the GUI did during a frame: the events handled since the previous frame, then the draw.
+     */
+    struct FrameProfile
+    {
+        size_t frame = 0; ///< The number of the frame, from 1.
+        size_t eventCount = 0; ///< The events dispatched by the GUI.
+        size_t widgetsVisited = 0; ///< The widgets offered an event, widgetsVisited / eventCount per event.
+        size_t drawCalls = 0; ///< The draw calls issued.
+        size_t textureSwitches = 0; ///< The draw calls binding another texture than the previous one.
+        std::array<std::chrono::nanoseconds, static_cast<size_t>(ProfileSection::Count)> times{}; ///< The time the GUI spent in each section.
+        std::vector<WidgetProfile> widgets; ///< The widgets that ran, in the order they first ran.
+    };
+
+    /**
+     * @class Profiler
+     * @brief Collects where the GUI spends its time, frame by frame, when built with GUICPP_PROFILE.
+     *
+     * @details The GUI and the widgets time their work with the GUICPP_PROFILE_ macros, which are
+     * compiled out without GUICPP_PROFILE: the profiler then stays empty. The frame being measured
+     * is completed by each GUI::Draw or GUI::Record and becomes the last frame. The profiler is meant
+     * for the thread running the GUI.
+     */
+    class Profiler
+    {
+    public:
+        /**
+         * @brief Get the profiler shared by every GUI.
+         *
+         * @return Profiler& The profiler.
+         */
+        static Profiler& GetInstance();
+
+        /**
+         * @brief Check whether the instrumentation is compiled in.
+         *
+         * @return bool True when built with GUICPP_PROFILE.
+         */
+        static constexpr bool IsEnabled()
+        {
+#ifdef GUICPP_PROFILE
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Add the time of a section to the frame being measured.
+         *
+         * @param widget The widget that ran it, nullptr for the GUI itself.
+         * @param section The section.
+         * @param time The time it took.
+         */
+        void AddTime(const Widget* widget, ProfileSection section, std::chrono::nanoseconds time);
+
+        /**
+         * @brief Count an event dispatched by the GUI.
+         */
+        void CountEvent();
+
+        /**
+         * @brief Count a widget offered an event.
+         */
+        void CountVisit();
+
+        /**
+         * @brief Complete the frame being measured, which becomes the last frame.
+         *
+         * @param drawCalls The draw calls the frame issued.
+         * @param textureSwitches The texture switches of the frame.
+         */
+        void EndFrame(size_t drawCalls, size_t textureSwitches);
+
+        /**
+         * @brief Get the last completed frame.
+         *
+         * @return const FrameProfile& The frame, empty before the first one.
+         */
+        [[nodiscard]] const FrameProfile& GetLastFrame() const;
+
+        /**
+         * @brief Get the widgets of the last frame sorted from the slowest, their sections added up.
+         *
+         * @param count The number of widgets wanted.
+         * @return std::vector<WidgetProfile> The slowest widgets.
+         */
+        [[nodiscard]] std::vector<WidgetProfile> GetSlowestWidgets(size_t count) const;
+
+        /**
+         * @brief Forget the frames measured so far.
+         */
+        void Reset();
+
+    private:
+        Profiler() = default;
+
+        FrameProfile m_frame; ///< The frame being measured.
+        FrameProfile m_lastFrame; ///< The last completed frame.
+        std::unordered_map<const Widget*, size_t> m_widgetIndices; ///< The index of each widget of m_frame in its widget list.
+    };
+
+    /**
+     * @class ProfileScope
+     * @brief Times a section until the end of its scope, declared by the GUICPP_PROFILE_ macros.
+     */
+    class ProfileScope
+    {
+    public:
+        /**
+         * @brief Start timing a section.
+         *
+         * @param widget The widget running the section, nullptr for the GUI.
+         * @param section The section.
+         */
+        ProfileScope(const Widget* widget, ProfileSection section)
+            : m_widget(widget), m_section(section), m_start(std::chrono::steady_clock::now())
+        {
+        }
+
+        /**
+         * @brief Add the time of the section to the profiler.
+         */
+        ~ProfileScope()
+        {
+            Profiler::GetInstance().AddTime(m_widget, m_section,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start));
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const Widget* m_widget; ///< The widget running the section, nullptr for the GUI.
+        ProfileSection m_section; ///< The section timed.
+        std::chrono::steady_clock::time_point m_start; ///< The start of the section.
+    };
+}
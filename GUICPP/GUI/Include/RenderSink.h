@@ -0,0 +1,182 @@
+#pragma once
+
+#include <memory>
+#include <SFML/Graphics.hpp>
+
+namespace GUICPP
+{
+    class NineSlice;
+    class TextLayout;
+
+    /**
+     * @class RenderSink
+     * @brief Receives the draws of the widgets, to draw them onto a target, record them or only count them.
+     *
+     * @details Every draw ends as vertices drawn with render states: shapes, nine-slices and laid out
+     * texts are turned into vertices the way SFML draws them, so every sink sees the same geometry.
+     * The sinks count the draw calls, vertices and texture switches they receive until ResetCounters.
+     */
+    class RenderSink
+    {
+    public:
+        virtual ~RenderSink() = default;
+
+        /**
+         * @brief Draw vertices.
+         *
+         * @param vertices The vertices.
+         * @param count The number of vertices.
+         * @param type The primitive type of the vertices.
+         * @param states The states to draw with.
+         */
+        virtual void Draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states) = 0;
+
+        /**
+         * @brief Draw a shape, its filling then its outline.
+         *
+         * @param shape The shape.
+         * @param states The states to draw with, combined with the transform of the shape.
+         */
+        virtual void Draw(const sf::Shape& shape, const sf::RenderStates& states);
+
+        /**
+         * @brief Draw a nine-slice, nothing if it has no texture.
+         *
+         * @param slice The nine-slice.
+         * @param states The states to draw with, combined with the transform and texture of the slice.
+         */
+        virtual void Draw(const NineSlice& slice, const sf::RenderStates& states);
+
+        /**
+         * @brief Draw a laid out text.
+         *
+         * @param layout The layout.
+         * @param states The states to draw with, the texture and shader of the layout are used.
+         */
+        virtual void Draw(const TextLayout& layout, const sf::RenderStates& states);
+
+        /**
+         * @brief Keep an object alive as long as the sink uses what it drew, nothing by default.
+         *
+         * @param object The object to retain, such as a widget owning a drawn texture.
+         */
+        virtual void Retain(std::shared_ptr<const void> object);
+
+        /**
+         * @brief Get the texture to draw glyphs with, for a glyph page or atlas the drawing thread adds glyphs to.
+         *
+         * @param texture The glyph page or atlas.
+         * @return const sf::Texture* The texture itself by default, a copy a recording can replay on another thread.
+         */
+        virtual const sf::Texture* GetGlyphTexture(const sf::Texture* texture);
+
+        /**
+         * @brief Get the number of draw calls received since the last ResetCounters.
+         *
+         * @return size_t The number of draw calls.
+         */
+        [[nodiscard]] size_t GetDrawCallCount() const;
+
+        /**
+         * @brief Get the number of vertices received since the last ResetCounters.
+         *
+         * @return size_t The number of vertices.
+         */
+        [[nodiscard]] size_t GetVertexCount() const;
+
+        /**
+         * @brief Get the number of times the texture changed from one draw call to the next since the last ResetCounters.
+         *
+         * @return size_t The number of texture switches, the first textured draw call included.
+         */
+        [[nodiscard]] size_t GetTextureSwitchCount() const;
+
+        /**
+         * @brief Set the draw call, vertex and texture switch counters back to zero.
+         */
+        void ResetCounters();
+
+    protected:
+        /**
+         * @brief Count a draw call.
+         *
+         * @param vertexCount The number of vertices it draws.
+         * @param texture The texture it draws with, nullptr for none.
+         */
+        void CountDraw(size_t vertexCount, const sf::Texture* texture);
+
+    private:
+        size_t m_drawCallCount = 0; ///< The draw calls received since the last ResetCounters.
+        size_t m_vertexCount = 0; ///< The vertices received since the last ResetCounters.
+        size_t m_textureSwitchCount = 0; ///< The texture changes since the last ResetCounters.
+        const sf::Texture* m_lastTexture = nullptr; ///< The texture of the last draw call.
+    };
+
+    /**
+     * @class TargetSink
+     * @brief Draws onto an SFML target, the window or a render texture.
+     */
+    class TargetSink : public RenderSink
+    {
+    public:
+        /**
+         * @brief Construct a sink drawing onto a target.
+         *
+         * @param target The target, it must outlive the sink.
+         */
+        explicit TargetSink(sf::RenderTarget& target);
+
+        using RenderSink::Draw;
+
+        /**
+         * @brief Draw vertices onto the target.
+         *
+         * @param vertices The vertices.
+         * @param count The number of vertices.
+         * @param type The primitive type of the vertices.
+         * @param states The states to draw with.
+         */
+        void Draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states) override;
+
+        /**
+         * @brief Draw a shape onto the target, with the vertices cached by the shape.
+         *
+         * @param shape The shape.
+         * @param states The states to draw with.
+         */
+        void Draw(const sf::Shape& shape, const sf::RenderStates& states) override;
+
+        /**
+         * @brief Get the target drawn onto.
+         *
+         * @return sf::RenderTarget& The target.
+         */
+        [[nodiscard]] sf::RenderTarget& GetTarget() const;
+
+    private:
+        sf::RenderTarget& m_target; ///< The target drawn onto.
+    };
+
+    /**
+     * @class NullSink
+     * @brief Counts the draws without drawing them, to measure the GUI without a window or a context.
+     *
+     * @details The shapes and slices are still turned into vertices, so the work left out is only the
+     * one of the graphics driver.
+     */
+    class NullSink : public RenderSink
+    {
+    public:
+        using RenderSink::Draw;
+
+        /**
+         * @brief Count the draw call and drop the vertices.
+         *
+         * @param vertices The vertices.
+         * @param count The number of vertices.
+         * @param type The primitive type of the vertices.
+         * @param states The states to draw with.
+         */
+        void Draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states) override;
+    };
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <SFML/Graphics.hpp>
+
+#include "DrawCommandList.h"
+
+namespace GUICPP
+{
+    /**
+     * @class RenderThread
+     * @brief Replays the recorded frames onto a window from its own thread, while the next frame is recorded.
+     *
+     * @details The thread owns the OpenGL context of the window for its whole life. Two command lists
+     * are swapped by Submit: the calling thread records into one, usually with GUI::Record, while the
+     * thread clears the window, replays the other and displays it. Events are still polled by the
+     * thread that created the window. The glyph pages the recording thread adds glyphs to are
+     * replayed from copies owned by the lists, so only the frames laying out new texts copy them.
+     */
+    class RenderThread
+    {
+    public:
+        /**
+         * @brief Take the context of the window and start the thread.
+         *
+         * @param window The window to draw onto, it must outlive the render thread.
+         */
+        explicit RenderThread(sf::RenderWindow& window);
+
+        /**
+         * @brief Replay the last submitted frame, stop the thread and give the context back to the calling thread.
+         */
+        ~RenderThread();
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        /**
+         * @brief Set the color the window is cleared with before each frame.
+         *
+         * @param color The clear color.
+         */
+        void SetClearColor(const sf::Color& color);
+
+        /**
+         * @brief Get the list to record the next frame into, empty after each Submit.
+         *
+         * @return DrawCommandList& The list owned by the calling thread until the next Submit.
+         */
+        DrawCommandList& GetRecordList();
+
+        /**
+         * @brief Hand the recorded list to the thread and take the other one back.
+         *
+         * @details Blocks only while the thread is still replaying the previous frame.
+         */
+        void Submit();
+
+        /**
+         * @brief Get the number of frames displayed by the thread.
+         *
+         * @return size_t The number of frames.
+         */
+        [[nodiscard]] size_t GetFrameCount() const;
+
+    private:
+        sf::RenderWindow& m_window; ///< The window the frames are drawn onto.
+        TargetSink m_windowSink; ///< The sink drawing the replayed lists onto the window.
+        std::array<DrawCommandList, 2> m_lists; ///< The list being recorded and the list being replayed.
+        size_t m_recordIndex = 0; ///< The index of the list being recorded.
+        sf::Color m_clearColor = sf::Color::Black; ///< The color the window is cleared with, guarded by m_mutex.
+        bool m_hasFrame = false; ///< Whether a submitted list waits for or is in its replay.
+        bool m_isStopping = false; ///< Whether the thread must end after its current frame.
+        size_t m_frameCount = 0; ///< The number of frames displayed, guarded by m_mutex.
+        mutable std::mutex m_mutex; ///< Guards the swap of the lists and the flags.
+        std::condition_variable m_condition; ///< Signaled when a frame is submitted or replayed.
+        std::jthread m_thread; ///< The render thread, started last.
+
+        /**
+         * @brief Replay the submitted lists until the thread is stopped, run by the render thread.
+         */
+        void Run();
+    };
+}
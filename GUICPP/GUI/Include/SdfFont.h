@@ -0,0 +1,127 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <SFML/Graphics.hpp>
+
+namespace GUICPP
+{
+    /**
+     * @class SdfFont
+     * @brief Signed distance field atlas of a font, drawing its glyphs sharply at any character size.
+     *
+     * @details Each glyph is rasterized once at a base size, and its distance to the outline is
+     * stored in a fixed size atlas, added on first use. A fragment shader thresholds the distance
+     * at draw time, so every character size shares the atlas and zooming rasterizes nothing. The
+     * shader only needs GLSL 1.10, which Mesa software rendering supports.
+     */
+    class SdfFont
+    {
+    public:
+        /**
+         * @brief Build the atlas of a font, with the printable ASCII characters.
+         *
+         * @param font The font of the glyphs.
+         * @param baseSize The character size the glyphs are rasterized at. Default is 32.
+         * @param spread The distance in pixels of the base size covered by the field around the outline. Default is 4.
+         * @param atlasSize The width and height of the atlas in pixels. Default is 512.
+         * @param bold Whether to use the bold glyphs. Default is false.
+         */
+        explicit SdfFont(std::shared_ptr<const sf::Font> font, unsigned int baseSize = 32, unsigned int spread = 4,
+                         unsigned int atlasSize = 512, bool bold = false);
+
+        /**
+         * @brief Destroy the atlas, and the text layouts cached for it.
+         */
+        ~SdfFont();
+
+        /**
+         * @brief Check whether the atlas can be drawn, which requires shader support.
+         *
+         * @return true if the shader was compiled, false if texts must be drawn from the bitmap font.
+         */
+        [[nodiscard]] bool IsAvailable() const;
+
+        /**
+         * @brief Add the glyphs of characters to the atlas, those already in it are skipped.
+         *
+         * @param characters The characters to add.
+         */
+        void AddGlyphs(const sf::String& characters);
+
+        /**
+         * @brief Get a glyph at the base size, adding it to the atlas on first use.
+         *
+         * @details The bounds include the spread, and the texture rectangle is in the atlas. A glyph
+         * that did not fit in the atlas keeps its advance but has empty rectangles.
+         *
+         * @param character The character of the glyph.
+         * @return const sf::Glyph& The glyph.
+         */
+        const sf::Glyph& GetGlyph(sf::Uint32 character);
+
+        /**
+         * @brief Get the font the glyphs come from.
+         *
+         * @return const sf::Font& The font.
+         */
+        [[nodiscard]] const sf::Font& GetFont() const;
+
+        /**
+         * @brief Get the character size the glyphs are rasterized at.
+         *
+         * @return unsigned int The base size in pixels.
+         */
+        [[nodiscard]] unsigned int GetBaseSize() const;
+
+        /**
+         * @brief Check whether the atlas holds the bold glyphs.
+         *
+         * @return true if the glyphs are bold.
+         */
+        [[nodiscard]] bool IsBold() const;
+
+        /**
+         * @brief Get the atlas texture.
+         *
+         * @return const sf::Texture& The atlas, white with the distance field in the alpha channel.
+         */
+        [[nodiscard]] const sf::Texture& GetTexture() const;
+
+        /**
+         * @brief Get the shader drawing the atlas.
+         *
+         * @return const sf::Shader* The shader, nullptr if the atlas is not available.
+         */
+        [[nodiscard]] const sf::Shader* GetShader() const;
+
+        /**
+         * @brief Get the memory used by the atlas, which does not grow with the glyphs or sizes drawn.
+         *
+         * @return size_t The memory in bytes.
+         */
+        [[nodiscard]] size_t GetMemoryBytes() const;
+
+    private:
+        std::shared_ptr<const sf::Font> m_font; ///< The font of the glyphs.
+        unsigned int m_baseSize; ///< The character size the glyphs are rasterized at.
+        unsigned int m_spread; ///< The distance covered by the field around the outline.
+        bool m_isBold; ///< Whether the glyphs are bold.
+        sf::Texture m_texture; ///< The atlas.
+        sf::Shader m_shader; ///< Thresholds the distance field.
+        bool m_isAvailable = false; ///< Whether the shader was compiled.
+        std::unordered_map<sf::Uint32, sf::Glyph> m_glyphs; ///< The glyphs added to the atlas.
+        sf::Vector2u m_cursor; ///< Where the next glyph is placed in the current row of the atlas.
+        unsigned int m_rowHeight = 0; ///< The height of the current row of the atlas.
+        bool m_isFull = false; ///< Whether a glyph did not fit in the atlas.
+
+        /**
+         * @brief Reserve a rectangle of the atlas, rows are filled from left to right.
+         *
+         * @param size The size of the rectangle.
+         * @param position The position of the reserved rectangle.
+         * @return true if the rectangle fits, false if the atlas is full.
+         */
+        bool Allocate(sf::Vector2u size, sf::Vector2u& position);
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <SFML/Audio.hpp>
+
+namespace GUICPP
+{
+    /**
+     * @brief The widget events a sound can be attached to.
+     *
+     * @details CheckBox plays Press when it becomes checked and Release when it becomes unchecked.
+     */
+    enum class SoundEvent
+    {
+        Press, ///< The widget is clicked.
+        Release, ///< The widget is released.
+        StartHover, ///< The mouse starts hovering the widget.
+        EndHover, ///< The mouse stops hovering the widget.
+        Count ///< The number of sound events.
+    };
+
+    /**
+     * @brief Immutable table of the sound buffers played by a widget.
+     *
+     * @details Sound sets are interned: widgets configured with the same buffers reference the same set.
+     */
+    struct SoundSet
+    {
+        std::array<std::shared_ptr<sf::SoundBuffer>, static_cast<size_t>(SoundEvent::Count)> buffers; ///< The buffer of each event.
+
+        /**
+         * @brief Get the buffer played for an event.
+         *
+         * @param event The sound event.
+         * @return const sf::SoundBuffer* The buffer, nullptr if the event has no sound.
+         */
+        [[nodiscard]] const sf::SoundBuffer* Get(SoundEvent event) const
+        {
+            return buffers[static_cast<size_t>(event)].get();
+        }
+
+        /**
+         * @brief Get the interned set made of a base set with some buffers replaced.
+         *
+         * @param base The set to start from, may be nullptr.
+         * @param press The Press buffer, nullptr to keep the base one.
+         * @param release The Release buffer, nullptr to keep the base one.
+         * @param startHover The StartHover buffer, nullptr to keep the base one.
+         * @param endHover The EndHover buffer, nullptr to keep the base one.
+         * @return std::shared_ptr<const SoundSet> The interned set.
+         */
+        static std::shared_ptr<const SoundSet> Merge(const std::shared_ptr<const SoundSet>& base,
+                                                     const std::shared_ptr<sf::SoundBuffer>& press,
+                                                     const std::shared_ptr<sf::SoundBuffer>& release,
+                                                     const std::shared_ptr<sf::SoundBuffer>& startHover,
+                                                     const std::shared_ptr<sf::SoundBuffer>& endHover);
+    };
+
+    /**
+     * @class SoundPool
+     * @brief Fixed pool of voices shared by every widget.
+     *
+     * @details A sf::Sound holds an audio source, which is a scarce resource, so widgets don't own one:
+     * they borrow a free voice from the pool. When every voice is busy the request is dropped.
+     * Each play returns a handle, so a widget stops the voice it started and not the same buffer
+     * played by another widget.
+     */
+    class SoundPool
+    {
+    public:
+        using Handle = uint64_t; ///< Identifies one play of a buffer on a voice.
+        static constexpr Handle NoVoice = 0; ///< The handle of a sound that was not played.
+
+        /**
+         * @brief Get the process-wide sound pool.
+         *
+         * @return SoundPool& The sound pool.
+         */
+        static SoundPool& GetInstance();
+
+        /**
+         * @brief Play a buffer on a free voice.
+         *
+         * @param buffer The buffer to play, nothing is played if nullptr.
+         * @return Handle The handle of the play, NoVoice if nothing was played.
+         */
+        Handle Play(const sf::SoundBuffer* buffer);
+
+        /**
+         * @brief Stop the voice of a play if it is still playing it.
+         *
+         * @param handle The handle returned by Play.
+         * @return bool Returns true if the voice was stopped.
+         */
+        bool Stop(Handle handle);
+
+        /**
+         * @brief Set the number of voices of the pool. Playing voices are stopped.
+         *
+         * @param count The number of voices.
+         */
+        void SetVoiceCount(size_t count);
+
+        /**
+         * @brief Get the number of voices of the pool.
+         *
+         * @return size_t The number of voices.
+         */
+        [[nodiscard]] size_t GetVoiceCount() const;
+
+        /**
+         * @brief Get the number of voices currently playing.
+         *
+         * @return size_t The number of playing voices.
+         */
+        [[nodiscard]] size_t GetActiveVoiceCount() const;
+
+        /**
+         * @brief Get the number of sounds dropped because every voice was busy.
+         *
+         * @return size_t The number of dropped sounds.
+         */
+        [[nodiscard]] size_t GetDroppedCount() const;
+
+    private:
+        SoundPool();
+
+        std::vector<sf::Sound> m_voices; ///< The voices of the pool.
+        std::vector<Handle> m_voiceHandles; ///< The handle of the last play of each voice.
+        Handle m_lastHandle = NoVoice; ///< The handle given to the last play.
+        size_t m_nextVoice = 0; ///< The voice to try first on the next play.
+        size_t m_droppedCount = 0; ///< The number of dropped sounds.
+    };
+}
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <SFML/Graphics.hpp>
+
+#include "NineSlice.h"
+#include "SoundPool.h"
+
+namespace GUICPP
+{
+    /**
+     * @brief The parts of a widget a style colours or textures.
+     *
+     * @details Body is the button, the checkbox background or the slider bar. Accent is the button
+     * label, the checkbox mark or the slider cursor.
+     */
+    enum class StylePart
+    {
+        Body, ///< The main shape of the widget.
+        Accent, ///< The secondary shape of the widget.
+        Count ///< The number of parts.
+    };
+
+    /**
+     * @brief The interaction states a style provides colours and textures for.
+     */
+    enum class StyleState
+    {
+        Default, ///< The widget is idle.
+        Hover, ///< The mouse is over the widget.
+        Pressed, ///< The widget is being clicked.
+        Checked, ///< The widget is checked and idle.
+        CheckedHover, ///< The widget is checked and the mouse is over it.
+        Count ///< The number of states.
+    };
+
+    /**
+     * @class Style
+     * @brief Immutable look of a widget, shared by every widget using it.
+     *
+     * @details The colour of every part in every state is computed once when the style is created.
+     * Styles are interned: creating a style equal to a live one returns the live one.
+     */
+    class Style
+    {
+    public:
+        static constexpr size_t PartCount = static_cast<size_t>(StylePart::Count); ///< The number of parts.
+        static constexpr size_t StateCount = static_cast<size_t>(StyleState::Count); ///< The number of states.
+
+        /**
+         * @brief The description a style is built from.
+         */
+        struct Desc
+        {
+            sf::Color bodyColor = sf::Color::White; ///< The colour of the body in the default state.
+            sf::Color accentColor = sf::Color::Black; ///< The colour of the accent in the default state.
+            float hoverShade = 0.75f; ///< The factor applied to the colours in the hover states.
+            float pressedShade = 0.75f; ///< The factor applied to the colours in the pressed state.
+            std::array<std::array<std::shared_ptr<const sf::Texture>, StateCount>, PartCount> textures; ///< The texture of each part in each state, may be nullptr.
+            std::array<NineSliceBorders, PartCount> borders; ///< The borders of the textures of each part kept unstretched, none to stretch them whole.
+            const sf::Font* font = nullptr; ///< The font of the labels, nullptr to keep the GUI default font.
+            std::shared_ptr<const SoundSet> sounds; ///< The sounds played by widgets that have none of their own.
+
+            /**
+             * @brief Compare two descriptions.
+             *
+             * @param other The description to compare to.
+             * @return bool Returns true if both describe the same style.
+             */
+            bool operator==(const Desc& other) const;
+        };
+
+        /**
+         * @brief Get the interned style matching a description.
+         *
+         * @param desc The description of the style.
+         * @return std::shared_ptr<const Style> The shared style.
+         */
+        static std::shared_ptr<const Style> Create(const Desc& desc);
+
+        /**
+         * @brief Get the description the style was built from.
+         *
+         * @return const Desc& The description.
+         */
+        [[nodiscard]] const Desc& GetDesc() const;
+
+        /**
+         * @brief Get the precomputed colour of a part in a state.
+         *
+         * @param part The part of the widget.
+         * @param state The interaction state.
+         * @return const sf::Color& The colour.
+         */
+        [[nodiscard]] const sf::Color& GetColor(StylePart part, StyleState state) const;
+
+        /**
+         * @brief Get the texture of a part in a state.
+         *
+         * @param part The part of the widget.
+         * @param state The interaction state.
+         * @return const sf::Texture* The texture, nullptr if the part has no texture in this state.
+         */
+        [[nodiscard]] const sf::Texture* GetTexture(StylePart part, StyleState state) const;
+
+        /**
+         * @brief Get the borders of the textures of a part kept unstretched when drawn at any size.
+         *
+         * @param part The part of the widget.
+         * @return const NineSliceBorders& The borders, in texture pixels.
+         */
+        [[nodiscard]] const NineSliceBorders& GetBorders(StylePart part) const;
+
+        /**
+         * @brief Get the font of the labels.
+         *
+         * @return const sf::Font* The font, nullptr to keep the GUI default font.
+         */
+        [[nodiscard]] const sf::Font* GetFont() const;
+
+        /**
+         * @brief Get the sounds played by widgets that have none of their own.
+         *
+         * @return const SoundSet* The sounds, may be nullptr.
+         */
+        [[nodiscard]] const SoundSet* GetSounds() const;
+
+        /**
+         * @brief Get the memory used by the style, including its share of the textures it references.
+         *
+         * @return size_t The memory in bytes.
+         */
+        [[nodiscard]] size_t GetMemoryBytes() const;
+
+        /**
+         * @brief Construct a style, use Create to get an interned one.
+         *
+         * @param desc The description of the style.
+         */
+        explicit Style(const Desc& desc);
+
+    private:
+        /**
+         * @struct Key
+         * @brief A description without ownership, to find the interned style equal to it.
+         *
+         * @details The key of an expired style must not keep its textures and sounds alive. Their
+         * addresses cannot be reused while a live style owns them, so a live entry is never matched
+         * by another texture allocated at the same address.
+         */
+        struct Key
+        {
+            sf::Uint32 bodyColor; ///< The colour of the body, as an integer.
+            sf::Uint32 accentColor; ///< The colour of the accent, as an integer.
+            float hoverShade; ///< The factor applied to the colours in the hover states.
+            float pressedShade; ///< The factor applied to the colours in the pressed state.
+            std::array<std::array<const sf::Texture*, StateCount>, PartCount> textures; ///< The texture of each part in each state.
+            std::array<NineSliceBorders, PartCount> borders; ///< The borders of the textures of each part.
+            const sf::Font* font; ///< The font of the labels.
+            const SoundSet* sounds; ///< The sounds of the style.
+
+            /**
+             * @brief Build the key of a description.
+             *
+             * @param desc The description.
+             */
+            explicit Key(const Desc& desc);
+
+            bool operator==(const Key& other) const;
+        };
+
+        /**
+         * @brief Hash of a key, to find the interned style equal to it.
+         */
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const;
+        };
+
+        Desc m_desc; ///< The description the style was built from.
+        std::array<std::array<sf::Color, StateCount>, PartCount> m_palette; ///< The colour of each part in each state.
+    };
+
+    /**
+     * @struct StyleOverrides
+     * @brief The colours and textures a widget sets for itself, laid over the style of its slot.
+     *
+     * @details Keeping them out of the slot lets the widget follow its theme for everything it does
+     * not set itself. Widgets with the same overrides over the same style share the resulting style.
+     */
+    struct StyleOverrides
+    {
+        std::optional<sf::Color> bodyColor; ///< The colour of the body, none to keep the style one.
+        std::optional<sf::Color> accentColor; ///< The colour of the accent, none to keep the style one.
+        std::array<std::array<std::shared_ptr<const sf::Texture>, Style::StateCount>, Style::PartCount> textures; ///< The texture of each part in each state, nullptr to keep the style one.
+
+        /**
+         * @brief Check whether nothing is overridden.
+         *
+         * @return bool Returns true if the style is used as is.
+         */
+        [[nodiscard]] bool IsEmpty() const;
+
+        /**
+         * @brief Replace the overridden values of a description.
+         *
+         * @param desc The description of the style of the slot.
+         */
+        void ApplyTo(Style::Desc& desc) const;
+
+        /**
+         * @brief Compare two sets of overrides.
+         *
+         * @param other The overrides to compare to.
+         * @return bool Returns true if both override the same values.
+         */
+        bool operator==(const StyleOverrides& other) const = default;
+    };
+
+    /**
+     * @class StyleSlot
+     * @brief Shared reference to a style that widgets follow.
+     *
+     * @details Every widget bound to a slot picks up a new style as soon as the slot is pointed at it,
+     * so re-theming thousands of widgets is a single pointer swap followed by GUI::ApplyTheme.
+     */
+    class StyleSlot
+    {
+    public:
+        /**
+         * @brief Construct a slot pointing at a style.
+         *
+         * @param style The style of the slot.
+         */
+        explicit StyleSlot(std::shared_ptr<const Style> style);
+
+        /**
+         * @brief Get the interned slot always pointing at a style, used by widgets with their own look.
+         *
+         * @param style The style of the slot.
+         * @return std::shared_ptr<StyleSlot> The shared slot.
+         */
+        static std::shared_ptr<StyleSlot> For(const std::shared_ptr<const Style>& style);
+
+        /**
+         * @brief Get the style of the slot.
+         *
+         * @return const Style& The style.
+         */
+        [[nodiscard]] const Style& Get() const;
+
+        /**
+         * @brief Get the shared style of the slot.
+         *
+         * @return const std::shared_ptr<const Style>& The shared style.
+         */
+        [[nodiscard]] const std::shared_ptr<const Style>& GetShared() const;
+
+        /**
+         * @brief Point the slot at another style.
+         *
+         * @param style The new style.
+         */
+        void Set(std::shared_ptr<const Style> style);
+
+    private:
+        std::shared_ptr<const Style> m_style; ///< The style of the slot.
+    };
+
+    /**
+     * @class Theme
+     * @brief Set of style slots, one per widget type.
+     */
+    class Theme
+    {
+    public:
+        /**
+         * @brief Construct an empty theme.
+         */
+        Theme() = default;
+
+        /**
+         * @brief Get the process-wide theme widgets are bound to when they are created.
+         *
+         * @return Theme& The default theme.
+         */
+        static Theme& GetDefault();
+
+        /**
+         * @brief Get the slot of a widget type, creating it with a default style if needed.
+         *
+         * @param typeName The name of the widget type (see Widget::GetTypeName).
+         * @return std::shared_ptr<StyleSlot> The slot.
+         */
+        std::shared_ptr<StyleSlot> GetSlot(const std::string& typeName);
+
+        /**
+         * @brief Set the style of a widget type.
+         *
+         * @param typeName The name of the widget type.
+         * @param style The new style.
+         */
+        void SetStyle(const std::string& typeName, std::shared_ptr<const Style> style);
+
+        /**
+         * @brief Point every slot of this theme at the style of the same type in another theme.
+         *
+         * @param other The theme to copy the styles from.
+         */
+        void Apply(const Theme& other);
+
+    private:
+        std::unordered_map<std::string, std::shared_ptr<StyleSlot>> m_slots; ///< The slots by widget type.
+    };
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "OverlapGrid.h"
+#include "RenderSink.h"
+#include "TextLayout.h"
+
+namespace GUICPP
+{
+    /**
+     * @class TextBatch
+     * @brief Collects laid out texts during a frame and draws them with one draw call per glyph page.
+     *
+     * @details Each added layout is transformed on the CPU and appended to the vertex buffer of its
+     * glyph page. The buffers keep their capacity between frames, so once the labels of a GUI have
+     * been seen, a frame allocates nothing. The batch is flushed before a widget covering one of its
+     * texts is drawn, so a label never shows above a widget drawn after it.
+     */
+    class TextBatch
+    {
+    public:
+        /**
+         * @brief Append a layout to the batch.
+         *
+         * @param layout The layout to append.
+         * @param transform The transform placing the layout, combined with the one of the draw states.
+         */
+        void Add(const TextLayout& layout, const sf::Transform& transform);
+
+        /**
+         * @brief Check whether a rectangle covers a text waiting to be drawn.
+         *
+         * @param bounds The rectangle, in the coordinates of the transforms given to Add.
+         * @return bool Returns true if the batch must be flushed before drawing over the rectangle.
+         */
+        [[nodiscard]] bool Overlaps(const sf::FloatRect& bounds) const;
+
+        /**
+         * @brief Draw every appended layout and empty the batch.
+         *
+         * @param sink The sink to draw into.
+         * @param states The states to draw with, the transform, texture and shader are replaced.
+         */
+        void Flush(RenderSink& sink, sf::RenderStates states);
+
+        /**
+         * @brief Get the number of vertices waiting to be drawn.
+         *
+         * @return size_t The number of vertices.
+         */
+        [[nodiscard]] size_t GetVertexCount() const;
+
+        /**
+         * @brief Get the number of draw calls made by the last Flush.
+         *
+         * @return size_t The number of draw calls.
+         */
+        [[nodiscard]] size_t GetLastDrawCallCount() const;
+
+    private:
+        /**
+         * @struct Page
+         * @brief The vertices textured by one glyph page.
+         */
+        struct Page
+        {
+            const sf::Texture* texture; ///< The glyph page or SDF atlas.
+            const sf::Shader* shader; ///< The SDF shader, nullptr for a glyph page.
+            std::vector<sf::Vertex> vertices; ///< The transformed vertices, in drawing order.
+        };
+
+        std::vector<Page> m_pages; ///< The pages seen so far, kept with their capacity.
+        OverlapGrid m_textBounds; ///< The bounds of the texts waiting to be drawn.
+        size_t m_lastDrawCallCount = 0; ///< The number of draw calls made by the last Flush.
+    };
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <SFML/Graphics.hpp>
+
+#include "SdfFont.h"
+
+namespace GUICPP
+{
+    /**
+     * @class TextLayout
+     * @brief Immutable laid out vertices of a string, shared by every text showing it.
+     *
+     * @details The glyphs are looked up and positioned once per string, font, character size, colour
+     * and sf::Text style, the same way sf::Text does without outline. The most recently used layouts
+     * are kept in a cache, so texts showing a common string, or switching back to it, share one
+     * layout. Texts drawing a layout only move, rotate or scale it through a transform, so they
+     * never touch the font again. The cache holds the fonts weakly: once a font is released its
+     * layouts are never returned again, even to a new font allocated at the same address.
+     */
+    class TextLayout
+    {
+    public:
+        /**
+         * @brief Get the shared layout of a string, laying it out if it is not in the cache.
+         *
+         * @param string The string to lay out.
+         * @param font The font of the glyphs, its cached layouts are dropped once every pointer to it is released.
+         * @param characterSize The character size in pixels.
+         * @param color The colour of the glyphs.
+         * @param style The sf::Text::Style flags of the glyphs.
+         * @return std::shared_ptr<const TextLayout> The shared layout.
+         */
+        static std::shared_ptr<const TextLayout> Get(const sf::String& string, const std::shared_ptr<const sf::Font>& font,
+                                                     unsigned int characterSize, const sf::Color& color, sf::Uint32 style = sf::Text::Regular);
+
+        /**
+         * @brief Get the shared layout of a string drawn from an SDF atlas, laying it out if it is not in the cache.
+         *
+         * @param string The string to lay out, its missing glyphs are added to the atlas.
+         * @param font The SDF atlas of the glyphs, its cached layouts are dropped when it is destroyed.
+         * @param characterSize The character size in pixels.
+         * @param color The colour of the glyphs.
+         * @param style The sf::Text::Style flags of the glyphs, boldness comes from the atlas.
+         * @return std::shared_ptr<const TextLayout> The shared layout.
+         */
+        static std::shared_ptr<const TextLayout> Get(const sf::String& string, const std::shared_ptr<SdfFont>& font,
+                                                     unsigned int characterSize, const sf::Color& color, sf::Uint32 style = sf::Text::Regular);
+
+        /**
+         * @brief Drop the cached layouts of an atlas, called when the atlas is destroyed.
+         *
+         * @param font The SDF atlas.
+         */
+        static void ForgetFont(const SdfFont& font);
+
+        /**
+         * @brief Set how many layouts the cache keeps, the least recently used ones are dropped first.
+         *
+         * @details A dropped layout stays alive as long as a text draws it. Default is 1024.
+         *
+         * @param capacity The number of layouts to keep.
+         */
+        static void SetCacheCapacity(size_t capacity);
+
+        /**
+         * @brief Get the number of layouts kept by the cache.
+         *
+         * @return size_t The number of layouts.
+         */
+        static size_t GetCacheSize();
+
+        /**
+         * @brief Get the revision of the glyph pages and atlases, raised whenever glyphs may have been added to them.
+         *
+         * @details Every layout laid out raises it, as does FontRegistry::Prewarm. A copy of a glyph page
+         * taken at an older revision may miss glyphs.
+         *
+         * @return uint64_t The revision.
+         */
+        static uint64_t GetGlyphRevision();
+
+        /**
+         * @brief Raise the revision of the glyph pages and atlases, after adding glyphs to a font outside a layout.
+         */
+        static void ReviseGlyphs();
+
+        /**
+         * @brief Lay out a string, use Get to share the layout.
+         *
+         * @param string The string to lay out.
+         * @param font The font of the glyphs.
+         * @param characterSize The character size in pixels.
+         * @param color The colour of the glyphs.
+         * @param style The sf::Text::Style flags of the glyphs.
+         */
+        TextLayout(const sf::String& string, const sf::Font& font, unsigned int characterSize, const sf::Color& color,
+                   sf::Uint32 style = sf::Text::Regular);
+
+        /**
+         * @brief Lay out a string from an SDF atlas, use Get to share the layout.
+         *
+         * @param string The string to lay out, its missing glyphs are added to the atlas.
+         * @param font The SDF atlas of the glyphs.
+         * @param characterSize The character size in pixels.
+         * @param color The colour of the glyphs.
+         * @param style The sf::Text::Style flags of the glyphs, boldness comes from the atlas.
+         */
+        TextLayout(const sf::String& string, SdfFont& font, unsigned int characterSize, const sf::Color& color,
+                   sf::Uint32 style = sf::Text::Regular);
+
+        /**
+         * @brief Draw the layout with the glyph page of its font.
+         *
+         * @param target The target to draw onto.
+         * @param states The states to draw with, the texture and shader are replaced by the ones of the glyphs.
+         */
+        void Draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+        /**
+         * @brief Get the vertices of the layout, two triangles per glyph.
+         *
+         * @return const sf::VertexArray& The vertices, in the local coordinates of the text.
+         */
+        [[nodiscard]] const sf::VertexArray& GetVertices() const;
+
+        /**
+         * @brief Get the glyph page or atlas the vertices are textured with.
+         *
+         * @return const sf::Texture& The glyph page of the font at the character size, or the SDF atlas.
+         */
+        [[nodiscard]] const sf::Texture& GetTexture() const;
+
+        /**
+         * @brief Get the shader the vertices are drawn with.
+         *
+         * @return const sf::Shader* The SDF shader, nullptr for a bitmap font.
+         */
+        [[nodiscard]] const sf::Shader* GetShader() const;
+
+        /**
+         * @brief Get the local bounds of the layout, as sf::Text::getLocalBounds.
+         *
+         * @return const sf::FloatRect& The bounds.
+         */
+        [[nodiscard]] const sf::FloatRect& GetBounds() const;
+
+        /**
+         * @brief Get the memory used by the vertices of the layout.
+         *
+         * @return size_t The memory in bytes.
+         */
+        [[nodiscard]] size_t GetMemoryBytes() const;
+
+    private:
+        const sf::Texture* m_texture; ///< The glyph page or atlas of the glyphs.
+        const sf::Shader* m_shader = nullptr; ///< The SDF shader, nullptr for a bitmap font.
+        sf::VertexArray m_vertices; ///< The vertices of the glyphs.
+        sf::FloatRect m_bounds; ///< The local bounds of the glyphs.
+    };
+}
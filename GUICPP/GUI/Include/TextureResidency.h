@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace GUICPP
+{
+    class Group;
+
+    /**
+     * @brief The counters of a texture residency manager.
+     */
+    struct ResidencyStats
+    {
+        size_t budgetBytes = 0; ///< The texture memory budget in bytes, 0 if unlimited.
+        size_t residentBytes = 0; ///< The GPU memory used by the live cached textures after the last update.
+        size_t evictionCount = 0; ///< The number of times a hidden group released its textures.
+        size_t reloadCount = 0; ///< The number of times an evicted group was shown and loaded its textures again.
+    };
+
+    /**
+     * @class TextureResidency
+     * @brief Keeps the texture memory of the GUI under a budget by evicting the textures of hidden groups.
+     *
+     * @details Once per frame the groups being drawn are stamped with the frame number. While the
+     * cached textures exceed the budget, the hidden group drawn the longest time ago unbinds its
+     * widgets. A texture is freed once no widget references it anymore, so textures shared with
+     * visible widgets stay resident. Showing an evicted group binds its widgets again, which
+     * reloads the textures from the asset cache or the mounted packs.
+     */
+    class TextureResidency
+    {
+    public:
+        /**
+         * @brief Construct a residency manager without budget.
+         */
+        TextureResidency();
+
+        /**
+         * @brief Set the texture memory budget.
+         *
+         * @param bytes The budget in bytes, 0 to never evict.
+         */
+        void SetBudget(size_t bytes);
+
+        /**
+         * @brief Get the texture memory budget.
+         *
+         * @return size_t The budget in bytes, 0 if unlimited.
+         */
+        [[nodiscard]] size_t GetBudget() const;
+
+        /**
+         * @brief Stamp the drawn groups and evict hidden ones until the textures fit the budget.
+         *
+         * @param groups The top level groups of the GUI.
+         */
+        void Update(const std::vector<std::shared_ptr<Group>>& groups);
+
+        /**
+         * @brief Get the counters of the manager.
+         *
+         * @return ResidencyStats The counters.
+         */
+        [[nodiscard]] ResidencyStats GetStats() const;
+
+    private:
+        /**
+         * @brief Stamp a group and its children, and collect the hidden ones holding textures.
+         *
+         * @param group The group to visit.
+         * @param isShown Whether the parents of the group are visible.
+         * @param candidates The hidden groups that can be evicted.
+         */
+        void Visit(Group& group, bool isShown, std::vector<Group*>& candidates);
+
+        uint64_t m_frame; ///< The number of updates so far.
+        size_t m_budget; ///< The texture memory budget in bytes, 0 if unlimited.
+        size_t m_residentBytes; ///< The texture memory after the last update.
+        size_t m_evictionCount; ///< The number of evictions.
+        size_t m_reloadCount; ///< The number of reloads.
+        std::vector<Group*> m_candidates; ///< The hidden groups of the last update, kept with its capacity.
+    };
+}
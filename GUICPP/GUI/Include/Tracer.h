@@ -0,0 +1,303 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AllocationTracker.h"
+
+/**
+ * The trace spans are compiled in unless GUICPP_NO_TRACE is defined, and cost an atomic load
+ * while no trace is being written.
+ */
+#ifndef GUICPP_NO_TRACE
+#define GUICPP_TRACE_CONCAT_INNER(a, b) a##b
+#define GUICPP_TRACE_CONCAT(a, b) GUICPP_TRACE_CONCAT_INNER(a, b)
+/** Trace the rest of the scope as a span, the category and name must outlive the trace. */
+#define GUICPP_TRACE_SCOPE(category, name) \
+    const GUICPP::TraceScope GUICPP_TRACE_CONCAT(guicppTraceScope, __LINE__)(category, name)
+/** Trace the rest of the scope as a span with a detail string, copied and cut to its last TraceEvent::DetailSize - 1 bytes. */
+#define GUICPP_TRACE_SCOPE_DETAIL(category, name, detail) \
+    const GUICPP::TraceScope GUICPP_TRACE_CONCAT(guicppTraceScope, __LINE__)(category, name, detail)
+#else
+#define GUICPP_TRACE_SCOPE(category, name) static_cast<void>(0)
+#define GUICPP_TRACE_SCOPE_DETAIL(category, name, detail) static_cast<void>(0)
+#endif
+
+namespace GUICPP
+{
+    /**
+     * @brief A span traced by a thread.
+     */
+    struct TraceEvent
+    {
+        static constexpr size_t DetailSize = 48; ///< The size of the detail, its terminating zero included.
+
+        const char* category = ""; ///< The category of the span, such as "draw" or "asset".
+        const char* name = ""; ///< The name of the span.
+        int64_t start = 0; ///< The start of the span, in nanoseconds since the trace started.
+        int64_t duration = 0; ///< The duration of the span, in nanoseconds.
+        std::array<char, DetailSize> detail{}; ///< A detail such as the path of an asset, empty if none.
+    };
+
+    /**
+     * @class TraceBuffer
+     * @brief The spans of one thread waiting for the writer of the Tracer.
+     *
+     * @details A ring written only by its thread and read only by the writer, without lock. A span
+     * that does not fit is dropped and counted rather than making its thread wait.
+     */
+    class TraceBuffer
+    {
+    public:
+        static constexpr size_t Capacity = 16384; ///< The number of spans the ring holds.
+
+        /**
+         * @brief Construct the buffer of a thread.
+         *
+         * @param threadId The id of the thread in the trace.
+         */
+        explicit TraceBuffer(uint32_t threadId);
+
+        /**
+         * @brief Add a span, from the thread of the buffer.
+         *
+         * @param event The span.
+         * @return bool False if the ring was full and the span dropped.
+         */
+        bool Push(const TraceEvent& event);
+
+        /**
+         * @brief Take the spans added so far, from the writer.
+         *
+         * @param events The vector the spans are appended to.
+         */
+        void Drain(std::vector<TraceEvent>& events);
+
+        /**
+         * @brief Forget the spans not taken yet, from the writer.
+         */
+        void Discard();
+
+        /**
+         * @brief Get the id of the thread in the trace.
+         *
+         * @return uint32_t The id.
+         */
+        [[nodiscard]] uint32_t GetThreadId() const;
+
+        /**
+         * @brief Get the number of spans dropped because the ring was full.
+         *
+         * @return size_t The number of spans dropped.
+         */
+        [[nodiscard]] size_t GetDroppedCount() const;
+
+    private:
+        std::unique_ptr<std::array<TraceEvent, Capacity>> m_events; ///< The ring.
+        std::atomic<size_t> m_head{ 0 }; ///< The number of spans pushed, written by the thread.
+        std::atomic<size_t> m_tail{ 0 }; ///< The number of spans drained, written by the writer.
+        std::atomic<size_t> m_droppedCount{ 0 }; ///< The spans dropped.
+        uint32_t m_threadId; ///< The id of the thread in the trace.
+    };
+
+    /**
+     * @class Tracer
+     * @brief Writes the spans of the GUI as a Chrome trace-event JSON file, for chrome://tracing or Perfetto.
+     *
+     * @details The GUI traces the events it dispatches, the widgets it offers them to, the groups it
+     * walks, the widgets it draws, the delegates and the asset loads. Each thread adds its spans to
+     * its own TraceBuffer; a writer thread drains the buffers and writes them to the file, so a
+     * traced thread never waits for the disk.
+     */
+    class Tracer
+    {
+    public:
+        /**
+         * @brief Get the tracer shared by every GUI.
+         *
+         * @return Tracer& The tracer.
+         */
+        static Tracer& GetInstance();
+
+        /**
+         * @brief Stop the trace being written.
+         */
+        ~Tracer();
+
+        /**
+         * @brief Start writing a trace, stopping the previous one.
+         *
+         * @param path The path of the JSON file, replaced if it exists.
+         * @param flushInterval How often the writer drains the buffers.
+         * @return bool False if the file could not be opened.
+         */
+        bool Start(const std::string& path, std::chrono::milliseconds flushInterval = std::chrono::milliseconds(100));
+
+        /**
+         * @brief Write the spans left and close the trace.
+         */
+        void Stop();
+
+        /**
+         * @brief Check whether a trace is being written.
+         *
+         * @return bool True between Start and Stop.
+         */
+        static bool IsTracing()
+        {
+            return s_isTracing.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Add a span of the calling thread to the trace.
+         *
+         * @param category The category of the span, it must outlive the trace.
+         * @param name The name of the span, it must outlive the trace.
+         * @param start The start of the span.
+         * @param end The end of the span.
+         * @param detail A detail copied with the span, nullptr for none.
+         */
+        void Add(const char* category, const char* name, std::chrono::steady_clock::time_point start,
+                 std::chrono::steady_clock::time_point end, const char* detail = nullptr);
+
+        /**
+         * @brief Name the calling thread in the traces.
+         *
+         * @details Only the name is kept, the buffer of the thread is created by its first span while tracing.
+         *
+         * @param name The name of the thread.
+         */
+        void NameThread(const std::string& name);
+
+        /**
+         * @brief Get the number of spans dropped because a thread added them faster than the writer drained them.
+         *
+         * @return size_t The number of spans dropped by every thread.
+         */
+        [[nodiscard]] size_t GetDroppedCount() const;
+
+    private:
+        Tracer() = default;
+
+        /**
+         * @brief Get the buffer of the calling thread, created on its first span.
+         *
+         * @return TraceBuffer& The buffer.
+         */
+        TraceBuffer& GetThreadBuffer();
+
+        /**
+         * @brief Get the id of the calling thread in the traces, given on first use.
+         *
+         * @return uint32_t The id.
+         */
+        uint32_t GetThreadId();
+
+        /**
+         * @brief Drain the buffers every flush interval until the trace stops.
+         *
+         * @param stopToken The token stopping the writer.
+         */
+        void Run(std::stop_token stopToken);
+
+        /**
+         * @brief Drain every buffer and write the spans to the file.
+         */
+        void Write();
+
+        static inline std::atomic<bool> s_isTracing{ false }; ///< Whether a trace is being written.
+
+        mutable std::mutex m_mutex; ///< Guards the buffer list, the thread names and the file.
+        std::vector<std::unique_ptr<TraceBuffer>> m_buffers; ///< The buffers of every thread that traced.
+        std::map<uint32_t, std::string> m_threadNames; ///< The names of the named threads, by id, whether they traced or not.
+        std::atomic<uint32_t> m_nextThreadId{ 0 }; ///< The id given to the next thread.
+        std::ofstream m_file; ///< The trace file.
+        bool m_isFirstEvent = true; ///< Whether no event was written to the file yet.
+        std::vector<TraceEvent> m_events; ///< The spans drained, reused between writes.
+        std::string m_text; ///< The JSON written, reused between writes.
+        std::chrono::steady_clock::time_point m_start; ///< The start of the trace.
+        std::chrono::milliseconds m_flushInterval{ 100 }; ///< How often the writer drains the buffers.
+        std::condition_variable_any m_wakeUp; ///< Wakes the writer up when the trace stops.
+        std::mutex m_wakeUpMutex; ///< The mutex of m_wakeUp.
+        std::jthread m_writer; ///< The writer thread.
+    };
+
+    /**
+     * @class TraceScope
+     * @brief Traces a span until the end of its scope, declared by the GUICPP_TRACE_ macros.
+     *
+     * @details With GUICPP_TRACK_ALLOCATIONS, the span is also the call site of the allocations
+     * made in its scope, traced or not.
+     */
+    class TraceScope
+    {
+    public:
+        /**
+         * @brief Start a span, nothing if no trace is being written.
+         *
+         * @param category The category of the span.
+         * @param name The name of the span.
+         * @param detail A detail copied with the span, nullptr for none.
+         */
+        TraceScope(const char* category, const char* name, const char* detail = nullptr)
+            : m_category(category), m_name(name), m_detail(detail), m_isTracing(Tracer::IsTracing())
+        {
+#ifdef GUICPP_TRACK_ALLOCATIONS
+            m_site.category = category;
+            m_site.name = name;
+            AllocationTracker::EnterSite(m_site);
+#endif
+            if (m_isTracing) {
+                m_start = std::chrono::steady_clock::now();
+            }
+        }
+
+        /**
+         * @brief Start a span with a string detail.
+         *
+         * @param category The category of the span.
+         * @param name The name of the span.
+         * @param detail The detail, it must outlive the scope.
+         */
+        TraceScope(const char* category, const char* name, const std::string& detail)
+            : TraceScope(category, name, detail.c_str())
+        {
+        }
+
+        /**
+         * @brief Add the span to the trace.
+         */
+        ~TraceScope()
+        {
+            if (m_isTracing) {
+                Tracer::GetInstance().Add(m_category, m_name, m_start, std::chrono::steady_clock::now(), m_detail);
+            }
+#ifdef GUICPP_TRACK_ALLOCATIONS
+            AllocationTracker::LeaveSite(m_site);
+#endif
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        const char* m_category; ///< The category of the span.
+        const char* m_name; ///< The name of the span.
+        const char* m_detail; ///< The detail of the span, nullptr for none.
+        bool m_isTracing; ///< Whether a trace was being written when the span started.
+        std::chrono::steady_clock::time_point m_start; ///< The start of the span.
+#ifdef GUICPP_TRACK_ALLOCATIONS
+        AllocationSite m_site; ///< The span as the call site of the allocations.
+#endif
+    };
+}
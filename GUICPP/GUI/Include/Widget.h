@@ -1,9 +1,23 @@
 #pragma once
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 #include <SFML/Graphics.hpp>
 
+#include "MemoryUsage.h"
+#include "Profiler.h"
+#include "RenderSink.h"
+#include "SoundPool.h"
+#include "Style.h"
+#include "Tracer.h"
+
 namespace GUICPP
 {
+    class TextBatch;
+
     /**
      * @brief Widget class is the base class for all GUI widgets.
      */
@@ -20,7 +34,8 @@ namespace GUICPP
         Widget(const sf::Vector2f& m_position, const sf::Vector2f& m_size,
                const sf::Color& m_color) : m_position(m_position),
                                            m_size(m_size),
-                                           m_color(m_color){}
+                                           m_color(m_color),
+                                           m_style(Theme::GetDefault().GetSlot("Widget")){}
         
         /**
          * @brief Virtual destructor for the Widget.
@@ -70,12 +85,205 @@ namespace GUICPP
          */
         sf::Vector2f GetRelativePosition(class Group& Group);
 
+        /**
+         * @brief Get the area of the Widget reacting to the mouse, in global coordinates.
+         *
+         * @return The bounds of the Widget, its position and size by default.
+         */
+        [[nodiscard]] virtual sf::FloatRect GetGlobalBounds() const;
+
+        /**
+         * @brief Set the layer of the Widget, higher layers are drawn and hit above the lower ones.
+         *
+         * @details The layer is added to the layers of the groups holding the Widget, see DrawKey.
+         *
+         * @param layer The layer of the Widget, 0 by default.
+         */
+        void SetLayer(int layer);
+
+        /**
+         * @brief Get the layer of the Widget.
+         *
+         * @return The layer of the Widget, without the layers of its groups.
+         */
+        [[nodiscard]] int GetLayer() const;
+
+        /**
+         * @brief Set the depth of the Widget inside its layer, higher depths are drawn and hit above the lower ones.
+         *
+         * @details Widgets with the same layer and depth may be reordered to share textures, those
+         * overlapping keep the order they were added in, see DrawKey.
+         *
+         * @param depth The depth of the Widget, 0 by default.
+         */
+        void SetDepth(int depth);
+
+        /**
+         * @brief Get the depth of the Widget inside its layer.
+         *
+         * @return The depth of the Widget.
+         */
+        [[nodiscard]] int GetDepth() const;
+
+        /**
+         * @brief Get the texture the Widget draws with, the widgets sharing it are drawn one after another.
+         *
+         * @return The texture of the Widget, nullptr if it draws untextured shapes.
+         */
+        [[nodiscard]] virtual const sf::Texture* GetMaterial() const;
+
+        /**
+         * @brief Mark the area of the Widget to be redrawn by a GUI drawing only what changed.
+         *
+         * @details The widgets call it when their state, colour, text or position changes. The area
+         * drawn the last time is redrawn as well, so a moved Widget leaves nothing behind, the
+         * bounds of the groups holding it are computed again, and the GUI sorts its draw list again.
+         */
+        void Invalidate();
+
+        /**
+         * @brief Get the name of the Widget type, used to group memory reports.
+         *
+         * @return The name of the Widget type.
+         */
+        [[nodiscard]] virtual const char* GetTypeName() const = 0;
+
+        /**
+         * @brief Get the memory footprint of the Widget.
+         *
+         * @return The memory owned and referenced by the Widget.
+         */
+        [[nodiscard]] virtual MemoryUsage GetMemoryUsage() const;
+
+        /**
+         * @brief Give the Widget its own style, detaching it from the theme.
+         *
+         * @details The colours and textures set on the Widget itself still apply over the style.
+         *
+         * @param style The style of the Widget.
+         */
+        void SetStyle(const std::shared_ptr<const Style>& style);
+
+        /**
+         * @brief Bind the Widget to a style slot, usually one of a Theme.
+         *
+         * @param slot The slot the Widget follows.
+         */
+        void SetStyleSlot(const std::shared_ptr<StyleSlot>& slot);
+
+        /**
+         * @brief Get the current style of the Widget.
+         *
+         * @return The style of its slot, with the colours and textures set on the Widget itself.
+         */
+        [[nodiscard]] const Style& GetStyle() const;
+
+        /**
+         * @brief Refresh the colours, textures and font of the Widget from its style.
+         *
+         * @details Called by GUI::ApplyTheme after style slots have been pointed at new styles.
+         */
+        virtual void ApplyStyle();
+
+        /**
+         * @brief Load the resources the Widget deferred, if any.
+         *
+         * @details Bitmap widgets only record their folder until they are about to be shown, so the
+         * widgets of a group that is never shown never load their textures.
+         */
+        void BindResources();
+
+        /**
+         * @brief Check whether the Widget has deferred resources that are not loaded yet.
+         *
+         * @return true if BindResources would load something, false otherwise.
+         */
+        [[nodiscard]] bool HasPendingResources() const;
+
+        /**
+         * @brief Release the loaded resources of the Widget, they are loaded again by the next BindResources.
+         *
+         * @return true if resources were released, false if the Widget had none loaded.
+         */
+        bool UnbindResources();
+
+        /**
+         * @brief List the files the Widget loads when its resources are bound, to prefetch them.
+         *
+         * @param paths The list the paths are appended to.
+         */
+        virtual void CollectResources(std::vector<std::string>& paths) const;
+
     protected:
         sf::Vector2f m_position = sf::Vector2f(0, 0); /**< Position of the Widget */
         sf::Vector2f m_size; /**< Size of the Widget */
-        sf::Color m_color = sf::Color::White; /**< Color of the Widget */
+        sf::Color m_color = sf::Color::White; /**< Color requested for the Widget, the drawn colours come from the style */
     
         sf::RenderWindow* m_window = nullptr; /**< Window in which the Widget is rendered */
+        RenderSink* m_sink = nullptr; /**< Sink the Widget draws into, set by its GUI before drawing it */
+        TextBatch* m_textBatch = nullptr; /**< Batch the Widget appends its texts to, nullptr to draw them directly */
+
+        std::shared_ptr<const SoundSet> m_sounds; /**< Shared table of the sounds played by the Widget, overrides the style ones */
+        std::shared_ptr<StyleSlot> m_style; /**< Shared slot holding the style of the Widget */
+        StyleOverrides m_styleOverrides; /**< Colours and textures of the Widget laid over the style of its slot */
+        bool m_hasPendingResources = false; /**< Whether resources were requested but not loaded yet */
+        int m_layer = 0; /**< Layer of the Widget in the drawing order */
+        int m_depth = 0; /**< Depth of the Widget inside its layer */
+        mutable std::array<SoundPool::Handle, static_cast<size_t>(SoundEvent::Count)> m_soundHandles{}; /**< Last play of the sound of each event */
+
+        /**
+         * @brief Bind the Widget to the slot of a type in the default theme.
+         *
+         * @param typeName The name of the Widget type.
+         */
+        void BindStyle(const std::string& typeName);
+
+        /**
+         * @brief Change the colours and textures the Widget sets for itself.
+         *
+         * @details They are kept on the Widget and laid over the style of its slot, so the Widget stays
+         * bound to its theme and picks up the rest of a new style on GUI::ApplyTheme.
+         *
+         * @param edit Function modifying the overrides of the Widget.
+         */
+        void EditStyle(const std::function<void(StyleOverrides&)>& edit);
+
+        /**
+         * @brief Load the deferred resources of the Widget, called once by BindResources.
+         */
+        virtual void LoadResources();
+
+        /**
+         * @brief Release the resources loaded by LoadResources, called by UnbindResources.
+         *
+         * @return true if resources were released, false if the Widget has none to release.
+         */
+        virtual bool ReleaseResources();
+
+        /**
+         * @brief Play the sound attached to an event, if any.
+         *
+         * @param event The event whose sound is played.
+         */
+        void PlaySound(SoundEvent event) const;
+
+        /**
+         * @brief Stop the sound of an event if the Widget played it and it is still playing.
+         *
+         * @param event The event whose sound is stopped.
+         * @return true if the sound was playing, false otherwise.
+         */
+        bool StopSound(SoundEvent event) const;
+
+        /**
+         * @brief Get the position of the pointer in the world, as last reported by the mouse events handled by the GUI.
+         *
+         * @details The position is read from the mouse while the Widget is not in a GUI, so that
+         * replayed events drive the widgets of a GUI the same way as live ones.
+         *
+         * @return The pointer position, in the coordinates of the view of the window.
+         */
+        [[nodiscard]] sf::Vector2f GetPointerPosition() const;
 
         /**
          * @brief Handle events for the Widget. This must be implemented in a derived class.
@@ -99,6 +307,44 @@ namespace GUICPP
          * @param window Window in which the Widget is to be rendered.
          */
         void SetWindow(sf::RenderWindow* window);
+
+        /**
+         * @brief Set the batch the Widget appends its texts to.
+         *
+         * @param batch Batch drawn by the owner of the Widget after its widgets, nullptr to draw the texts directly.
+         */
+        void SetTextBatch(TextBatch* batch);
+
+        /**
+         * @brief Set where the Widget reads the pointer position from.
+         *
+         * @param pointer The pixel position kept by the GUI from its mouse events, nullptr to read the mouse.
+         */
+        void SetPointer(const sf::Vector2i* pointer);
+
+        /**
+         * @brief Set the sink the Widget draws into.
+         *
+         * @param sink The window of the Widget, the texture of a GUI drawing only what changed, or a recording.
+         */
+        void SetRenderSink(RenderSink* sink);
+
+        /**
+         * @brief Get the shared style the Widget draws with, its slot style with its overrides.
+         *
+         * @return The style, derived again when the slot points at another style or the overrides changed.
+         */
+        [[nodiscard]] const std::shared_ptr<const Style>& GetSharedStyle() const;
+
+        const sf::Vector2i* m_pointer = nullptr; /**< Pointer position kept by the GUI, in pixels of the window */
+        Group* m_group = nullptr; /**< Group the Widget was added to, nullptr if it is held by the GUI directly */
+        bool* m_drawOrderFlag = nullptr; /**< Flag raised to make the GUI holding the Widget directly sort its draw list again */
+        mutable std::shared_ptr<const Style> m_slotStyle; /**< Style of the slot the resolved style was derived from */
+        mutable std::shared_ptr<const Style> m_resolvedStyle; /**< Style of the slot with the overrides, nullptr to derive it again */
+        bool m_isDirty = true; /**< Whether the Widget changed since the GUI last drew it */
+        bool m_isDrawn = false; /**< Whether the GUI drew the Widget into its current target */
+        sf::FloatRect m_drawnBounds; /**< Bounds of the Widget when the GUI last drew it */
+        size_t m_drawnIndex = 0; /**< Position of the Widget in the drawing order when the GUI last drew it */
     
         /**
          * @brief Friend classes.
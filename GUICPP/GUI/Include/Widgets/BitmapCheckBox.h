@@ -1,4 +1,5 @@
 #pragma once
+#include "HitMask.h"
 #include "Widgets/CheckBox.h"
 
 namespace GUICPP
@@ -18,9 +19,9 @@ namespace GUICPP
          *
          * @param position The initial position of the BitmapCheckBox.
          * @param size The size of the BitmapCheckBox.
-         * @param color The color of the BitmapCheckBox. Default is white.
+         * @param color The color of the BitmapCheckBox, none to keep the colour of its style, white by default.
          */
-        BitmapCheckBox(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& color = sf::Color::White);
+        BitmapCheckBox(const sf::Vector2f& position, const sf::Vector2f& size, const std::optional<sf::Color>& color = std::nullopt);
 
         /**
          * @brief Handles the events.
@@ -75,12 +76,77 @@ namespace GUICPP
         /**
          * @brief Sets the bitmap for the checkbox.
          *
+         * @details The textures are loaded when the checkbox is about to be shown, see Widget::BindResources.
+         *
          * @param pathToFolder The path to the folder containing the bitmap files.
          * @param extension The extension of the bitmap files.
          */
         void SetBitmapFolder(const std::string& pathToFolder, const std::string& extension);
 
+        /**
+         * @brief Sets whether the checkbox reacts only over the opaque pixels of its bitmaps.
+         *
+         * @details The hit masks of the bitmaps are generated when they are loaded, and shared with
+         * every widget using the same bitmaps.
+         *
+         * @param isEnabled True to ignore the transparent pixels, false to react over the whole bounds.
+         * @param alphaThreshold The alpha from which a pixel is opaque. Default is 128.
+         */
+        void SetPixelHitTest(bool isEnabled, sf::Uint8 alphaThreshold = 128);
+
+        /**
+         * @brief Lists the bitmap files of the checkbox while they are not loaded.
+         *
+         * @param paths The list the paths are appended to.
+         */
+        void CollectResources(std::vector<std::string>& paths) const override;
+
+        /**
+         * @brief Gets the area of the checkbox reacting to the mouse.
+         *
+         * @return The global bounds of the checkbox.
+         */
+        [[nodiscard]] sf::FloatRect GetGlobalBounds() const override;
+
+        /**
+         * @brief Gets the texture the checkbox draws with.
+         *
+         * @return The texture of the shown state, nullptr while the bitmaps are not loaded.
+         */
+        [[nodiscard]] const sf::Texture* GetMaterial() const override;
+
+        /**
+         * @brief Gets the name of the BitmapCheckBox type.
+         *
+         * @return The name of the BitmapCheckBox type.
+         */
+        [[nodiscard]] const char* GetTypeName() const override;
+
+        /**
+         * @brief Gets the memory footprint of the checkbox.
+         *
+         * @return The memory owned and referenced by the checkbox.
+         */
+        [[nodiscard]] MemoryUsage GetMemoryUsage() const override;
+
+        /**
+         * @brief Refreshes the texture and tint of the checkbox from its style.
+         */
+        void ApplyStyle() override;
+
     protected:
+        /**
+         * @brief Loads the bitmap files of the folder set with SetBitmapFolder.
+         */
+        void LoadResources() override;
+
+        /**
+         * @brief Releases the bitmap textures, they are loaded again when the widget is bound.
+         *
+         * @return True if a bitmap folder was set, false otherwise.
+         */
+        bool ReleaseResources() override;
+
         /**
          * @brief Handler for the start hover event.
          */
@@ -104,10 +170,16 @@ namespace GUICPP
         void OnReleased(bool away = false) override;
 
     private:
-        sf::Texture m_CheckedTexture; ///< Texture for the checked state of the checkbox.
-        sf::Texture m_CheckedMouseOverTexture; ///< Texture for the checked state when mouse is over the checkbox.
-        sf::Texture m_UncheckedTexture; ///< Texture for the unchecked state of the checkbox.
-        sf::Texture m_UncheckedMouseOverTexture; ///< Texture for the unchecked state when mouse is over the checkbox.
-        sf::Sprite m_sprite; ///< The sprite for displaying the checkbox.
+        NineSlice m_sprite; ///< The sprite for displaying the checkbox, textured and sliced from the style.
+        std::string m_bitmapFolder; ///< Folder of the bitmap files, loaded when the checkbox is bound.
+        std::string m_bitmapExtension; ///< Extension of the bitmap files.
+        bool m_isPixelHitTest = false; ///< Whether only the opaque pixels react.
+        sf::Uint8 m_alphaThreshold = 128; ///< The alpha from which a pixel is opaque.
+        std::shared_ptr<const HitMask> m_hitMask; ///< The hit mask of the shown bitmap, nullptr to test the bounds.
+
+        /**
+         * @brief Shows the style texture matching the checked and hover state of the checkbox.
+         */
+        void ShowState();
     };
 }
\ No newline at end of file
@@ -20,12 +20,12 @@ namespace GUICPP
          *
          * \param position The position of the bitmap slider.
          * \param size The size of the bitmap slider.
-         * \param barColor The color of the slider bar (optional, default is sf::Color::White).
-         * \param sliderColor The color of the slider cursor (optional, default is sf::Color::White).
+         * \param barColor The color of the slider bar (optional, the colour of its style, sf::Color::White by default).
+         * \param sliderColor The color of the slider cursor (optional, the colour of its style, sf::Color::White by default).
          * \param isVertical Specifies whether the slider is vertical (optional, default is false).
          */
         BitmapSlider(const sf::Vector2f& position, const sf::Vector2f& size,
-               const sf::Color& barColor = sf::Color::White, const sf::Color& sliderColor = sf::Color::White,
+               const std::optional<sf::Color>& barColor = std::nullopt, const std::optional<sf::Color>& sliderColor = std::nullopt,
                bool isVertical = false);
 
         /**
@@ -113,14 +113,68 @@ namespace GUICPP
         /**
          * \brief Sets the folder path and extension for the bitmap textures.
          *
+         * \details The textures are loaded when the bitmap slider is about to be shown, see Widget::BindResources.
+         *
          * \param pathToFolder The path to the folder containing the bitmap textures.
          * \param extension The file extension of the bitmap textures.
          */
         void SetBitmapFolder(const std::string& pathToFolder, const std::string& extension);
 
+        /**
+         * \brief Lists the bitmap files of the bitmap slider while they are not loaded.
+         *
+         * \param paths The list the paths are appended to.
+         */
+        void CollectResources(std::vector<std::string>& paths) const override;
+
+        /**
+         * \brief Gets the area of the slider reacting to the mouse.
+         *
+         * \return The global bounds of the bar and cursor of the slider.
+         */
+        [[nodiscard]] sf::FloatRect GetGlobalBounds() const override;
+
+        /**
+         * \brief Gets the texture the slider draws with.
+         *
+         * \return The texture of the bar, nullptr while the bitmaps are not loaded.
+         */
+        [[nodiscard]] const sf::Texture* GetMaterial() const override;
+
+        /**
+         * \brief Gets the name of the BitmapSlider type.
+         *
+         * \return The name of the BitmapSlider type.
+         */
+        [[nodiscard]] const char* GetTypeName() const override;
+
+        /**
+         * \brief Gets the memory footprint of the bitmap slider.
+         *
+         * \return The memory owned and referenced by the bitmap slider.
+         */
+        [[nodiscard]] MemoryUsage GetMemoryUsage() const override;
+
+        /**
+         * \brief Refreshes the textures and tints of the bitmap slider from its style.
+         */
+        void ApplyStyle() override;
+
     protected:
         sf::Vector2f m_indicatorSize; /**< The size of the bitmap slider indicator. */
 
+        /**
+         * \brief Loads the bitmap files of the folder set with SetBitmapFolder.
+         */
+        void LoadResources() override;
+
+        /**
+         * \brief Releases the bitmap textures, they are loaded again when the widget is bound.
+         *
+         * \return True if a bitmap folder was set, false otherwise.
+         */
+        bool ReleaseResources() override;
+
         /**
          * \brief Handles the events for the bitmap slider.
          *
@@ -166,15 +220,20 @@ namespace GUICPP
         void OnMouseHold() override;
 
     private:
-        sf::Texture m_barDefaultTexture; /**< The default texture for the slider bar. */
-        sf::Texture m_barHoverTexture; /**< The hover texture for the slider bar. */
-        sf::Texture m_cursorDefaultTexture; /**< The default texture for the slider cursor. */
-        sf::Texture m_cursorHoverTexture; /**< The hover texture for the slider cursor. */
-        sf::Sprite m_bar; /**< The sprite representing the slider bar. */
-        sf::Sprite m_cursor; /**< The sprite representing the slider cursor. */
+        NineSlice m_bar; /**< The sprite representing the slider bar, textured and sliced from the style body. */
+        NineSlice m_cursor; /**< The sprite representing the slider cursor, textured and sliced from the style accent. */
+        std::string m_bitmapFolder; /**< Folder of the bitmap files, loaded when the bitmap slider is bound. */
+        std::string m_bitmapExtension; /**< Extension of the bitmap files. */
         float m_minOffset = 0; /**< The minimum offset value. */
         float m_maxOffset = 0; /**< The maximum offset value. */
 
+        /**
+         * \brief Shows the style textures of a state on the bar and the cursor.
+         *
+         * \param state The state to show.
+         */
+        void ShowState(StyleState state);
+
         /**
          * \brief Sets the position of the bitmap slider cursor.
          *
@@ -182,6 +241,11 @@ namespace GUICPP
          */
         void SetCursorPosition(const sf::Vector2f& position) override;
 
+        /**
+         * \brief Sizes the bar and cursor sprites and centres their origins.
+         */
+        void ApplySizes();
+
         /**
          * \brief Computes the value of the bitmap slider based on the cursor position.
          *
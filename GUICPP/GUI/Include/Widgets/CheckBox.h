@@ -1,5 +1,4 @@
 #pragma once
-#include <any>
 #include <functional>
 #include <SFML/Audio.hpp>
 
@@ -22,9 +21,9 @@ namespace GUICPP
          *
          * @param position The initial position of the CheckBox.
          * @param size The size of the CheckBox.
-         * @param color The color of the CheckBox. Default is white.
+         * @param color The color of the CheckBox, none to keep the colour of its style, white by default.
          */
-        CheckBox(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& color = sf::Color::White);
+        CheckBox(const sf::Vector2f& position, const sf::Vector2f& size, const std::optional<sf::Color>& color = std::nullopt);
 
         /**
          * @brief Handles the events.
@@ -96,19 +95,45 @@ namespace GUICPP
          */
         template <class R, class ... A>
         void SetDelegate(R (*func)(A ...));
+
+        /**
+         * @brief Gets the area of the checkbox reacting to the mouse.
+         *
+         * @return The global bounds of the checkbox.
+         */
+        [[nodiscard]] sf::FloatRect GetGlobalBounds() const override;
+
+        /**
+         * @brief Gets the name of the CheckBox type.
+         *
+         * @return The name of the CheckBox type.
+         */
+        [[nodiscard]] const char* GetTypeName() const override;
+
+        /**
+         * @brief Gets the memory footprint of the CheckBox.
+         *
+         * @return The memory owned and referenced by the CheckBox.
+         */
+        [[nodiscard]] MemoryUsage GetMemoryUsage() const override;
+
+        /**
+         * @brief Refreshes the colours of the CheckBox from its style.
+         */
+        void ApplyStyle() override;
     
     protected:
         bool m_isMouseOver = false; ///< Indicates whether the mouse is over the checkbox.
         bool m_wasClicked = false; ///< Indicates whether the checkbox was clicked.
         bool m_isResetOnClicks = false; ///< Indicates whether to reset the checkbox state on clicks.
-        int m_isChecked{}; ///< Indicates whether the checkbox is checked.
+        bool m_isChecked = false; ///< Indicates whether the checkbox is checked.
 
-        std::shared_ptr<sf::SoundBuffer> m_OnCheckedBuffer; ///< Sound buffer for the checked state.
-        std::shared_ptr<sf::SoundBuffer> m_OnUncheckedBuffer; ///< Sound buffer for the unchecked state.
-        std::shared_ptr<sf::SoundBuffer> m_OnStartHoverBuffer; ///< Sound buffer for the start hover state.
-        std::shared_ptr<sf::SoundBuffer> m_OnEndHoverBuffer; ///< Sound buffer for the end hover state.
-    
-        sf::Sound m_sound; ///< The sound to play during checkbox events.
+        /**
+         * @brief Gets the style state matching the checked and hover state of the checkbox.
+         *
+         * @return The style state of the checkbox.
+         */
+        [[nodiscard]] StyleState GetStyleState() const;
 
         /**
          * @brief Handler for the start hover event.
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "widget.h"
+#include "TextLayout.h"
+
+namespace GUICPP
+{
+    /**
+     * @class ProfilerOverlay
+     * @brief Shows the last frame measured by the Profiler: its events, draw time, draw calls and slowest widgets.
+     *
+     * @details The overlay ignores the events and refreshes its text at most four times per second.
+     * Give it a high layer to keep it above the other widgets. With partial redraw, it is only
+     * refreshed when something over it is redrawn. Without GUICPP_PROFILE it shows that the
+     * profiler is compiled out.
+     */
+    class ProfilerOverlay : public Widget
+    {
+    public:
+        /**
+         * @brief Constructs a ProfilerOverlay.
+         *
+         * @param position The top left corner of the overlay.
+         * @param widgetCount The number of slowest widgets listed.
+         * @param characterSize The character size of the text.
+         */
+        explicit ProfilerOverlay(const sf::Vector2f& position, size_t widgetCount = 5, unsigned int characterSize = 12);
+
+        /**
+         * @brief Lets every event through.
+         *
+         * @param e The event.
+         * @return Always false.
+         */
+        bool HandleEvents(const sf::Event& e) override;
+
+        /**
+         * @brief Draws the overlay, refreshing its text first when it is old.
+         *
+         * @param states The render states to use while drawing.
+         */
+        void Draw(sf::RenderStates& states) override;
+
+        /**
+         * @brief Moves the overlay to the given position.
+         *
+         * @param position The position to move the overlay to.
+         */
+        void Move(const sf::Vector2f& position) override;
+
+        /**
+         * @brief Sets the colour of the text.
+         *
+         * @param color The color to set.
+         */
+        void SetColor(const sf::Color& color) override;
+
+        /**
+         * @brief Does nothing, the overlay takes the size of its text.
+         *
+         * @param size Unused.
+         */
+        void SetSize(const sf::Vector2f& size) override;
+
+        /**
+         * @brief Sets the position of the overlay.
+         *
+         * @param position The position to set.
+         */
+        void SetPosition(sf::Vector2f position) override;
+
+        /**
+         * @brief Gets the name of the ProfilerOverlay type.
+         *
+         * @return The name of the ProfilerOverlay type.
+         */
+        [[nodiscard]] const char* GetTypeName() const override;
+
+        /**
+         * @brief Gets the memory footprint of the ProfilerOverlay.
+         *
+         * @return The memory owned and referenced by the ProfilerOverlay.
+         */
+        [[nodiscard]] MemoryUsage GetMemoryUsage() const override;
+
+    private:
+        /**
+         * @brief Lays out the text of the last frame and fits the background to it.
+         */
+        void Refresh();
+
+        size_t m_widgetCount; ///< The number of slowest widgets listed.
+        unsigned int m_characterSize; ///< The character size of the text.
+        std::shared_ptr<sf::Font> m_font; ///< The default font of the GUI.
+        std::shared_ptr<const TextLayout> m_textLayout; ///< The laid out text, nullptr before the first draw.
+        size_t m_shownFrame = 0; ///< The frame shown by m_textLayout.
+        sf::Clock m_refreshClock; ///< The time since the last refresh.
+        sf::RectangleShape m_background; ///< The background behind the text.
+    };
+}
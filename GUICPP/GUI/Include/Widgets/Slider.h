@@ -19,12 +19,12 @@ namespace GUICPP
          *
          * \param position The position of the slider.
          * \param size The size of the slider.
-         * \param barColor The color of the slider bar (optional, default is sf::Color::White).
-         * \param sliderColor The color of the slider cursor (optional, default is sf::Color(191, 191, 191)).
+         * \param barColor The color of the slider bar (optional, the colour of its style, sf::Color::White by default).
+         * \param sliderColor The color of the slider cursor (optional, the colour of its style, sf::Color(191, 191, 191) by default).
          * \param isVertical Specifies whether the slider is vertical (optional, default is false).
          */
         Slider(const sf::Vector2f& position, const sf::Vector2f& size,
-               const sf::Color& barColor = sf::Color::White, const sf::Color& sliderColor = sf::Color(191,191,191),
+               const std::optional<sf::Color>& barColor = std::nullopt, const std::optional<sf::Color>& sliderColor = std::nullopt,
                bool isVertical = false);
 
         /**
@@ -114,18 +114,37 @@ namespace GUICPP
         template <class R, class ... A>
         void SetDelegate(R (*func)(A ...));
 
+        /**
+         * \brief Gets the area of the slider reacting to the mouse.
+         *
+         * \return The global bounds of the bar and cursor of the slider.
+         */
+        [[nodiscard]] sf::FloatRect GetGlobalBounds() const override;
+
+        /**
+         * \brief Gets the name of the Slider type.
+         *
+         * \return The name of the Slider type.
+         */
+        [[nodiscard]] const char* GetTypeName() const override;
+
+        /**
+         * \brief Gets the memory footprint of the slider.
+         *
+         * \return The memory owned and referenced by the slider.
+         */
+        [[nodiscard]] MemoryUsage GetMemoryUsage() const override;
+
+        /**
+         * \brief Refreshes the colours of the slider from its style.
+         */
+        void ApplyStyle() override;
+
     protected:
         sf::Vector2f m_cursorSize; /**< The size of the slider cursor. */
-        sf::Color m_barColor; /**< The color of the slider bar. */
-        sf::Color m_sliderColor; /**< The color of the slider cursor. */
         bool m_isVertical = false; /**< Specifies whether the slider is vertical. */
         bool m_isMouseOver = false; /**< Specifies whether the mouse is over the slider. */
         bool m_isMousePressed = false; /**< Specifies whether the mouse is pressed on the slider. */
-        std::shared_ptr<sf::SoundBuffer> m_OnClickBuffer; /**< Sound buffer for the click event. */
-        std::shared_ptr<sf::SoundBuffer> m_OnReleasedBuffer; /**< Sound buffer for the release event. */
-        std::shared_ptr<sf::SoundBuffer> m_OnStartHoverBuffer; /**< Sound buffer for the start hover event. */
-        std::shared_ptr<sf::SoundBuffer> m_OnEndHoverBuffer; /**< Sound buffer for the end hover event. */
-        sf::Sound m_sound; /**< Sound object for playing the sound buffers. */
         std::function<void(float)> m_delegate; /**< Delegate function for handling slider events. */
         float m_value = 0; /**< The value of the slider. */
         
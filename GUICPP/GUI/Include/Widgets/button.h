@@ -1,10 +1,10 @@
 #pragma once
 
-#include <any>
 #include <functional>
 #include <SFML/Audio.hpp>
 
 #include "widget.h"
+#include "TextLayout.h"
 
 namespace GUICPP
 {
@@ -17,16 +17,26 @@ namespace GUICPP
     class Button : public Widget
     {
     public:
+        /**
+         * @enum PressFeedback
+         * @brief How the text of the Button shrinks while it is pressed.
+         */
+        enum class PressFeedback
+        {
+            Transform, ///< Scale the laid out text, no glyph is looked up on click.
+            Resize ///< Draw the text one character size smaller, as a separately laid out text.
+        };
+
         /**
          * @brief Constructs a new Button.
          *
          * @param position The position of the Button.
          * @param size The size of the Button.
-         * @param color The color of the Button. Default is White.
+         * @param color The color of the Button, none to keep the colour of its style, White by default.
          * @param text The text of the Button. Default is an empty string.
          * @param characterSize The character size of the Button text. Default is 31.
          */
-        Button(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& color = sf::Color::White,
+        Button(const sf::Vector2f& position, const sf::Vector2f& size, const std::optional<sf::Color>& color = std::nullopt,
                const std::string& text = "", unsigned int characterSize = 31);
 
         /**
@@ -74,10 +84,17 @@ namespace GUICPP
         /**
          * @brief Sets the Button's font.
          *
-         * @param font The new font of the Button.
+         * @param font The new font of the Button, it must outlive the Button as for sf::Text.
          */
         void SetFont(const sf::Font& font);
 
+        /**
+         * @brief Sets the Button's font, kept alive by the Button.
+         *
+         * @param font The new font of the Button, nullptr to draw no text.
+         */
+        void SetFont(std::shared_ptr<const sf::Font> font);
+
         /**
          * @brief Sets the Button's text.
          *
@@ -92,6 +109,27 @@ namespace GUICPP
          */
         void SetFontSize(unsigned int size);
 
+        /**
+         * @brief Sets the SDF atlas the Button's text is drawn from instead of its font.
+         *
+         * @param font The SDF atlas, nullptr or an unavailable atlas to draw from the font.
+         */
+        void SetSdfFont(std::shared_ptr<SdfFont> font);
+
+        /**
+         * @brief Sets the Button's text style.
+         *
+         * @param style The sf::Text::Style flags of the text.
+         */
+        void SetTextStyle(sf::Uint32 style);
+
+        /**
+         * @brief Sets how the Button's text shrinks while it is pressed.
+         *
+         * @param feedback The press feedback. Default is PressFeedback::Transform.
+         */
+        void SetPressFeedback(PressFeedback feedback);
+
         /**
          * @brief Sets the Button's sounds.
          *
@@ -113,20 +151,39 @@ namespace GUICPP
          */
         template <typename Callable, typename... Args>
         void SetDelegate(Callable&& func, Args&&... args);
+
+        /**
+         * @brief Gets the area of the button reacting to the mouse.
+         *
+         * @return The global bounds of the button.
+         */
+        [[nodiscard]] sf::FloatRect GetGlobalBounds() const override;
+
+        /**
+         * @brief Gets the name of the Button type.
+         *
+         * @return The name of the Button type.
+         */
+        [[nodiscard]] const char* GetTypeName() const override;
+
+        /**
+         * @brief Gets the memory footprint of the Button.
+         *
+         * @return The memory owned and referenced by the Button.
+         */
+        [[nodiscard]] MemoryUsage GetMemoryUsage() const override;
+
+        /**
+         * @brief Refreshes the colours and font of the Button from its style.
+         */
+        void ApplyStyle() override;
      
     protected:
         bool m_isMouseOver = false; ///< Indicates if the mouse is over the Button.
         bool m_wasClicked = false; ///< Indicates if the Button was clicked.
         bool m_isResetOnClicks = false; ///< Indicates if the Button should be reset after being clicked.
 
-        std::shared_ptr<sf::SoundBuffer> m_OnClickBuffer; ///< The sound buffer to play when the Button is clicked.
-        std::shared_ptr<sf::SoundBuffer> m_OnReleasedBuffer; ///< The sound buffer to play when the Button is released. */
-        std::shared_ptr<sf::SoundBuffer> m_OnStartHoverBuffer; ///< The sound buffer to play when the mouse enters the Button. */
-        std::shared_ptr<sf::SoundBuffer> m_OnEndHoverBuffer; ///< The sound buffer to play when the mouse leaves the Button. */
-
-        sf::Sound m_sound; ///< The sound to play when the Button is clicked. */
-        std::function<void(std::vector<std::any>&)> m_delegate; ///< The delegate function to be called. */
-        std::vector<std::any> m_delegateArgs; ///< The arguments to be passed to the delegate function. */
+        std::function<void()> m_delegate; ///< The delegate function to be called, with its arguments bound. */
 
         /**
          * \brief Called when the mouse enters the Button.
@@ -147,7 +204,32 @@ namespace GUICPP
         virtual void OnReleased(bool away = false);
     private:
         sf::RectangleShape m_rect; ///< The shape of the Button.
-        sf::Text m_text; ///< The text of the Button.
+        sf::String m_string; ///< The text of the Button.
+        std::shared_ptr<const sf::Font> m_font; ///< The font of the text, nullptr until one is set, not owned when set by reference.
+        std::shared_ptr<SdfFont> m_sdfFont; ///< The SDF atlas drawn instead of the font, nullptr to draw the font.
+        unsigned int m_characterSize; ///< The character size of the text.
+        sf::Color m_textColor; ///< The colour of the text.
+        sf::Uint32 m_textStyle = sf::Text::Regular; ///< The sf::Text::Style flags of the text.
+        PressFeedback m_pressFeedback = PressFeedback::Transform; ///< How the text shrinks while pressed.
+        std::shared_ptr<const TextLayout> m_textLayout; ///< The shared laid out text drawn, nullptr without a font or atlas.
+        std::shared_ptr<const TextLayout> m_releasedTextLayout; ///< The text laid out at the character size.
+        std::shared_ptr<const TextLayout> m_pressedTextLayout; ///< The text laid out at the pressed size, the released one with PressFeedback::Transform.
+        sf::Transformable m_textTransform; ///< Centres the text in the Button and scales it while pressed.
+
+        /**
+         * @brief Fetches the laid out text for the current string, font, size and colour, and centres it.
+         */
+        void UpdateText();
+
+        /**
+         * @brief Draws the laid out text matching the pressed state, and centres it.
+         */
+        void SelectTextLayout();
+
+        /**
+         * @brief Rasterizes the glyphs of the label at its size and its pressed size, so clicking does not stall.
+         */
+        void PrewarmText() const;
 
     };
 
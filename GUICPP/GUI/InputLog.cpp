@@ -0,0 +1,387 @@
+#include "InputLog.h"
+
+#include <bit>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+#include "GUI.h"
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        constexpr char Magic[4] = { 'G', 'C', 'I', 'N' };
+        constexpr size_t HeaderSize = 16;
+        constexpr size_t FlushSize = 4096;
+
+        enum KeyFlags : uint8_t
+        {
+            KeyAlt = 1,
+            KeyControl = 2,
+            KeyShift = 4,
+            KeySystem = 8
+        };
+
+        void WriteUint32(std::vector<uint8_t>& buffer, uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+            }
+        }
+
+        void WriteVarint(std::vector<uint8_t>& buffer, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                buffer.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            buffer.push_back(static_cast<uint8_t>(value));
+        }
+
+        void WriteSigned(std::vector<uint8_t>& buffer, int64_t value)
+        {
+            // zigzag, small negative values stay short
+            WriteVarint(buffer, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        class Reader
+        {
+        public:
+            Reader(const std::vector<uint8_t>& data, size_t offset) : m_data(data), m_offset(offset) {}
+
+            bool ReadUint8(uint8_t& value)
+            {
+                if (m_offset >= m_data.size())
+                    return false;
+                value = m_data[m_offset++];
+                return true;
+            }
+
+            bool ReadUint32(uint32_t& value)
+            {
+                if (m_data.size() - m_offset < 4)
+                    return false;
+                value = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    value |= static_cast<uint32_t>(m_data[m_offset++]) << (i * 8);
+                }
+                return true;
+            }
+
+            bool ReadVarint(uint64_t& value)
+            {
+                value = 0;
+                for (int shift = 0; shift < 64; shift += 7)
+                {
+                    uint8_t byte = 0;
+                    if (!ReadUint8(byte))
+                        return false;
+                    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                        return true;
+                }
+                return false;
+            }
+
+            bool ReadSigned(int64_t& value)
+            {
+                uint64_t encoded = 0;
+                if (!ReadVarint(encoded))
+                    return false;
+                value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+                return true;
+            }
+
+            [[nodiscard]] size_t GetOffset() const
+            {
+                return m_offset;
+            }
+
+        private:
+            const std::vector<uint8_t>& m_data;
+            size_t m_offset;
+        };
+    }
+
+    InputRecorder::~InputRecorder()
+    {
+        Close();
+    }
+
+    bool InputRecorder::Open(const std::string& path, const sf::Vector2u& windowSize)
+    {
+        Close();
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_file)
+        {
+            std::cout << "Error opening input log " << path << std::endl;
+            return false;
+        }
+        m_buffer.clear();
+        m_buffer.insert(m_buffer.end(), std::begin(Magic), std::end(Magic));
+        WriteUint32(m_buffer, Version);
+        WriteUint32(m_buffer, windowSize.x);
+        WriteUint32(m_buffer, windowSize.y);
+        m_clock.restart();
+        m_lastTime = 0;
+        m_recordCount = 0;
+        return true;
+    }
+
+    void InputRecorder::Close()
+    {
+        if (!m_file.is_open())
+            return;
+        Flush();
+        m_file.close();
+    }
+
+    bool InputRecorder::IsRecording() const
+    {
+        return m_file.is_open();
+    }
+
+    bool InputRecorder::Record(const sf::Event& event, const sf::Vector2i& pointer)
+    {
+        if (!m_file.is_open())
+            return false;
+
+        const size_t start = m_buffer.size();
+        const int64_t time = m_clock.getElapsedTime().asMicroseconds();
+        WriteVarint(m_buffer, static_cast<uint64_t>(time - m_lastTime));
+        m_buffer.push_back(static_cast<uint8_t>(event.type));
+        // the position of the mouse events is the pointer
+        WriteSigned(m_buffer, pointer.x);
+        WriteSigned(m_buffer, pointer.y);
+        switch (event.type)
+        {
+        case sf::Event::Resized:
+            WriteVarint(m_buffer, event.size.width);
+            WriteVarint(m_buffer, event.size.height);
+            break;
+        case sf::Event::TextEntered:
+            WriteVarint(m_buffer, event.text.unicode);
+            break;
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:
+            WriteSigned(m_buffer, event.key.code);
+            m_buffer.push_back(static_cast<uint8_t>((event.key.alt ? KeyAlt : 0) | (event.key.control ? KeyControl : 0)
+                                                    | (event.key.shift ? KeyShift : 0) | (event.key.system ? KeySystem : 0)));
+            break;
+        case sf::Event::MouseWheelScrolled:
+            m_buffer.push_back(static_cast<uint8_t>(event.mouseWheelScroll.wheel));
+            WriteUint32(m_buffer, std::bit_cast<uint32_t>(event.mouseWheelScroll.delta));
+            break;
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            m_buffer.push_back(static_cast<uint8_t>(event.mouseButton.button));
+            break;
+        case sf::Event::Closed:
+        case sf::Event::LostFocus:
+        case sf::Event::GainedFocus:
+        case sf::Event::MouseMoved:
+        case sf::Event::MouseEntered:
+        case sf::Event::MouseLeft:
+            break;
+        default:
+            m_buffer.resize(start);
+            return false;
+        }
+
+        m_lastTime = time;
+        ++m_recordCount;
+        if (m_buffer.size() >= FlushSize)
+        {
+            Flush();
+        }
+        return true;
+    }
+
+    void InputRecorder::Flush()
+    {
+        if (m_buffer.empty() || !m_file.is_open())
+            return;
+        m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+        m_file.flush();
+        m_buffer.clear();
+    }
+
+    size_t InputRecorder::GetRecordCount() const
+    {
+        return m_recordCount;
+    }
+
+    bool InputReplayer::Open(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cout << "Error opening input log " << path << std::endl;
+            return false;
+        }
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        Reader reader(data, sizeof(Magic));
+        uint32_t version = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        if (data.size() < HeaderSize || std::memcmp(data.data(), Magic, sizeof(Magic)) != 0
+            || !reader.ReadUint32(version) || version != InputRecorder::Version
+            || !reader.ReadUint32(width) || !reader.ReadUint32(height))
+        {
+            std::cout << "Error reading input log " << path << ", not a log of version " << InputRecorder::Version << std::endl;
+            return false;
+        }
+
+        m_data = std::move(data);
+        m_windowSize = { width, height };
+        m_start = reader.GetOffset();
+        Rewind();
+        return true;
+    }
+
+    bool InputReplayer::Next(InputRecord& record)
+    {
+        if (m_hasPending)
+        {
+            record = m_pending;
+            m_hasPending = false;
+            return true;
+        }
+
+        Reader reader(m_data, m_offset);
+        uint64_t delta = 0;
+        uint8_t type = 0;
+        int64_t x = 0;
+        int64_t y = 0;
+        if (!reader.ReadVarint(delta) || !reader.ReadUint8(type) || !reader.ReadSigned(x) || !reader.ReadSigned(y))
+            return false;
+
+        sf::Event event{};
+        event.type = static_cast<sf::Event::EventType>(type);
+        const sf::Vector2i pointer(static_cast<int>(x), static_cast<int>(y));
+        bool isValid = true;
+        switch (event.type)
+        {
+        case sf::Event::Resized: {
+            uint64_t width = 0;
+            uint64_t height = 0;
+            isValid = reader.ReadVarint(width) && reader.ReadVarint(height);
+            event.size = { static_cast<unsigned int>(width), static_cast<unsigned int>(height) };
+            break;
+        }
+        case sf::Event::TextEntered: {
+            uint64_t unicode = 0;
+            isValid = reader.ReadVarint(unicode);
+            event.text.unicode = static_cast<sf::Uint32>(unicode);
+            break;
+        }
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased: {
+            int64_t code = 0;
+            uint8_t flags = 0;
+            isValid = reader.ReadSigned(code) && reader.ReadUint8(flags);
+            event.key.code = static_cast<sf::Keyboard::Key>(code);
+            event.key.alt = (flags & KeyAlt) != 0;
+            event.key.control = (flags & KeyControl) != 0;
+            event.key.shift = (flags & KeyShift) != 0;
+            event.key.system = (flags & KeySystem) != 0;
+            break;
+        }
+        case sf::Event::MouseWheelScrolled: {
+            uint8_t wheel = 0;
+            uint32_t delta = 0;
+            isValid = reader.ReadUint8(wheel) && reader.ReadUint32(delta);
+            event.mouseWheelScroll = { static_cast<sf::Mouse::Wheel>(wheel), std::bit_cast<float>(delta), pointer.x, pointer.y };
+            break;
+        }
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased: {
+            uint8_t button = 0;
+            isValid = reader.ReadUint8(button);
+            event.mouseButton = { static_cast<sf::Mouse::Button>(button), pointer.x, pointer.y };
+            break;
+        }
+        case sf::Event::MouseMoved:
+            event.mouseMove = { pointer.x, pointer.y };
+            break;
+        case sf::Event::Closed:
+        case sf::Event::LostFocus:
+        case sf::Event::GainedFocus:
+        case sf::Event::MouseEntered:
+        case sf::Event::MouseLeft:
+            break;
+        default:
+            isValid = false;
+            break;
+        }
+        if (!isValid)
+        {
+            // the rest of the log cannot be trusted
+            m_offset = m_data.size();
+            return false;
+        }
+
+        m_offset = reader.GetOffset();
+        m_time += static_cast<int64_t>(delta);
+        record.time = sf::microseconds(m_time);
+        record.pointer = pointer;
+        record.event = event;
+        return true;
+    }
+
+    void InputReplayer::Rewind()
+    {
+        m_offset = m_start;
+        m_time = 0;
+        m_hasPending = false;
+    }
+
+    size_t InputReplayer::ReplayUntil(GUI& gui, sf::Time time)
+    {
+        size_t count = 0;
+        InputRecord record;
+        while (Next(record))
+        {
+            if (record.time > time)
+            {
+                m_pending = record;
+                m_hasPending = true;
+                break;
+            }
+            gui.SetPointerPosition(record.pointer);
+            gui.HandleEvents(record.event);
+            ++count;
+        }
+        return count;
+    }
+
+    size_t InputReplayer::ReplayAll(GUI& gui)
+    {
+        size_t count = 0;
+        InputRecord record;
+        while (Next(record))
+        {
+            gui.SetPointerPosition(record.pointer);
+            gui.HandleEvents(record.event);
+            ++count;
+        }
+        return count;
+    }
+
+    bool InputReplayer::IsFinished() const
+    {
+        return !m_hasPending && m_offset >= m_data.size();
+    }
+
+    sf::Vector2u InputReplayer::GetWindowSize() const
+    {
+        return m_windowSize;
+    }
+
+}
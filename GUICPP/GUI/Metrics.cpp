@@ -0,0 +1,312 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        void AppendNumber(std::string& text, double value)
+        {
+            char number[32];
+            std::snprintf(number, sizeof(number), "%.9g", value);
+            text += number;
+        }
+    }
+
+    Metric::Metric(std::string name, std::string help) : m_name(std::move(name)), m_help(std::move(help))
+    {
+    }
+
+    const std::string& Metric::GetName() const
+    {
+        return m_name;
+    }
+
+    const std::string& Metric::GetHelp() const
+    {
+        return m_help;
+    }
+
+    MetricType MetricCounter::GetType() const
+    {
+        return MetricType::Counter;
+    }
+
+    void MetricCounter::Add(uint64_t value)
+    {
+        m_value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void MetricCounter::Set(uint64_t value)
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    uint64_t MetricCounter::Get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    MetricType MetricGauge::GetType() const
+    {
+        return MetricType::Gauge;
+    }
+
+    void MetricGauge::Set(double value)
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    double MetricGauge::Get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    MetricHistogram::MetricHistogram(std::string name, std::string help, double unit)
+        : Metric(std::move(name), std::move(help)), m_unit(unit)
+    {
+    }
+
+    MetricType MetricHistogram::GetType() const
+    {
+        return MetricType::Histogram;
+    }
+
+    void MetricHistogram::Record(uint64_t value)
+    {
+        m_buckets[GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t MetricHistogram::GetCount() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t MetricHistogram::GetSum() const
+    {
+        return m_sum.load(std::memory_order_relaxed);
+    }
+
+    uint64_t MetricHistogram::GetCountBelow(uint64_t bound) const
+    {
+        uint64_t count = 0;
+        for (size_t bucket = 0; bucket < BucketCount && GetBucketMax(bucket) < bound; ++bucket)
+        {
+            count += m_buckets[bucket].load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    uint64_t MetricHistogram::GetQuantile(double quantile) const
+    {
+        // the buckets are read one by one while they may be updated, the total is taken from them
+        std::array<uint64_t, BucketCount> counts;
+        uint64_t total = 0;
+        for (size_t bucket = 0; bucket < BucketCount; ++bucket)
+        {
+            counts[bucket] = m_buckets[bucket].load(std::memory_order_relaxed);
+            total += counts[bucket];
+        }
+        if (total == 0)
+            return 0;
+
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(total) + 0.5));
+        uint64_t count = 0;
+        for (size_t bucket = 0; bucket < BucketCount; ++bucket)
+        {
+            count += counts[bucket];
+            if (count >= rank)
+                return GetBucketMax(bucket);
+        }
+        return GetBucketMax(BucketCount - 1);
+    }
+
+    double MetricHistogram::GetUnit() const
+    {
+        return m_unit;
+    }
+
+    size_t MetricHistogram::GetBucket(uint64_t value)
+    {
+        if (value < SubBucketCount)
+            return static_cast<size_t>(value);
+        // the top SubBucketBits + 1 bits of the value pick the bucket within its power of two
+        const int shift = std::bit_width(value) - (SubBucketBits + 1);
+        return SubBucketCount * static_cast<size_t>(shift + 1) + static_cast<size_t>((value >> shift) - SubBucketCount);
+    }
+
+    uint64_t MetricHistogram::GetBucketMax(size_t bucket)
+    {
+        if (bucket < SubBucketCount)
+            return bucket;
+        const int shift = static_cast<int>(bucket / SubBucketCount) - 1;
+        const uint64_t subBucket = bucket % SubBucketCount + SubBucketCount;
+        // wraps to the largest value for the last bucket
+        return ((subBucket + 1) << shift) - 1;
+    }
+
+    PrometheusFileExporter::PrometheusFileExporter(std::string path) : m_path(std::move(path))
+    {
+    }
+
+    bool PrometheusFileExporter::Export(const MetricsRegistry& registry)
+    {
+        const std::string text = Format(registry);
+        const std::string temporaryPath = m_path + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::trunc);
+            if (!file || !file.write(text.data(), static_cast<std::streamsize>(text.size())))
+            {
+                std::cout << "Error writing metrics to " << temporaryPath << std::endl;
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, m_path, error);
+        if (error)
+        {
+            std::cout << "Error replacing metrics file " << m_path << ": " << error.message() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    std::string PrometheusFileExporter::Format(const MetricsRegistry& registry)
+    {
+        std::string text;
+        for (const Metric* metric : registry.GetMetrics())
+        {
+            const std::string& name = metric->GetName();
+            text += "# HELP " + name + " " + metric->GetHelp() + "\n";
+            switch (metric->GetType())
+            {
+            case MetricType::Counter:
+                text += "# TYPE " + name + " counter\n" + name + " ";
+                AppendNumber(text, static_cast<double>(static_cast<const MetricCounter*>(metric)->Get()));
+                text += "\n";
+                break;
+            case MetricType::Gauge:
+                text += "# TYPE " + name + " gauge\n" + name + " ";
+                AppendNumber(text, static_cast<const MetricGauge*>(metric)->Get());
+                text += "\n";
+                break;
+            case MetricType::Histogram: {
+                const auto* histogram = static_cast<const MetricHistogram*>(metric);
+                text += "# TYPE " + name + " histogram\n";
+                // the count is read first, the buckets recorded since never exceed it by much
+                const uint64_t count = histogram->GetCount();
+                const uint64_t sum = histogram->GetSum();
+                for (int power = 0; power <= MetricHistogram::ExportedPowers; ++power)
+                {
+                    const uint64_t bound = uint64_t{ 1 } << power;
+                    text += name + "_bucket{le=\"";
+                    AppendNumber(text, static_cast<double>(bound) * histogram->GetUnit());
+                    text += "\"} ";
+                    AppendNumber(text, static_cast<double>(std::min(count, histogram->GetCountBelow(bound))));
+                    text += "\n";
+                }
+                text += name + "_bucket{le=\"+Inf\"} ";
+                AppendNumber(text, static_cast<double>(count));
+                text += "\n" + name + "_sum ";
+                AppendNumber(text, static_cast<double>(sum) * histogram->GetUnit());
+                text += "\n" + name + "_count ";
+                AppendNumber(text, static_cast<double>(count));
+                text += "\n";
+                break;
+            }
+            }
+        }
+        return text;
+    }
+
+    MetricsRegistry::~MetricsRegistry()
+    {
+        StopExport();
+    }
+
+    MetricCounter& MetricsRegistry::AddCounter(const std::string& name, const std::string& help)
+    {
+        return static_cast<MetricCounter&>(Add(std::make_unique<MetricCounter>(name, help)));
+    }
+
+    MetricGauge& MetricsRegistry::AddGauge(const std::string& name, const std::string& help)
+    {
+        return static_cast<MetricGauge&>(Add(std::make_unique<MetricGauge>(name, help)));
+    }
+
+    MetricHistogram& MetricsRegistry::AddHistogram(const std::string& name, const std::string& help, double unit)
+    {
+        return static_cast<MetricHistogram&>(Add(std::make_unique<MetricHistogram>(name, help, unit)));
+    }
+
+    const Metric* MetricsRegistry::Find(const std::string& name) const
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto metric = std::ranges::find(m_metrics, name, &Metric::GetName);
+        return metric != m_metrics.end() ? metric->get() : nullptr;
+    }
+
+    std::vector<const Metric*> MetricsRegistry::GetMetrics() const
+    {
+        std::scoped_lock lock(m_mutex);
+        std::vector<const Metric*> metrics;
+        metrics.reserve(m_metrics.size());
+        for (const auto& metric : m_metrics)
+        {
+            metrics.push_back(metric.get());
+        }
+        return metrics;
+    }
+
+    void MetricsRegistry::StartExport(std::unique_ptr<MetricsExporter> exporter, std::chrono::milliseconds interval)
+    {
+        StopExport();
+        m_exporter = std::move(exporter);
+        m_interval = interval;
+        m_exportThread = std::jthread([this](std::stop_token stopToken) { Run(stopToken); });
+    }
+
+    void MetricsRegistry::StopExport()
+    {
+        if (!m_exportThread.joinable())
+            return;
+        m_exportThread.request_stop();
+        m_wakeUp.notify_all();
+        m_exportThread.join();
+        m_exporter->Export(*this);
+        m_exporter.reset();
+    }
+
+    Metric& MetricsRegistry::Add(std::unique_ptr<Metric> metric)
+    {
+        std::scoped_lock lock(m_mutex);
+        if (std::ranges::find(m_metrics, metric->GetName(), &Metric::GetName) != m_metrics.end())
+            throw std::runtime_error("Metric " + metric->GetName() + " already exists");
+        m_metrics.push_back(std::move(metric));
+        return *m_metrics.back();
+    }
+
+    void MetricsRegistry::Run(std::stop_token stopToken)
+    {
+        while (!stopToken.stop_requested())
+        {
+            {
+                std::unique_lock lock(m_wakeUpMutex);
+                if (m_wakeUp.wait_for(lock, stopToken, m_interval, [] { return false; }) || stopToken.stop_requested())
+                    break;
+            }
+            m_exporter->Export(*this);
+        }
+    }
+
+}
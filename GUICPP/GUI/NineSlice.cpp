@@ -0,0 +1,159 @@
+#include "NineSlice.h"
+
+#include <algorithm>
+
+#include "HitMask.h"
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        // the four edges of the three columns or rows, shrinking the borders if they do not fit
+        std::array<float, 4> SliceEdges(float size, float first, float last)
+        {
+            const float borders = first + last;
+            if (borders > size && borders > 0.f)
+            {
+                const float factor = size / borders;
+                first *= factor;
+                last *= factor;
+            }
+            return { 0.f, first, size - last, size };
+        }
+
+        float MapToTextureEdges(float position, const std::array<float, 4>& edges, const std::array<float, 4>& textureEdges)
+        {
+            size_t slice = 0;
+            while (slice < 2 && position >= edges[slice + 1])
+            {
+                ++slice;
+            }
+            const float length = edges[slice + 1] - edges[slice];
+            const float ratio = length > 0.f ? (position - edges[slice]) / length : 0.f;
+            return textureEdges[slice] + ratio * (textureEdges[slice + 1] - textureEdges[slice]);
+        }
+    }
+
+    NineSlice::NineSlice()
+    {
+        UpdateGeometry();
+    }
+
+    void NineSlice::SetTexture(const sf::Texture* texture)
+    {
+        m_texture = texture;
+        UpdateGeometry();
+    }
+
+    void NineSlice::SetBorders(const NineSliceBorders& borders)
+    {
+        m_borders = borders;
+        UpdateGeometry();
+    }
+
+    void NineSlice::SetSize(const sf::Vector2f& size)
+    {
+        m_size = size;
+        UpdateGeometry();
+    }
+
+    void NineSlice::SetColor(const sf::Color& color)
+    {
+        m_color = color;
+        for (sf::Vertex& vertex : m_vertices)
+        {
+            vertex.color = color;
+        }
+    }
+
+    const sf::Texture* NineSlice::GetTexture() const
+    {
+        return m_texture;
+    }
+
+    const sf::Vector2f& NineSlice::GetSize() const
+    {
+        return m_size;
+    }
+
+    const sf::Color& NineSlice::GetColor() const
+    {
+        return m_color;
+    }
+
+    sf::FloatRect NineSlice::GetLocalBounds() const
+    {
+        return { 0.f, 0.f, m_size.x, m_size.y };
+    }
+
+    sf::FloatRect NineSlice::GetGlobalBounds() const
+    {
+        return getTransform().transformRect(GetLocalBounds());
+    }
+
+    sf::Vector2f NineSlice::MapToTexture(sf::Vector2f point) const
+    {
+        return { MapToTextureEdges(point.x, m_columns, m_textureColumns), MapToTextureEdges(point.y, m_rows, m_textureRows) };
+    }
+
+    bool NineSlice::Contains(sf::Vector2f point, const HitMask* mask) const
+    {
+        const sf::Vector2f local = getInverseTransform().transformPoint(point);
+        if (local.x < 0.f || local.y < 0.f || local.x >= m_size.x || local.y >= m_size.y)
+            return false;
+        return mask == nullptr || mask->Contains(MapToTexture(local));
+    }
+
+    const std::array<sf::Vertex, NineSlice::VertexCount>& NineSlice::GetVertices() const
+    {
+        return m_vertices;
+    }
+
+    void NineSlice::draw(sf::RenderTarget& target, sf::RenderStates states) const
+    {
+        if (m_texture == nullptr)
+            return;
+        states.transform *= getTransform();
+        states.texture = m_texture;
+        target.draw(m_vertices.data(), m_vertices.size(), sf::Triangles, states);
+    }
+
+    void NineSlice::UpdateGeometry()
+    {
+        const sf::Vector2f textureSize = m_texture != nullptr ? sf::Vector2f(m_texture->getSize()) : sf::Vector2f();
+        const float left = std::min(m_borders.left, textureSize.x);
+        const float right = std::min(m_borders.right, textureSize.x - left);
+        const float top = std::min(m_borders.top, textureSize.y);
+        const float bottom = std::min(m_borders.bottom, textureSize.y - top);
+
+        m_columns = SliceEdges(m_size.x, left, right);
+        m_rows = SliceEdges(m_size.y, top, bottom);
+        m_textureColumns = { 0.f, left, textureSize.x - right, textureSize.x };
+        m_textureRows = { 0.f, top, textureSize.y - bottom, textureSize.y };
+        const std::array<float, 4>& xs = m_columns;
+        const std::array<float, 4>& ys = m_rows;
+        const std::array<float, 4>& us = m_textureColumns;
+        const std::array<float, 4>& vs = m_textureRows;
+
+        size_t index = 0;
+        for (size_t row = 0; row < 3; ++row)
+        {
+            for (size_t column = 0; column < 3; ++column)
+            {
+                const sf::Vertex topLeft(sf::Vector2f(xs[column], ys[row]), m_color, sf::Vector2f(us[column], vs[row]));
+                const sf::Vertex topRight(sf::Vector2f(xs[column + 1], ys[row]), m_color, sf::Vector2f(us[column + 1], vs[row]));
+                const sf::Vertex bottomLeft(sf::Vector2f(xs[column], ys[row + 1]), m_color, sf::Vector2f(us[column], vs[row + 1]));
+                const sf::Vertex bottomRight(sf::Vector2f(xs[column + 1], ys[row + 1]), m_color, sf::Vector2f(us[column + 1], vs[row + 1]));
+
+                m_vertices[index++] = topLeft;
+                m_vertices[index++] = topRight;
+                m_vertices[index++] = bottomLeft;
+                m_vertices[index++] = bottomLeft;
+                m_vertices[index++] = topRight;
+                m_vertices[index++] = bottomRight;
+            }
+        }
+    }
+
+}
@@ -0,0 +1,83 @@
+#include "OverlapGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace GUICPP
+{
+
+    OverlapGrid::OverlapGrid(float cellSize) : m_cellSize(std::max(cellSize, 1.f))
+    {
+        m_buckets.fill(NoNode);
+    }
+
+    void OverlapGrid::Clear()
+    {
+        if (m_nodes.empty())
+            return;
+        m_buckets.fill(NoNode);
+        m_large = NoNode;
+        m_nodes.clear();
+    }
+
+    void OverlapGrid::SetCellSize(float cellSize)
+    {
+        m_cellSize = std::max(cellSize, 1.f);
+    }
+
+    void OverlapGrid::Add(const sf::FloatRect& rect, size_t value)
+    {
+        const CellRange cells = GetCells(rect);
+        if (cells.GetCount() > MaxCellsPerRect)
+        {
+            m_nodes.push_back({ rect, value, m_large });
+            m_large = static_cast<uint32_t>(m_nodes.size() - 1);
+            return;
+        }
+
+        for (int64_t row = cells.top; row <= cells.bottom; ++row)
+        {
+            for (int64_t column = cells.left; column <= cells.right; ++column)
+            {
+                uint32_t& bucket = m_buckets[GetBucket(column, row)];
+                m_nodes.push_back({ rect, value, bucket });
+                bucket = static_cast<uint32_t>(m_nodes.size() - 1);
+            }
+        }
+    }
+
+    bool OverlapGrid::IsEmpty() const
+    {
+        return m_nodes.empty();
+    }
+
+    bool OverlapGrid::Overlaps(const sf::FloatRect& rect) const
+    {
+        bool isOverlapping = false;
+        ForEachOverlap(rect, [&](size_t) {
+            isOverlapping = true;
+            return false;
+        });
+        return isOverlapping;
+    }
+
+    OverlapGrid::CellRange OverlapGrid::GetCells(const sf::FloatRect& rect) const
+    {
+        // normalized as sf::Rect::intersects does for negative sizes, far coordinates are clamped
+        const auto cell = [this](float coordinate) {
+            return static_cast<int64_t>(std::clamp(std::floor(coordinate / m_cellSize), -1e9f, 1e9f));
+        };
+        const float left = std::min(rect.left, rect.left + rect.width);
+        const float top = std::min(rect.top, rect.top + rect.height);
+        const float right = std::max(rect.left, rect.left + rect.width);
+        const float bottom = std::max(rect.top, rect.top + rect.height);
+        return { cell(left), cell(top), cell(right), cell(bottom) };
+    }
+
+    size_t OverlapGrid::GetBucket(int64_t column, int64_t row)
+    {
+        const uint64_t hash = static_cast<uint64_t>(column) * 73856093u ^ static_cast<uint64_t>(row) * 19349663u;
+        return static_cast<size_t>(hash) & (BucketCount - 1);
+    }
+
+}
@@ -0,0 +1,95 @@
+#include "Profiler.h"
+
+#include <algorithm>
+
+#include "Widget.h"
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        std::chrono::nanoseconds GetTotalTime(const WidgetProfile& profile)
+        {
+            // the delegates run inside HandleEvents, counting them again would count them twice
+            return profile.times[static_cast<size_t>(ProfileSection::HandleEvents)]
+                + profile.times[static_cast<size_t>(ProfileSection::Draw)];
+        }
+    }
+
+    Profiler& Profiler::GetInstance()
+    {
+        static Profiler instance;
+        return instance;
+    }
+
+    void Profiler::AddTime(const Widget* widget, ProfileSection section, std::chrono::nanoseconds time)
+    {
+        const auto index = static_cast<size_t>(section);
+        if (widget == nullptr) {
+            m_frame.times[index] += time;
+            return;
+        }
+
+        const auto [entry, isNew] = m_widgetIndices.try_emplace(widget, m_frame.widgets.size());
+        if (isNew) {
+            WidgetProfile profile;
+            profile.widget = widget;
+            profile.typeName = widget->GetTypeName();
+            m_frame.widgets.push_back(profile);
+        }
+        WidgetProfile& profile = m_frame.widgets[entry->second];
+        profile.times[index] += time;
+        ++profile.calls[index];
+    }
+
+    void Profiler::CountEvent()
+    {
+        ++m_frame.eventCount;
+    }
+
+    void Profiler::CountVisit()
+    {
+        ++m_frame.widgetsVisited;
+    }
+
+    void Profiler::EndFrame(size_t drawCalls, size_t textureSwitches)
+    {
+        m_frame.drawCalls = drawCalls;
+        m_frame.textureSwitches = textureSwitches;
+        const size_t frame = m_frame.frame + 1;
+        m_frame.frame = frame;
+        // the widget list of the old frame keeps its capacity for the next one
+        std::swap(m_lastFrame, m_frame);
+        m_frame.frame = frame;
+        m_frame.eventCount = 0;
+        m_frame.widgetsVisited = 0;
+        m_frame.drawCalls = 0;
+        m_frame.textureSwitches = 0;
+        m_frame.times = {};
+        m_frame.widgets.clear();
+        m_widgetIndices.clear();
+    }
+
+    const FrameProfile& Profiler::GetLastFrame() const
+    {
+        return m_lastFrame;
+    }
+
+    std::vector<WidgetProfile> Profiler::GetSlowestWidgets(size_t count) const
+    {
+        std::vector<WidgetProfile> widgets = m_lastFrame.widgets;
+        count = std::min(count, widgets.size());
+        std::ranges::partial_sort(widgets, widgets.begin() + static_cast<std::ptrdiff_t>(count), std::ranges::greater{}, GetTotalTime);
+        widgets.resize(count);
+        return widgets;
+    }
+
+    void Profiler::Reset()
+    {
+        m_frame = FrameProfile();
+        m_lastFrame = FrameProfile();
+        m_widgetIndices.clear();
+    }
+
+}
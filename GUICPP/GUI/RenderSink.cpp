@@ -0,0 +1,205 @@
+#include "RenderSink.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "NineSlice.h"
+#include "TextLayout.h"
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        // the shapes of a thread are turned into vertices in the same buffer, keeping its capacity
+        std::vector<sf::Vertex>& GetShapeVertices()
+        {
+            thread_local std::vector<sf::Vertex> vertices;
+            return vertices;
+        }
+
+        sf::Vector2f ComputeNormal(const sf::Vector2f& first, const sf::Vector2f& second)
+        {
+            const sf::Vector2f normal(first.y - second.y, second.x - first.x);
+            const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+            return length != 0.f ? normal / length : normal;
+        }
+    }
+
+    void RenderSink::Draw(const sf::Shape& shape, const sf::RenderStates& states)
+    {
+        const size_t pointCount = shape.getPointCount();
+        if (pointCount < 3)
+            return;
+
+        sf::RenderStates shapeStates = states;
+        shapeStates.transform *= shape.getTransform();
+        // the bounds of the points, without the outline
+        sf::Vector2f min = shape.getPoint(0);
+        sf::Vector2f max = min;
+        for (size_t i = 1; i < pointCount; ++i)
+        {
+            const sf::Vector2f point = shape.getPoint(i);
+            min.x = std::min(min.x, point.x);
+            min.y = std::min(min.y, point.y);
+            max.x = std::max(max.x, point.x);
+            max.y = std::max(max.y, point.y);
+        }
+        const sf::FloatRect bounds(min, max - min);
+        const sf::Vector2f center(bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f);
+
+        // the filling is a fan around the center of the points, as sf::Shape builds it
+        std::vector<sf::Vertex>& vertices = GetShapeVertices();
+        vertices.clear();
+        const sf::IntRect& textureRect = shape.getTextureRect();
+        const auto texCoords = [&bounds, &textureRect](const sf::Vector2f& point) {
+            const float x = bounds.width > 0.f ? (point.x - bounds.left) / bounds.width : 0.f;
+            const float y = bounds.height > 0.f ? (point.y - bounds.top) / bounds.height : 0.f;
+            return sf::Vector2f(textureRect.left + textureRect.width * x, textureRect.top + textureRect.height * y);
+        };
+        vertices.emplace_back(center, shape.getFillColor(), texCoords(center));
+        for (size_t i = 0; i <= pointCount; ++i)
+        {
+            const sf::Vector2f point = shape.getPoint(i % pointCount);
+            vertices.emplace_back(point, shape.getFillColor(), texCoords(point));
+        }
+        sf::RenderStates fillStates = shapeStates;
+        fillStates.texture = shape.getTexture();
+        Draw(vertices.data(), vertices.size(), sf::TriangleFan, fillStates);
+
+        const float thickness = shape.getOutlineThickness();
+        if (thickness == 0.f)
+            return;
+
+        // the outline is a strip along the points, pushed out along the mean of the edge normals
+        vertices.clear();
+        for (size_t i = 0; i < pointCount; ++i)
+        {
+            const sf::Vector2f previous = shape.getPoint((i + pointCount - 1) % pointCount);
+            const sf::Vector2f point = shape.getPoint(i);
+            const sf::Vector2f next = shape.getPoint((i + 1) % pointCount);
+
+            sf::Vector2f firstNormal = ComputeNormal(previous, point);
+            sf::Vector2f secondNormal = ComputeNormal(point, next);
+            if (firstNormal.x * (center.x - point.x) + firstNormal.y * (center.y - point.y) > 0.f)
+                firstNormal = -firstNormal;
+            if (secondNormal.x * (center.x - point.x) + secondNormal.y * (center.y - point.y) > 0.f)
+                secondNormal = -secondNormal;
+            const float factor = 1.f + (firstNormal.x * secondNormal.x + firstNormal.y * secondNormal.y);
+            const sf::Vector2f normal = (firstNormal + secondNormal) / factor;
+
+            vertices.emplace_back(point, shape.getOutlineColor());
+            vertices.emplace_back(point + normal * thickness, shape.getOutlineColor());
+        }
+        vertices.push_back(vertices[0]);
+        vertices.push_back(vertices[1]);
+        sf::RenderStates outlineStates = shapeStates;
+        outlineStates.texture = nullptr;
+        Draw(vertices.data(), vertices.size(), sf::TriangleStrip, outlineStates);
+    }
+
+    void RenderSink::Draw(const NineSlice& slice, const sf::RenderStates& states)
+    {
+        if (slice.GetTexture() == nullptr)
+            return;
+        sf::RenderStates sliceStates = states;
+        sliceStates.transform *= slice.getTransform();
+        sliceStates.texture = slice.GetTexture();
+        Draw(slice.GetVertices().data(), slice.GetVertices().size(), sf::Triangles, sliceStates);
+    }
+
+    void RenderSink::Draw(const TextLayout& layout, const sf::RenderStates& states)
+    {
+        const sf::VertexArray& vertices = layout.GetVertices();
+        if (vertices.getVertexCount() == 0)
+            return;
+        sf::RenderStates layoutStates = states;
+        layoutStates.texture = GetGlyphTexture(&layout.GetTexture());
+        layoutStates.shader = layout.GetShader();
+        Draw(&vertices[0], vertices.getVertexCount(), vertices.getPrimitiveType(), layoutStates);
+    }
+
+    void RenderSink::Retain(std::shared_ptr<const void>)
+    {
+    }
+
+    const sf::Texture* RenderSink::GetGlyphTexture(const sf::Texture* texture)
+    {
+        return texture;
+    }
+
+    size_t RenderSink::GetDrawCallCount() const
+    {
+        return m_drawCallCount;
+    }
+
+    size_t RenderSink::GetVertexCount() const
+    {
+        return m_vertexCount;
+    }
+
+    size_t RenderSink::GetTextureSwitchCount() const
+    {
+        return m_textureSwitchCount;
+    }
+
+    void RenderSink::ResetCounters()
+    {
+        m_drawCallCount = 0;
+        m_vertexCount = 0;
+        m_textureSwitchCount = 0;
+        m_lastTexture = nullptr;
+    }
+
+    void RenderSink::CountDraw(size_t vertexCount, const sf::Texture* texture)
+    {
+        ++m_drawCallCount;
+        m_vertexCount += vertexCount;
+        if (texture != m_lastTexture) {
+            // drawing without a texture after a textured draw unbinds it
+            if (texture != nullptr) {
+                ++m_textureSwitchCount;
+            }
+            m_lastTexture = texture;
+        }
+    }
+
+    TargetSink::TargetSink(sf::RenderTarget& target) : m_target(target)
+    {
+    }
+
+    void TargetSink::Draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states)
+    {
+        if (vertices == nullptr || count == 0)
+            return;
+        CountDraw(count, states.texture);
+        m_target.draw(vertices, count, type, states);
+    }
+
+    void TargetSink::Draw(const sf::Shape& shape, const sf::RenderStates& states)
+    {
+        const size_t pointCount = shape.getPointCount();
+        if (pointCount < 3)
+            return;
+        // the filling, then the outline
+        CountDraw(pointCount + 2, shape.getTexture());
+        if (shape.getOutlineThickness() != 0.f) {
+            CountDraw(pointCount * 2 + 2, nullptr);
+        }
+        m_target.draw(shape, states);
+    }
+
+    sf::RenderTarget& TargetSink::GetTarget() const
+    {
+        return m_target;
+    }
+
+    void NullSink::Draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType, const sf::RenderStates& states)
+    {
+        if (vertices == nullptr || count == 0)
+            return;
+        CountDraw(count, states.texture);
+    }
+
+}
@@ -0,0 +1,92 @@
+#include "RenderThread.h"
+
+#include "Tracer.h"
+
+namespace GUICPP
+{
+
+    RenderThread::RenderThread(sf::RenderWindow& window) : m_window(window), m_windowSink(window)
+    {
+        // a context can only be active on one thread
+        m_window.setActive(false);
+        m_thread = std::jthread(&RenderThread::Run, this);
+    }
+
+    RenderThread::~RenderThread()
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this] { return !m_hasFrame; });
+            m_isStopping = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+        m_window.setActive(true);
+    }
+
+    void RenderThread::SetClearColor(const sf::Color& color)
+    {
+        std::lock_guard lock(m_mutex);
+        m_clearColor = color;
+    }
+
+    DrawCommandList& RenderThread::GetRecordList()
+    {
+        return m_lists[m_recordIndex];
+    }
+
+    void RenderThread::Submit()
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this] { return !m_hasFrame; });
+            m_recordIndex = 1 - m_recordIndex;
+            m_hasFrame = true;
+        }
+        m_condition.notify_all();
+
+        // the list given back was replayed, the objects it retained can go
+        m_lists[m_recordIndex].Clear();
+    }
+
+    size_t RenderThread::GetFrameCount() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_frameCount;
+    }
+
+    void RenderThread::Run()
+    {
+        m_window.setActive(true);
+        Tracer::GetInstance().NameThread("RenderThread");
+        while (true)
+        {
+            const DrawCommandList* list = nullptr;
+            sf::Color clearColor;
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_hasFrame || m_isStopping; });
+                if (!m_hasFrame)
+                    break;
+                list = &m_lists[1 - m_recordIndex];
+                clearColor = m_clearColor;
+            }
+
+            {
+                GUICPP_TRACE_SCOPE("draw", "Replay");
+                m_window.clear(clearColor);
+                list->Replay(m_windowSink);
+                m_window.display();
+            }
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_hasFrame = false;
+                ++m_frameCount;
+            }
+            m_condition.notify_all();
+        }
+        m_window.setActive(false);
+    }
+
+}
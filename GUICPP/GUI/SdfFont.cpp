@@ -0,0 +1,240 @@
+#include "SdfFont.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "FontRegistry.h"
+#include "TextLayout.h"
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        // fragment only, SFML provides the texture coordinates and vertex colour of the fixed pipeline
+        const char* const SdfFragmentShader = R"(
+uniform sampler2D texture;
+
+void main()
+{
+    float distance = texture2D(texture, gl_TexCoord[0].xy).a;
+    float width = fwidth(distance);
+    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);
+}
+)";
+
+        constexpr unsigned int LineBlockSize = 4; ///< Opaque block at the origin of the atlas, sampled by underlines.
+
+        std::vector<sf::Uint8> GenerateDistanceField(const sf::Image& page, const sf::IntRect& source, int spread)
+        {
+            const int width = source.width + 2 * spread;
+            const int height = source.height + 2 * spread;
+            const unsigned int pageWidth = page.getSize().x;
+            const sf::Uint8* coverage = page.getPixelsPtr();
+
+            std::vector<bool> inside(static_cast<size_t>(width * height), false);
+            for (int y = 0; y < source.height; ++y)
+            {
+                for (int x = 0; x < source.width; ++x)
+                {
+                    const size_t pixel = (static_cast<size_t>(source.top + y) * pageWidth + source.left + x) * 4;
+                    inside[static_cast<size_t>((y + spread) * width + x + spread)] = coverage[pixel + 3] >= 128;
+                }
+            }
+
+            // brute force search of the nearest pixel across the outline, the spread keeps the window small
+            std::vector<sf::Uint8> pixels(static_cast<size_t>(width * height) * 4, 255);
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    const bool isInside = inside[static_cast<size_t>(y * width + x)];
+                    int nearest = (spread + 1) * (spread + 1);
+                    for (int dy = -spread; dy <= spread; ++dy)
+                    {
+                        for (int dx = -spread; dx <= spread; ++dx)
+                        {
+                            const int nx = x + dx;
+                            const int ny = y + dy;
+                            const bool isNeighbourInside = nx >= 0 && ny >= 0 && nx < width && ny < height &&
+                                                           inside[static_cast<size_t>(ny * width + nx)];
+                            if (isNeighbourInside != isInside)
+                            {
+                                nearest = std::min(nearest, dx * dx + dy * dy);
+                            }
+                        }
+                    }
+
+                    // the outline lies halfway between the two pixels
+                    const float distance = std::min(std::sqrt(static_cast<float>(nearest)) - 0.5f, static_cast<float>(spread));
+                    const float signedDistance = isInside ? distance : -distance;
+                    const float value = std::clamp(0.5f + signedDistance / (2.f * static_cast<float>(spread)), 0.f, 1.f);
+                    pixels[static_cast<size_t>(y * width + x) * 4 + 3] = static_cast<sf::Uint8>(value * 255.f + 0.5f);
+                }
+            }
+            return pixels;
+        }
+    }
+
+    SdfFont::SdfFont(std::shared_ptr<const sf::Font> font, unsigned int baseSize, unsigned int spread, unsigned int atlasSize,
+                     bool bold)
+        : m_font(std::move(font)), m_baseSize(baseSize), m_spread(std::max(spread, 1u)), m_isBold(bold),
+          m_cursor(LineBlockSize + 1, 0)
+    {
+        if (!m_font)
+            throw std::runtime_error("SdfFont needs a font");
+        if (!m_texture.create(atlasSize, atlasSize))
+            throw std::runtime_error("Error creating the SDF atlas");
+        m_texture.setSmooth(true);
+
+        // fully inside the outline, so lines drawn from it are opaque
+        const std::vector<sf::Uint8> block(LineBlockSize * LineBlockSize * 4, 255);
+        m_texture.update(block.data(), LineBlockSize, LineBlockSize, 0, 0);
+        m_rowHeight = LineBlockSize;
+
+        if (sf::Shader::isAvailable() && m_shader.loadFromMemory(SdfFragmentShader, sf::Shader::Fragment))
+        {
+            m_shader.setUniform("texture", sf::Shader::CurrentTexture);
+            m_isAvailable = true;
+        }
+        else
+        {
+            std::cout << "SDF text is not available, shaders are not supported" << std::endl;
+        }
+
+        AddGlyphs(FontRegistry::GetBasicLatin());
+    }
+
+    SdfFont::~SdfFont()
+    {
+        // the cached layouts point at the atlas texture and shader
+        TextLayout::ForgetFont(*this);
+    }
+
+    bool SdfFont::IsAvailable() const
+    {
+        return m_isAvailable;
+    }
+
+    void SdfFont::AddGlyphs(const sf::String& characters)
+    {
+        std::vector<sf::Uint32> missing;
+        for (const sf::Uint32 character : characters)
+        {
+            if (!m_glyphs.contains(character) && std::ranges::find(missing, character) == missing.end())
+            {
+                missing.push_back(character);
+            }
+        }
+        if (missing.empty())
+            return;
+
+        // rasterize every glyph first, so the glyph page is downloaded once
+        for (const sf::Uint32 character : missing)
+        {
+            m_font->getGlyph(character, m_baseSize, m_isBold);
+        }
+        const sf::Image page = m_font->getTexture(m_baseSize).copyToImage();
+        const int spread = static_cast<int>(m_spread);
+
+        for (const sf::Uint32 character : missing)
+        {
+            sf::Glyph glyph = m_font->getGlyph(character, m_baseSize, m_isBold);
+            const sf::IntRect source = glyph.textureRect;
+            glyph.textureRect = sf::IntRect();
+
+            if (source.width > 0 && source.height > 0)
+            {
+                const sf::Vector2u size(static_cast<unsigned int>(source.width + 2 * spread),
+                                        static_cast<unsigned int>(source.height + 2 * spread));
+                sf::Vector2u position;
+                if (Allocate(size, position))
+                {
+                    const std::vector<sf::Uint8> pixels = GenerateDistanceField(page, source, spread);
+                    m_texture.update(pixels.data(), size.x, size.y, position.x, position.y);
+
+                    glyph.textureRect = sf::IntRect(static_cast<int>(position.x), static_cast<int>(position.y),
+                                                    static_cast<int>(size.x), static_cast<int>(size.y));
+                    glyph.bounds = sf::FloatRect(glyph.bounds.left - static_cast<float>(spread),
+                                                 glyph.bounds.top - static_cast<float>(spread),
+                                                 glyph.bounds.width + static_cast<float>(2 * spread),
+                                                 glyph.bounds.height + static_cast<float>(2 * spread));
+                }
+                else
+                {
+                    glyph.bounds = sf::FloatRect();
+                    if (!m_isFull)
+                        std::cout << "SDF atlas is full, some glyphs will not be drawn" << std::endl;
+                    m_isFull = true;
+                }
+            }
+            m_glyphs.emplace(character, glyph);
+        }
+    }
+
+    const sf::Glyph& SdfFont::GetGlyph(sf::Uint32 character)
+    {
+        auto glyph = m_glyphs.find(character);
+        if (glyph == m_glyphs.end())
+        {
+            AddGlyphs(sf::String(character));
+            glyph = m_glyphs.find(character);
+        }
+        return glyph->second;
+    }
+
+    const sf::Font& SdfFont::GetFont() const
+    {
+        return *m_font;
+    }
+
+    unsigned int SdfFont::GetBaseSize() const
+    {
+        return m_baseSize;
+    }
+
+    bool SdfFont::IsBold() const
+    {
+        return m_isBold;
+    }
+
+    const sf::Texture& SdfFont::GetTexture() const
+    {
+        return m_texture;
+    }
+
+    const sf::Shader* SdfFont::GetShader() const
+    {
+        return m_isAvailable ? &m_shader : nullptr;
+    }
+
+    size_t SdfFont::GetMemoryBytes() const
+    {
+        const sf::Vector2u size = m_texture.getSize();
+        return static_cast<size_t>(size.x) * size.y * 4;
+    }
+
+    bool SdfFont::Allocate(sf::Vector2u size, sf::Vector2u& position)
+    {
+        const sf::Vector2u atlasSize = m_texture.getSize();
+
+        // one pixel apart, so filtering does not blend neighbouring glyphs
+        if (m_cursor.x + size.x > atlasSize.x)
+        {
+            m_cursor = sf::Vector2u(0, m_cursor.y + m_rowHeight + 1);
+            m_rowHeight = 0;
+        }
+        if (m_cursor.x + size.x > atlasSize.x || m_cursor.y + size.y > atlasSize.y)
+            return false;
+
+        position = m_cursor;
+        m_cursor.x += size.x + 1;
+        m_rowHeight = std::max(m_rowHeight, size.y);
+        return true;
+    }
+
+}
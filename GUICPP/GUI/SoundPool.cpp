@@ -0,0 +1,127 @@
+#include "SoundPool.h"
+
+#include <algorithm>
+
+namespace GUICPP
+{
+
+    std::shared_ptr<const SoundSet> SoundSet::Merge(const std::shared_ptr<const SoundSet>& base,
+                                                    const std::shared_ptr<sf::SoundBuffer>& press,
+                                                    const std::shared_ptr<sf::SoundBuffer>& release,
+                                                    const std::shared_ptr<sf::SoundBuffer>& startHover,
+                                                    const std::shared_ptr<sf::SoundBuffer>& endHover)
+    {
+        static std::vector<std::weak_ptr<const SoundSet>> internedSets;
+
+        SoundSet set;
+        if (base)
+        {
+            set.buffers = base->buffers;
+        }
+        const std::shared_ptr<sf::SoundBuffer>* replacements[] = { &press, &release, &startHover, &endHover };
+        for (size_t i = 0; i < set.buffers.size(); ++i)
+        {
+            if (*replacements[i])
+            {
+                set.buffers[i] = *replacements[i];
+            }
+        }
+
+        std::erase_if(internedSets, [](const auto& entry) { return entry.expired(); });
+        for (const auto& entry : internedSets)
+        {
+            auto interned = entry.lock();
+            if (interned && interned->buffers == set.buffers)
+            {
+                return interned;
+            }
+        }
+
+        auto interned = std::make_shared<const SoundSet>(std::move(set));
+        internedSets.push_back(interned);
+        return interned;
+    }
+
+    SoundPool& SoundPool::GetInstance()
+    {
+        static SoundPool instance;
+        return instance;
+    }
+
+    SoundPool::SoundPool() : m_voices(16), m_voiceHandles(16, NoVoice)
+    {
+    }
+
+    SoundPool::Handle SoundPool::Play(const sf::SoundBuffer* buffer)
+    {
+        if (buffer == nullptr || m_voices.empty())
+            return NoVoice;
+
+        for (size_t i = 0; i < m_voices.size(); ++i)
+        {
+            const size_t index = (m_nextVoice + i) % m_voices.size();
+            sf::Sound& voice = m_voices[index];
+            if (voice.getStatus() == sf::Sound::Playing)
+                continue;
+
+            if (voice.getBuffer() != buffer)
+            {
+                voice.setBuffer(*buffer);
+            }
+            voice.play();
+            m_nextVoice = (index + 1) % m_voices.size();
+            m_voiceHandles[index] = ++m_lastHandle;
+            return m_lastHandle;
+        }
+
+        ++m_droppedCount;
+        return NoVoice;
+    }
+
+    bool SoundPool::Stop(Handle handle)
+    {
+        if (handle == NoVoice)
+            return false;
+
+        // a voice reused by a later play has another handle, the later play is left alone
+        const auto voiceHandle = std::ranges::find(m_voiceHandles, handle);
+        if (voiceHandle == m_voiceHandles.end())
+            return false;
+
+        sf::Sound& voice = m_voices[static_cast<size_t>(voiceHandle - m_voiceHandles.begin())];
+        if (voice.getStatus() != sf::Sound::Playing)
+            return false;
+        voice.stop();
+        return true;
+    }
+
+    void SoundPool::SetVoiceCount(size_t count)
+    {
+        m_voices.clear();
+        m_voices.resize(count);
+        m_voiceHandles.assign(count, NoVoice);
+        m_nextVoice = 0;
+    }
+
+    size_t SoundPool::GetVoiceCount() const
+    {
+        return m_voices.size();
+    }
+
+    size_t SoundPool::GetActiveVoiceCount() const
+    {
+        size_t count = 0;
+        for (const auto& voice : m_voices)
+        {
+            if (voice.getStatus() == sf::Sound::Playing)
+                ++count;
+        }
+        return count;
+    }
+
+    size_t SoundPool::GetDroppedCount() const
+    {
+        return m_droppedCount;
+    }
+
+}
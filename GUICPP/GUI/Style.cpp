@@ -0,0 +1,288 @@
+#include "Style.h"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include "AssetCache.h"
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        sf::Color Shade(const sf::Color& color, float factor)
+        {
+            return sf::Color(static_cast<sf::Uint8>(static_cast<float>(color.r) * factor),
+                             static_cast<sf::Uint8>(static_cast<float>(color.g) * factor),
+                             static_cast<sf::Uint8>(static_cast<float>(color.b) * factor),
+                             color.a);
+        }
+
+        void CombineHash(size_t& seed, size_t value)
+        {
+            seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        }
+
+        // the live entries are kept, the expired ones are erased once the table doubled since the last purge
+        template <typename Map>
+        void PurgeExpired(Map& interned, size_t& purgeSize)
+        {
+            if (interned.size() < purgeSize)
+                return;
+            std::erase_if(interned, [](const auto& entry) { return entry.second.expired(); });
+            purgeSize = std::max<size_t>(64, interned.size() * 2);
+        }
+    }
+
+    Style::Key::Key(const Desc& desc)
+        : bodyColor(desc.bodyColor.toInteger())
+        , accentColor(desc.accentColor.toInteger())
+        , hoverShade(desc.hoverShade)
+        , pressedShade(desc.pressedShade)
+        , borders(desc.borders)
+        , font(desc.font)
+        , sounds(desc.sounds.get())
+    {
+        for (size_t part = 0; part < PartCount; ++part)
+        {
+            for (size_t state = 0; state < StateCount; ++state)
+            {
+                textures[part][state] = desc.textures[part][state].get();
+            }
+        }
+    }
+
+    bool Style::Key::operator==(const Key& other) const
+    {
+        return bodyColor == other.bodyColor && accentColor == other.accentColor
+            && hoverShade == other.hoverShade && pressedShade == other.pressedShade
+            && textures == other.textures && borders == other.borders && font == other.font && sounds == other.sounds;
+    }
+
+    size_t Style::KeyHash::operator()(const Key& key) const
+    {
+        size_t seed = 0;
+        CombineHash(seed, key.bodyColor);
+        CombineHash(seed, key.accentColor);
+        CombineHash(seed, std::hash<float>()(key.hoverShade));
+        CombineHash(seed, std::hash<float>()(key.pressedShade));
+        for (const auto& textures : key.textures)
+        {
+            for (const sf::Texture* texture : textures)
+            {
+                CombineHash(seed, std::hash<const sf::Texture*>()(texture));
+            }
+        }
+        for (const NineSliceBorders& borders : key.borders)
+        {
+            for (const float border : { borders.left, borders.top, borders.right, borders.bottom })
+            {
+                CombineHash(seed, std::hash<float>()(border));
+            }
+        }
+        CombineHash(seed, std::hash<const sf::Font*>()(key.font));
+        CombineHash(seed, std::hash<const SoundSet*>()(key.sounds));
+        return seed;
+    }
+
+    bool Style::Desc::operator==(const Desc& other) const
+    {
+        return bodyColor == other.bodyColor && accentColor == other.accentColor
+            && hoverShade == other.hoverShade && pressedShade == other.pressedShade
+            && textures == other.textures && borders == other.borders && font == other.font && sounds == other.sounds;
+    }
+
+    Style::Style(const Desc& desc) : m_desc(desc)
+    {
+        const sf::Color baseColors[PartCount] = { desc.bodyColor, desc.accentColor };
+        for (size_t part = 0; part < PartCount; ++part)
+        {
+            const sf::Color& base = baseColors[part];
+            auto& colors = m_palette[part];
+            colors[static_cast<size_t>(StyleState::Default)] = base;
+            colors[static_cast<size_t>(StyleState::Hover)] = Shade(base, desc.hoverShade);
+            colors[static_cast<size_t>(StyleState::Pressed)] = Shade(base, desc.pressedShade);
+            colors[static_cast<size_t>(StyleState::Checked)] = base;
+            colors[static_cast<size_t>(StyleState::CheckedHover)] = Shade(base, desc.hoverShade);
+        }
+    }
+
+    std::shared_ptr<const Style> Style::Create(const Desc& desc)
+    {
+        // keyed without ownership, the textures and sounds of an expired style are released with it
+        static std::unordered_map<Key, std::weak_ptr<const Style>, KeyHash> internedStyles;
+        static size_t purgeSize = 64;
+
+        auto& entry = internedStyles[Key(desc)];
+        if (auto interned = entry.lock())
+        {
+            return interned;
+        }
+
+        auto style = std::make_shared<const Style>(desc);
+        entry = style;
+        PurgeExpired(internedStyles, purgeSize);
+        return style;
+    }
+
+    const Style::Desc& Style::GetDesc() const
+    {
+        return m_desc;
+    }
+
+    const sf::Color& Style::GetColor(StylePart part, StyleState state) const
+    {
+        return m_palette[static_cast<size_t>(part)][static_cast<size_t>(state)];
+    }
+
+    const sf::Texture* Style::GetTexture(StylePart part, StyleState state) const
+    {
+        const auto& textures = m_desc.textures[static_cast<size_t>(part)];
+        if (const auto& texture = textures[static_cast<size_t>(state)])
+        {
+            return texture.get();
+        }
+        return textures[static_cast<size_t>(StyleState::Default)].get();
+    }
+
+    const NineSliceBorders& Style::GetBorders(StylePart part) const
+    {
+        return m_desc.borders[static_cast<size_t>(part)];
+    }
+
+    const sf::Font* Style::GetFont() const
+    {
+        return m_desc.font;
+    }
+
+    const SoundSet* Style::GetSounds() const
+    {
+        return m_desc.sounds.get();
+    }
+
+    size_t Style::GetMemoryBytes() const
+    {
+        size_t bytes = sizeof(Style);
+        for (const auto& textures : m_desc.textures)
+        {
+            for (const auto& texture : textures)
+            {
+                bytes += AssetCache::GetTextureShare(texture);
+            }
+        }
+        return bytes;
+    }
+
+    bool StyleOverrides::IsEmpty() const
+    {
+        return *this == StyleOverrides();
+    }
+
+    void StyleOverrides::ApplyTo(Style::Desc& desc) const
+    {
+        if (bodyColor)
+        {
+            desc.bodyColor = *bodyColor;
+        }
+        if (accentColor)
+        {
+            desc.accentColor = *accentColor;
+        }
+        for (size_t part = 0; part < Style::PartCount; ++part)
+        {
+            for (size_t state = 0; state < Style::StateCount; ++state)
+            {
+                if (textures[part][state])
+                {
+                    desc.textures[part][state] = textures[part][state];
+                }
+            }
+        }
+    }
+
+    StyleSlot::StyleSlot(std::shared_ptr<const Style> style) : m_style(std::move(style))
+    {
+    }
+
+    std::shared_ptr<StyleSlot> StyleSlot::For(const std::shared_ptr<const Style>& style)
+    {
+        static std::unordered_map<const Style*, std::weak_ptr<StyleSlot>> internedSlots;
+        static size_t purgeSize = 64;
+
+        // the slot keeps its style alive, a live slot found at the address holds this very style
+        auto& entry = internedSlots[style.get()];
+        if (auto interned = entry.lock(); interned && interned->m_style == style)
+        {
+            return interned;
+        }
+
+        auto slot = std::make_shared<StyleSlot>(style);
+        entry = slot;
+        PurgeExpired(internedSlots, purgeSize);
+        return slot;
+    }
+
+    const Style& StyleSlot::Get() const
+    {
+        return *m_style;
+    }
+
+    const std::shared_ptr<const Style>& StyleSlot::GetShared() const
+    {
+        return m_style;
+    }
+
+    void StyleSlot::Set(std::shared_ptr<const Style> style)
+    {
+        m_style = std::move(style);
+    }
+
+    Theme& Theme::GetDefault()
+    {
+        static Theme theme = [] {
+            Theme defaultTheme;
+
+            Style::Desc button;
+            defaultTheme.SetStyle("Button", Style::Create(button));
+            defaultTheme.SetStyle("BitmapButton", Style::Create(button));
+            defaultTheme.SetStyle("CheckBox", Style::Create(button));
+            defaultTheme.SetStyle("BitmapCheckBox", Style::Create(button));
+
+            Style::Desc slider;
+            slider.accentColor = sf::Color(191, 191, 191);
+            slider.hoverShade = 0.925f;
+            slider.pressedShade = 0.925f;
+            defaultTheme.SetStyle("Slider", Style::Create(slider));
+
+            slider.accentColor = sf::Color::White;
+            defaultTheme.SetStyle("BitmapSlider", Style::Create(slider));
+            return defaultTheme;
+        }();
+        return theme;
+    }
+
+    std::shared_ptr<StyleSlot> Theme::GetSlot(const std::string& typeName)
+    {
+        auto& slot = m_slots[typeName];
+        if (!slot)
+        {
+            slot = std::make_shared<StyleSlot>(Style::Create(Style::Desc()));
+        }
+        return slot;
+    }
+
+    void Theme::SetStyle(const std::string& typeName, std::shared_ptr<const Style> style)
+    {
+        GetSlot(typeName)->Set(std::move(style));
+    }
+
+    void Theme::Apply(const Theme& other)
+    {
+        for (const auto& [typeName, slot] : other.m_slots)
+        {
+            SetStyle(typeName, slot->GetShared());
+        }
+    }
+
+}
@@ -0,0 +1,79 @@
+#include "TextBatch.h"
+
+#include <algorithm>
+
+namespace GUICPP
+{
+
+    void TextBatch::Add(const TextLayout& layout, const sf::Transform& transform)
+    {
+        const sf::VertexArray& vertices = layout.GetVertices();
+        const size_t count = vertices.getVertexCount();
+        if (count == 0)
+            return;
+
+        const sf::Texture* texture = &layout.GetTexture();
+        const sf::Shader* shader = layout.GetShader();
+        auto page = std::ranges::find_if(m_pages, [&](const Page& candidate) {
+            return candidate.texture == texture && candidate.shader == shader;
+        });
+        if (page == m_pages.end())
+        {
+            m_pages.push_back({ texture, shader, {} });
+            page = std::prev(m_pages.end());
+        }
+
+        sf::Vector2f min = transform.transformPoint(vertices[0].position);
+        sf::Vector2f max = min;
+        for (size_t i = 0; i < count; ++i)
+        {
+            sf::Vertex vertex = vertices[i];
+            vertex.position = transform.transformPoint(vertex.position);
+            page->vertices.push_back(vertex);
+            min.x = std::min(min.x, vertex.position.x);
+            min.y = std::min(min.y, vertex.position.y);
+            max.x = std::max(max.x, vertex.position.x);
+            max.y = std::max(max.y, vertex.position.y);
+        }
+        m_textBounds.Add({ min, max - min }, 0);
+    }
+
+    bool TextBatch::Overlaps(const sf::FloatRect& bounds) const
+    {
+        return m_textBounds.Overlaps(bounds);
+    }
+
+    void TextBatch::Flush(RenderSink& sink, sf::RenderStates states)
+    {
+        // the vertices are already transformed
+        states.transform = sf::Transform::Identity;
+        m_lastDrawCallCount = 0;
+        for (Page& page : m_pages)
+        {
+            if (page.vertices.empty())
+                continue;
+            states.texture = sink.GetGlyphTexture(page.texture);
+            states.shader = page.shader;
+            sink.Draw(page.vertices.data(), page.vertices.size(), sf::Triangles, states);
+            page.vertices.clear();
+            ++m_lastDrawCallCount;
+        }
+        m_textBounds.Clear();
+    }
+
+    size_t TextBatch::GetVertexCount() const
+    {
+        size_t count = 0;
+        for (const Page& page : m_pages)
+        {
+            count += page.vertices.size();
+        }
+        return count;
+    }
+
+    size_t TextBatch::GetLastDrawCallCount() const
+    {
+        return m_lastDrawCallCount;
+    }
+
+}
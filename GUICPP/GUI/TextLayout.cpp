@@ -0,0 +1,359 @@
+#include "TextLayout.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <list>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        std::atomic<uint64_t> glyphRevision{ 0 };
+
+        // the font is an sf::Font or an SdfFont
+        using LayoutKey = std::tuple<std::basic_string<sf::Uint32>, const void*, unsigned int, sf::Uint32, sf::Uint32>;
+
+        struct LayoutCache
+        {
+            struct Entry
+            {
+                LayoutKey key;
+                std::weak_ptr<const void> font; ///< Expired once the font is released, its address may then be reused.
+                std::shared_ptr<const TextLayout> layout;
+            };
+
+            std::list<Entry> entries; ///< Most recently used first.
+            std::map<LayoutKey, decltype(entries)::iterator> index;
+            size_t capacity = 1024;
+
+            template <typename Create>
+            std::shared_ptr<const TextLayout> Find(LayoutKey key, const std::shared_ptr<const void>& font, const Create& create)
+            {
+                if (const auto found = index.find(key); found != index.end())
+                {
+                    if (!found->second->font.expired())
+                    {
+                        entries.splice(entries.begin(), entries, found->second);
+                        return found->second->layout;
+                    }
+                    // laid out with a released font, its glyph page is gone
+                    entries.erase(found->second);
+                    index.erase(found);
+                }
+
+                auto layout = create();
+                entries.push_front({ key, font, layout });
+                index.emplace(std::move(key), entries.begin());
+                Trim();
+                return layout;
+            }
+
+            void Forget(const void* font)
+            {
+                for (auto entry = entries.begin(); entry != entries.end();)
+                {
+                    if (std::get<1>(entry->key) == font)
+                    {
+                        index.erase(entry->key);
+                        entry = entries.erase(entry);
+                    }
+                    else
+                    {
+                        ++entry;
+                    }
+                }
+            }
+
+            void Trim()
+            {
+                while (entries.size() > capacity)
+                {
+                    index.erase(entries.back().key);
+                    entries.pop_back();
+                }
+            }
+        };
+
+        LayoutCache& GetCache()
+        {
+            static LayoutCache cache;
+            return cache;
+        }
+
+        void AddGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph,
+                          float italicShear, float padding)
+        {
+            const float left = glyph.bounds.left - padding;
+            const float top = glyph.bounds.top - padding;
+            const float right = glyph.bounds.left + glyph.bounds.width + padding;
+            const float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+
+            const float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+            const float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+            const float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+            const float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+
+            vertices.append(sf::Vertex(sf::Vector2f(position.x + left - italicShear * top, position.y + top), color, sf::Vector2f(u1, v1)));
+            vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top, position.y + top), color, sf::Vector2f(u2, v1)));
+            vertices.append(sf::Vertex(sf::Vector2f(position.x + left - italicShear * bottom, position.y + bottom), color, sf::Vector2f(u1, v2)));
+            vertices.append(sf::Vertex(sf::Vector2f(position.x + left - italicShear * bottom, position.y + bottom), color, sf::Vector2f(u1, v2)));
+            vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top, position.y + top), color, sf::Vector2f(u2, v1)));
+            vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom, position.y + bottom), color, sf::Vector2f(u2, v2)));
+        }
+
+        void AddLine(sf::VertexArray& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness)
+        {
+            // sampled from an opaque pixel at (1, 1), which both the glyph pages and the SDF atlas have
+            const float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
+            const float bottom = top + std::floor(thickness + 0.5f);
+
+            vertices.append(sf::Vertex(sf::Vector2f(0, top), color, sf::Vector2f(1, 1)));
+            vertices.append(sf::Vertex(sf::Vector2f(lineLength, top), color, sf::Vector2f(1, 1)));
+            vertices.append(sf::Vertex(sf::Vector2f(0, bottom), color, sf::Vector2f(1, 1)));
+            vertices.append(sf::Vertex(sf::Vector2f(0, bottom), color, sf::Vector2f(1, 1)));
+            vertices.append(sf::Vertex(sf::Vector2f(lineLength, top), color, sf::Vector2f(1, 1)));
+            vertices.append(sf::Vertex(sf::Vector2f(lineLength, bottom), color, sf::Vector2f(1, 1)));
+        }
+
+        /**
+         * @brief Glyphs of an sf::Font rasterized at the character size.
+         */
+        struct BitmapGlyphs
+        {
+            const sf::Font& font;
+            unsigned int characterSize;
+            bool isBold;
+
+            // same padding as sf::Text, so the glyphs are not clipped by texture filtering
+            static constexpr float Padding = 1.f;
+
+            [[nodiscard]] sf::Glyph GetGlyph(sf::Uint32 character) const { return font.getGlyph(character, characterSize, isBold); }
+            [[nodiscard]] float GetKerning(sf::Uint32 first, sf::Uint32 second) const { return font.getKerning(first, second, characterSize, isBold); }
+            [[nodiscard]] float GetLineSpacing() const { return font.getLineSpacing(characterSize); }
+            [[nodiscard]] float GetUnderlinePosition() const { return font.getUnderlinePosition(characterSize); }
+            [[nodiscard]] float GetUnderlineThickness() const { return font.getUnderlineThickness(characterSize); }
+        };
+
+        /**
+         * @brief Glyphs of an SDF atlas, scaled from its base size to the character size.
+         */
+        struct SdfGlyphs
+        {
+            SdfFont& font;
+            float scale;
+
+            // the spread already surrounds the glyphs
+            static constexpr float Padding = 0.f;
+
+            [[nodiscard]] sf::Glyph GetGlyph(sf::Uint32 character) const
+            {
+                sf::Glyph glyph = font.GetGlyph(character);
+                glyph.advance *= scale;
+                glyph.bounds = sf::FloatRect(glyph.bounds.left * scale, glyph.bounds.top * scale,
+                                             glyph.bounds.width * scale, glyph.bounds.height * scale);
+                return glyph;
+            }
+            [[nodiscard]] float GetKerning(sf::Uint32 first, sf::Uint32 second) const
+            {
+                return font.GetFont().getKerning(first, second, font.GetBaseSize(), font.IsBold()) * scale;
+            }
+            [[nodiscard]] float GetLineSpacing() const { return font.GetFont().getLineSpacing(font.GetBaseSize()) * scale; }
+            [[nodiscard]] float GetUnderlinePosition() const { return font.GetFont().getUnderlinePosition(font.GetBaseSize()) * scale; }
+            [[nodiscard]] float GetUnderlineThickness() const { return font.GetFont().getUnderlineThickness(font.GetBaseSize()) * scale; }
+        };
+
+        template <typename Glyphs>
+        sf::FloatRect LayOut(const Glyphs& glyphs, const sf::String& string, unsigned int characterSize, const sf::Color& color,
+                             sf::Uint32 style, sf::VertexArray& vertices)
+        {
+            if (string.isEmpty())
+                return {};
+
+            const bool isUnderlined = (style & sf::Text::Underlined) != 0;
+            const bool isStrikeThrough = (style & sf::Text::StrikeThrough) != 0;
+            const float italicShear = (style & sf::Text::Italic) != 0 ? 0.209f : 0.f; // 12 degrees, as sf::Text
+            const float underlineOffset = glyphs.GetUnderlinePosition();
+            const float underlineThickness = glyphs.GetUnderlineThickness();
+
+            const sf::FloatRect xBounds = glyphs.GetGlyph(U'x').bounds;
+            const float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+
+            const float whitespaceWidth = glyphs.GetGlyph(U' ').advance;
+            const float lineSpacing = glyphs.GetLineSpacing();
+
+            float x = 0.f;
+            float y = static_cast<float>(characterSize);
+            float minX = static_cast<float>(characterSize);
+            float minY = static_cast<float>(characterSize);
+            float maxX = 0.f;
+            float maxY = 0.f;
+            sf::Uint32 previous = 0;
+
+            for (const sf::Uint32 current : string)
+            {
+                if (current == U'\r')
+                    continue;
+
+                x += glyphs.GetKerning(previous, current);
+
+                if (current == U'\n' && previous != U'\n')
+                {
+                    if (isUnderlined)
+                        AddLine(vertices, x, y, color, underlineOffset, underlineThickness);
+                    if (isStrikeThrough)
+                        AddLine(vertices, x, y, color, strikeThroughOffset, underlineThickness);
+                }
+                previous = current;
+
+                if (current == U' ' || current == U'\n' || current == U'\t')
+                {
+                    minX = std::min(minX, x);
+                    minY = std::min(minY, y);
+
+                    switch (current)
+                    {
+                    case U' ':
+                        x += whitespaceWidth;
+                        break;
+                    case U'\t':
+                        x += whitespaceWidth * 4;
+                        break;
+                    default:
+                        y += lineSpacing;
+                        x = 0;
+                        break;
+                    }
+
+                    maxX = std::max(maxX, x);
+                    maxY = std::max(maxY, y);
+                    continue;
+                }
+
+                const sf::Glyph glyph = glyphs.GetGlyph(current);
+                AddGlyphQuad(vertices, sf::Vector2f(x, y), color, glyph, italicShear, Glyphs::Padding);
+
+                const float left = glyph.bounds.left;
+                const float top = glyph.bounds.top;
+                const float right = glyph.bounds.left + glyph.bounds.width;
+                const float bottom = glyph.bounds.top + glyph.bounds.height;
+                minX = std::min(minX, x + left - italicShear * bottom);
+                maxX = std::max(maxX, x + right - italicShear * top);
+                minY = std::min(minY, y + top);
+                maxY = std::max(maxY, y + bottom);
+
+                x += glyph.advance;
+            }
+
+            if (x > 0)
+            {
+                if (isUnderlined)
+                    AddLine(vertices, x, y, color, underlineOffset, underlineThickness);
+                if (isStrikeThrough)
+                    AddLine(vertices, x, y, color, strikeThroughOffset, underlineThickness);
+            }
+
+            return { minX, minY, maxX - minX, maxY - minY };
+        }
+    }
+
+    std::shared_ptr<const TextLayout> TextLayout::Get(const sf::String& string, const std::shared_ptr<const sf::Font>& font,
+                                                      unsigned int characterSize, const sf::Color& color, sf::Uint32 style)
+    {
+        return GetCache().Find(LayoutKey(string.toUtf32(), font.get(), characterSize, color.toInteger(), style), font, [&] {
+            return std::make_shared<const TextLayout>(string, *font, characterSize, color, style);
+        });
+    }
+
+    std::shared_ptr<const TextLayout> TextLayout::Get(const sf::String& string, const std::shared_ptr<SdfFont>& font,
+                                                      unsigned int characterSize, const sf::Color& color, sf::Uint32 style)
+    {
+        return GetCache().Find(LayoutKey(string.toUtf32(), font.get(), characterSize, color.toInteger(), style), font, [&] {
+            return std::make_shared<const TextLayout>(string, *font, characterSize, color, style);
+        });
+    }
+
+    void TextLayout::ForgetFont(const SdfFont& font)
+    {
+        GetCache().Forget(&font);
+    }
+
+    void TextLayout::SetCacheCapacity(size_t capacity)
+    {
+        LayoutCache& cache = GetCache();
+        cache.capacity = capacity;
+        cache.Trim();
+    }
+
+    size_t TextLayout::GetCacheSize()
+    {
+        return GetCache().entries.size();
+    }
+
+    uint64_t TextLayout::GetGlyphRevision()
+    {
+        return glyphRevision.load(std::memory_order_relaxed);
+    }
+
+    void TextLayout::ReviseGlyphs()
+    {
+        glyphRevision.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    TextLayout::TextLayout(const sf::String& string, const sf::Font& font, unsigned int characterSize, const sf::Color& color,
+                           sf::Uint32 style)
+        : m_texture(&font.getTexture(characterSize)), m_vertices(sf::Triangles)
+    {
+        const BitmapGlyphs glyphs{ font, characterSize, (style & sf::Text::Bold) != 0 };
+        m_bounds = LayOut(glyphs, string, characterSize, color, style, m_vertices);
+        ReviseGlyphs();
+    }
+
+    TextLayout::TextLayout(const sf::String& string, SdfFont& font, unsigned int characterSize, const sf::Color& color,
+                           sf::Uint32 style)
+        : m_texture(&font.GetTexture()), m_shader(font.GetShader()), m_vertices(sf::Triangles)
+    {
+        const SdfGlyphs glyphs{ font, static_cast<float>(characterSize) / static_cast<float>(font.GetBaseSize()) };
+        m_bounds = LayOut(glyphs, string, characterSize, color, style, m_vertices);
+        ReviseGlyphs();
+    }
+
+    void TextLayout::Draw(sf::RenderTarget& target, sf::RenderStates states) const
+    {
+        if (m_vertices.getVertexCount() == 0)
+            return;
+        states.texture = m_texture;
+        states.shader = m_shader;
+        target.draw(m_vertices, states);
+    }
+
+    const sf::VertexArray& TextLayout::GetVertices() const
+    {
+        return m_vertices;
+    }
+
+    const sf::Texture& TextLayout::GetTexture() const
+    {
+        return *m_texture;
+    }
+
+    const sf::Shader* TextLayout::GetShader() const
+    {
+        return m_shader;
+    }
+
+    const sf::FloatRect& TextLayout::GetBounds() const
+    {
+        return m_bounds;
+    }
+
+    size_t TextLayout::GetMemoryBytes() const
+    {
+        return sizeof(TextLayout) + m_vertices.getVertexCount() * sizeof(sf::Vertex);
+    }
+
+}
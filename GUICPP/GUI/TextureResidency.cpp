@@ -0,0 +1,90 @@
+#include "TextureResidency.h"
+
+#include <algorithm>
+
+#include "AssetCache.h"
+#include "Group.h"
+#include "Widget.h"
+
+namespace GUICPP
+{
+
+    TextureResidency::TextureResidency() : m_frame(0), m_budget(0), m_residentBytes(0), m_evictionCount(0), m_reloadCount(0)
+    {
+    }
+
+    void TextureResidency::SetBudget(size_t bytes)
+    {
+        m_budget = bytes;
+    }
+
+    size_t TextureResidency::GetBudget() const
+    {
+        return m_budget;
+    }
+
+    void TextureResidency::Update(const std::vector<std::shared_ptr<Group>>& groups)
+    {
+        ++m_frame;
+
+        m_candidates.clear();
+        for (const auto& group : groups)
+        {
+            Visit(*group, true, m_candidates);
+        }
+
+        const AssetCache& cache = AssetCache::GetInstance();
+        m_residentBytes = cache.GetTextureBytes();
+        if (m_budget == 0 || m_residentBytes <= m_budget)
+            return;
+
+        // evict the groups hidden for the longest time first
+        std::ranges::sort(m_candidates, {}, &Group::m_lastDrawnFrame);
+        for (Group* group : m_candidates)
+        {
+            bool isReleased = false;
+            for (const auto& widget : group->m_widgetList)
+            {
+                isReleased = widget->UnbindResources() || isReleased;
+            }
+            if (!isReleased)
+                continue;
+
+            group->m_isEvicted = true;
+            ++m_evictionCount;
+            m_residentBytes = cache.GetTextureBytes();
+            if (m_residentBytes <= m_budget)
+                break;
+        }
+    }
+
+    ResidencyStats TextureResidency::GetStats() const
+    {
+        return { m_budget, m_residentBytes, m_evictionCount, m_reloadCount };
+    }
+
+    void TextureResidency::Visit(Group& group, bool isShown, std::vector<Group*>& candidates)
+    {
+        isShown = isShown && group.m_isVisible;
+        if (isShown)
+        {
+            group.m_lastDrawnFrame = m_frame;
+            if (group.m_isEvicted)
+            {
+                group.m_isEvicted = false;
+                ++m_reloadCount;
+            }
+        }
+        // a group shown by the previous frame may still be replayed by a render thread
+        else if (!group.m_isEvicted && group.m_lastDrawnFrame + 1 < m_frame)
+        {
+            candidates.push_back(&group);
+        }
+
+        for (const auto& child : group.m_child)
+        {
+            Visit(*child, isShown, candidates);
+        }
+    }
+
+}
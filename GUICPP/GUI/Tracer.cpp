@@ -0,0 +1,261 @@
+#include "Tracer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        void AppendEscaped(std::string& text, const char* string)
+        {
+            for (; *string != '\0'; ++string)
+            {
+                const char c = *string;
+                if (c == '"' || c == '\\')
+                {
+                    text += '\\';
+                    text += c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+                    text += escaped;
+                }
+                else
+                {
+                    text += c;
+                }
+            }
+        }
+    }
+
+    TraceBuffer::TraceBuffer(uint32_t threadId)
+        : m_events(std::make_unique<std::array<TraceEvent, Capacity>>()), m_threadId(threadId)
+    {
+    }
+
+    bool TraceBuffer::Push(const TraceEvent& event)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= Capacity)
+        {
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        (*m_events)[head % Capacity] = event;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void TraceBuffer::Drain(std::vector<TraceEvent>& events)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        for (size_t i = tail; i != head; ++i)
+        {
+            events.push_back((*m_events)[i % Capacity]);
+        }
+        m_tail.store(head, std::memory_order_release);
+    }
+
+    void TraceBuffer::Discard()
+    {
+        m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    uint32_t TraceBuffer::GetThreadId() const
+    {
+        return m_threadId;
+    }
+
+    size_t TraceBuffer::GetDroppedCount() const
+    {
+        return m_droppedCount.load(std::memory_order_relaxed);
+    }
+
+    Tracer& Tracer::GetInstance()
+    {
+        static Tracer instance;
+        return instance;
+    }
+
+    Tracer::~Tracer()
+    {
+        Stop();
+    }
+
+    bool Tracer::Start(const std::string& path, std::chrono::milliseconds flushInterval)
+    {
+        Stop();
+        std::scoped_lock lock(m_mutex);
+        m_file.open(path, std::ios::trunc);
+        if (!m_file)
+        {
+            std::cout << "Error opening trace " << path << std::endl;
+            return false;
+        }
+        // the array format stays readable if the process ends before Stop closes it
+        m_file << "[";
+        m_isFirstEvent = true;
+        for (const auto& buffer : m_buffers)
+        {
+            buffer->Discard();
+        }
+        m_start = std::chrono::steady_clock::now();
+        m_flushInterval = flushInterval;
+        s_isTracing.store(true, std::memory_order_release);
+        m_writer = std::jthread([this](std::stop_token stopToken) { Run(stopToken); });
+        return true;
+    }
+
+    void Tracer::Stop()
+    {
+        if (!m_writer.joinable())
+            return;
+        s_isTracing.store(false, std::memory_order_relaxed);
+        m_writer.request_stop();
+        m_wakeUp.notify_all();
+        m_writer.join();
+
+        Write();
+        std::scoped_lock lock(m_mutex);
+        for (const auto& [id, name] : m_threadNames)
+        {
+            m_text.clear();
+            m_text += m_isFirstEvent ? "\n" : ",\n";
+            m_text += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(id) + ",\"args\":{\"name\":\"";
+            AppendEscaped(m_text, name.c_str());
+            m_text += "\"}}";
+            m_file << m_text;
+            m_isFirstEvent = false;
+        }
+        m_file << "\n]\n";
+        m_file.close();
+    }
+
+    void Tracer::Add(const char* category, const char* name, std::chrono::steady_clock::time_point start,
+                     std::chrono::steady_clock::time_point end, const char* detail)
+    {
+        // a thread gets its buffer only once it traces
+        if (!IsTracing())
+            return;
+
+        TraceEvent event;
+        event.category = category;
+        event.name = name;
+        event.start = std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_start).count();
+        event.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        if (detail != nullptr)
+        {
+            // a long path keeps its end, the file name, without starting in the middle of a character
+            size_t length = std::strlen(detail);
+            if (length >= TraceEvent::DetailSize)
+            {
+                detail += length - (TraceEvent::DetailSize - 1);
+                while ((static_cast<unsigned char>(*detail) & 0xC0) == 0x80)
+                {
+                    ++detail;
+                }
+                length = std::strlen(detail);
+            }
+            std::memcpy(event.detail.data(), detail, length + 1);
+        }
+        GetThreadBuffer().Push(event);
+    }
+
+    void Tracer::NameThread(const std::string& name)
+    {
+        const uint32_t id = GetThreadId();
+        std::scoped_lock lock(m_mutex);
+        m_threadNames[id] = name;
+    }
+
+    size_t Tracer::GetDroppedCount() const
+    {
+        std::scoped_lock lock(m_mutex);
+        size_t count = 0;
+        for (const auto& buffer : m_buffers)
+        {
+            count += buffer->GetDroppedCount();
+        }
+        return count;
+    }
+
+    TraceBuffer& Tracer::GetThreadBuffer()
+    {
+        // the buffers are never freed, a thread keeps its buffer across traces
+        thread_local TraceBuffer* buffer = nullptr;
+        if (buffer == nullptr)
+        {
+            std::scoped_lock lock(m_mutex);
+            m_buffers.push_back(std::make_unique<TraceBuffer>(GetThreadId()));
+            buffer = m_buffers.back().get();
+        }
+        return *buffer;
+    }
+
+    uint32_t Tracer::GetThreadId()
+    {
+        thread_local const uint32_t id = m_nextThreadId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    void Tracer::Run(std::stop_token stopToken)
+    {
+        while (!stopToken.stop_requested())
+        {
+            {
+                std::unique_lock lock(m_wakeUpMutex);
+                m_wakeUp.wait_for(lock, stopToken, m_flushInterval, [] { return false; });
+            }
+            Write();
+        }
+    }
+
+    void Tracer::Write()
+    {
+        std::scoped_lock lock(m_mutex);
+        m_text.clear();
+        for (const auto& buffer : m_buffers)
+        {
+            m_events.clear();
+            buffer->Drain(m_events);
+            const std::string threadId = std::to_string(buffer->GetThreadId());
+            for (const TraceEvent& event : m_events)
+            {
+                // a span started before the trace
+                if (event.start < 0)
+                    continue;
+                char times[64];
+                std::snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f", static_cast<double>(event.start) / 1000.0,
+                              static_cast<double>(event.duration) / 1000.0);
+                m_text += m_isFirstEvent ? "\n{\"name\":\"" : ",\n{\"name\":\"";
+                m_isFirstEvent = false;
+                AppendEscaped(m_text, event.name);
+                m_text += "\",\"cat\":\"";
+                AppendEscaped(m_text, event.category);
+                m_text += "\",\"ph\":\"X\",";
+                m_text += times;
+                m_text += ",\"pid\":1,\"tid\":";
+                m_text += threadId;
+                if (event.detail[0] != '\0')
+                {
+                    m_text += ",\"args\":{\"detail\":\"";
+                    AppendEscaped(m_text, event.detail.data());
+                    m_text += "\"}";
+                }
+                m_text += '}';
+            }
+        }
+        if (!m_text.empty())
+        {
+            m_file << m_text;
+            m_file.flush();
+        }
+    }
+
+}
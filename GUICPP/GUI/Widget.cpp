@@ -14,6 +14,194 @@ namespace GUICPP
         return m_position - Group.m_globalPosition;
     }
 
+    sf::FloatRect Widget::GetGlobalBounds() const
+    {
+        return { m_position, m_size };
+    }
+
+    void Widget::SetLayer(int layer)
+    {
+        Invalidate();
+        m_layer = layer;
+    }
+
+    int Widget::GetLayer() const
+    {
+        return m_layer;
+    }
+
+    void Widget::SetDepth(int depth)
+    {
+        Invalidate();
+        m_depth = depth;
+    }
+
+    int Widget::GetDepth() const
+    {
+        return m_depth;
+    }
+
+    const sf::Texture* Widget::GetMaterial() const
+    {
+        return nullptr;
+    }
+
+    void Widget::Invalidate()
+    {
+        m_isDirty = true;
+        if (m_drawOrderFlag != nullptr)
+        {
+            *m_drawOrderFlag = true;
+        }
+        // the cached bounds of its groups may no longer contain the Widget
+        if (m_group != nullptr)
+        {
+            m_group->InvalidateBounds();
+        }
+    }
+
+    MemoryUsage Widget::GetMemoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.objectBytes = sizeof(Widget);
+        if (m_sounds)
+        {
+            // the set is shared, only count it once per distinct buffer table
+            usage.sharedBytes += sizeof(SoundSet) / static_cast<size_t>(m_sounds.use_count());
+        }
+        if (m_style)
+        {
+            usage.sharedBytes += sizeof(StyleSlot) / static_cast<size_t>(m_style.use_count());
+            if (m_styleOverrides.IsEmpty())
+            {
+                const auto& style = m_style->GetShared();
+                usage.sharedBytes += style->GetMemoryBytes() / static_cast<size_t>(style.use_count()) / static_cast<size_t>(m_style.use_count());
+            }
+            else
+            {
+                const auto& style = GetSharedStyle();
+                usage.sharedBytes += style->GetMemoryBytes() / static_cast<size_t>(style.use_count());
+            }
+        }
+        return usage;
+    }
+
+    void Widget::SetStyle(const std::shared_ptr<const Style>& style)
+    {
+        if (style == nullptr)
+            throw std::runtime_error("Style is nullptr");
+
+        m_style = StyleSlot::For(style);
+        ApplyStyle();
+    }
+
+    void Widget::SetStyleSlot(const std::shared_ptr<StyleSlot>& slot)
+    {
+        if (slot == nullptr)
+            throw std::runtime_error("Style slot is nullptr");
+
+        m_style = slot;
+        ApplyStyle();
+    }
+
+    const Style& Widget::GetStyle() const
+    {
+        return *GetSharedStyle();
+    }
+
+    const std::shared_ptr<const Style>& Widget::GetSharedStyle() const
+    {
+        const auto& slotStyle = m_style->GetShared();
+        if (m_styleOverrides.IsEmpty())
+            return slotStyle;
+
+        // derived once per style of the slot, a theme swap is picked up by the next call
+        if (!m_resolvedStyle || m_slotStyle != slotStyle)
+        {
+            Style::Desc desc = slotStyle->GetDesc();
+            m_styleOverrides.ApplyTo(desc);
+            m_resolvedStyle = Style::Create(desc);
+            m_slotStyle = slotStyle;
+        }
+        return m_resolvedStyle;
+    }
+
+    void Widget::ApplyStyle()
+    {
+    }
+
+    void Widget::BindResources()
+    {
+        if (!m_hasPendingResources)
+            return;
+        GUICPP_TRACE_SCOPE_DETAIL("asset", "LoadResources", GetTypeName());
+        m_hasPendingResources = false;
+        LoadResources();
+        Invalidate();
+    }
+
+    bool Widget::HasPendingResources() const
+    {
+        return m_hasPendingResources;
+    }
+
+    bool Widget::UnbindResources()
+    {
+        if (m_hasPendingResources || !ReleaseResources())
+            return false;
+        m_hasPendingResources = true;
+        Invalidate();
+        return true;
+    }
+
+    void Widget::CollectResources(std::vector<std::string>& /*paths*/) const
+    {
+    }
+
+    void Widget::LoadResources()
+    {
+    }
+
+    bool Widget::ReleaseResources()
+    {
+        return false;
+    }
+
+    void Widget::BindStyle(const std::string& typeName)
+    {
+        m_style = Theme::GetDefault().GetSlot(typeName);
+    }
+
+    void Widget::EditStyle(const std::function<void(StyleOverrides&)>& edit)
+    {
+        StyleOverrides overrides = m_styleOverrides;
+        edit(overrides);
+        if (overrides == m_styleOverrides)
+            return;
+
+        m_styleOverrides = std::move(overrides);
+        m_resolvedStyle = nullptr;
+        m_slotStyle = nullptr;
+    }
+
+    void Widget::PlaySound(SoundEvent event) const
+    {
+        const SoundSet* sounds = m_sounds ? m_sounds.get() : GetStyle().GetSounds();
+        if (sounds)
+        {
+            m_soundHandles[static_cast<size_t>(event)] = SoundPool::GetInstance().Play(sounds->Get(event));
+        }
+    }
+
+    bool Widget::StopSound(SoundEvent event) const
+    {
+        // only the voice this Widget started, another widget may play the same buffer
+        SoundPool::Handle& handle = m_soundHandles[static_cast<size_t>(event)];
+        const bool isStopped = SoundPool::GetInstance().Stop(handle);
+        handle = SoundPool::NoVoice;
+        return isStopped;
+    }
+
     void Widget::SetWindow(sf::RenderWindow* window)
     {
         if(window == nullptr)
@@ -21,5 +209,33 @@ namespace GUICPP
     
         m_window = window;
     }
+
+    void Widget::SetTextBatch(TextBatch* batch)
+    {
+        m_textBatch = batch;
+    }
+
+    void Widget::SetPointer(const sf::Vector2i* pointer)
+    {
+        m_pointer = pointer;
+    }
+
+    sf::Vector2f Widget::GetPointerPosition() const
+    {
+        if(m_window == nullptr)
+            throw std::runtime_error("Window is nullptr");
+
+        const sf::Vector2i pixel = m_pointer != nullptr ? *m_pointer : sf::Mouse::getPosition(*m_window);
+        return m_window->mapPixelToCoords(pixel);
+    }
+
+    void Widget::SetRenderSink(RenderSink* sink)
+    {
+        if (sink != m_sink)
+        {
+            m_sink = sink;
+            m_isDrawn = false;
+        }
+    }
     
 }
\ No newline at end of file
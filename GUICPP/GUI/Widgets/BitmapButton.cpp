@@ -1,28 +1,27 @@
 #include "Widgets/BitmapButton.h"
 
-#include <iostream>
+#include "AssetCache.h"
+#include "HitMask.h"
 
 namespace GUICPP
 {
     
-    BitmapButton::BitmapButton(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& color): Button(position, size, color)
+    BitmapButton::BitmapButton(const sf::Vector2f& position, const sf::Vector2f& size, const std::optional<sf::Color>& color): Button(position, size, color)
     {
-        m_position = position;
-        m_size = size;
+        BindStyle("BitmapButton");
+        EditStyle([&color](StyleOverrides& overrides) { overrides.bodyColor = color; });
     }
 
     bool BitmapButton::HandleEvents(const sf::Event& e)
     {
         if(m_window == nullptr)
             throw std::runtime_error("Window is nullptr");
+        BindResources();
     
-        const sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-
-        // convert it to world coordinates
-        const sf::Vector2f worldPos = m_window->mapPixelToCoords(mousePos);
+        const sf::Vector2f worldPos = GetPointerPosition();
 
         // Check if the mouse is outside the button bounds
-        if (!m_sprite.getGlobalBounds().contains(static_cast<float>(worldPos.x), static_cast<float>(worldPos.y)))
+        if (!m_sprite.Contains(worldPos, m_hitMask.get()))
         {
             if(m_isMouseOver)
             {
@@ -52,128 +51,200 @@ namespace GUICPP
 
     void BitmapButton::Draw(sf::RenderStates& states)
     {
-        if(m_window == nullptr) {
-            throw std::runtime_error("Window is nullptr");
+        if(m_sink == nullptr) {
+            throw std::runtime_error("Render sink is nullptr");
         }
-        m_window->draw(m_sprite, states);
+        BindResources();
+        m_sink->Draw(m_sprite, states);
     }
 
     void BitmapButton::Move(const sf::Vector2f& position)
     {
+        Invalidate();
         m_position = position;
         m_sprite.setPosition(position);
     }
 
     void BitmapButton::SetColor(const sf::Color& color)
     {
+        Invalidate();
         m_color = color;
-        m_sprite.setColor(color);
+        EditStyle([&color](StyleOverrides& overrides) { overrides.bodyColor = color; });
+        m_sprite.SetColor(color);
     }
 
     void BitmapButton::SetSize(const sf::Vector2f& size)
     {
+        Invalidate();
         m_size = size;
-        const auto texture_size = m_sprite.getTexture()->getSize();
-        m_sprite.setScale(size.x / static_cast<float>(texture_size.x),
-                            size.y / static_cast<float>(texture_size.y));
+        m_sprite.SetSize(size);
     }
 
     void BitmapButton::SetPosition(sf::Vector2f position)
     {
+        Invalidate();
         m_position = position;
         m_sprite.setPosition(position);
     }
 
     void BitmapButton::SetBitmapFolder(const std::string& pathToFolder, const std::string& extension)
     {
-        // load the "Default", "Clicked" and "MouseOver" textures
-        const std::string defaultPath = pathToFolder + "/Default." + extension;
-        if(m_defaultTexture.loadFromFile(defaultPath))
-            std::cout << "Failed to load texture from " << defaultPath << std::endl;
+        // the textures are loaded when the button is about to be shown
+        m_bitmapFolder = pathToFolder;
+        m_bitmapExtension = extension;
+        m_hasPendingResources = true;
+    }
+
+    bool BitmapButton::ReleaseResources()
+    {
+        if (m_bitmapFolder.empty())
+            return false;
+
+        // drop the textures of the widget, the cache frees them once no other widget uses them
+        EditStyle([](StyleOverrides& overrides) { overrides.textures[static_cast<size_t>(StylePart::Body)] = {}; });
+        m_sprite.SetTexture(nullptr);
+        m_hitMask = nullptr;
+        return true;
+    }
+
+    void BitmapButton::SetPixelHitTest(bool isEnabled, sf::Uint8 alphaThreshold)
+    {
+        m_isPixelHitTest = isEnabled;
+        m_alphaThreshold = alphaThreshold;
+        m_hitMask = nullptr;
+        if (!m_hasPendingResources) {
+            ApplyStyle();
+        }
+    }
 
-        const std::string clickPath = pathToFolder + "/Clicked." + extension;
-        if(m_clickTexture.loadFromFile(clickPath))
-            std::cout << "Failed to load texture from " << clickPath << std::endl;
+    void BitmapButton::CollectResources(std::vector<std::string>& paths) const
+    {
+        if (!m_hasPendingResources)
+            return;
+        for (const char* name : { "Default", "Clicked", "MouseOver" }) {
+            paths.push_back(m_bitmapFolder + "/" + name + "." + m_bitmapExtension);
+        }
+    }
 
-        const std::string hoverPath = pathToFolder + "/MouseOver." + extension;
-        if(m_hoverTexture.loadFromFile(hoverPath))
-            std::cout << "Failed to load texture from " << hoverPath << std::endl;
+    void BitmapButton::LoadResources()
+    {
+        // load the "Default", "Clicked" and "MouseOver" textures, shared with every button using the same folder
+        AssetCache& cache = AssetCache::GetInstance();
+        EditStyle([&](StyleOverrides& overrides) {
+            auto& textures = overrides.textures[static_cast<size_t>(StylePart::Body)];
+            textures[static_cast<size_t>(StyleState::Default)] = cache.GetTexture(m_bitmapFolder + "/Default." + m_bitmapExtension);
+            textures[static_cast<size_t>(StyleState::Pressed)] = cache.GetTexture(m_bitmapFolder + "/Clicked." + m_bitmapExtension);
+            textures[static_cast<size_t>(StyleState::Hover)] = cache.GetTexture(m_bitmapFolder + "/MouseOver." + m_bitmapExtension);
+        });
+
+        // generate the hit masks of every state now rather than on the first hover
+        if (m_isPixelHitTest) {
+            for (const auto& texture : GetStyle().GetDesc().textures[static_cast<size_t>(StylePart::Body)]) {
+                HitMask::Get(texture, m_alphaThreshold);
+            }
+        }
 
-        m_sprite = sf::Sprite(m_defaultTexture);
+        ShowState(StyleState::Default);
+        m_sprite.SetBorders(GetStyle().GetBorders(StylePart::Body));
         m_sprite.setPosition(m_position);
-        m_sprite.setScale(m_size.x / static_cast<float>(m_defaultTexture.getSize().x),
-                            m_size.y / static_cast<float>(m_defaultTexture.getSize().y));
+        SetSize(m_size);
     }
 
-    void BitmapButton::OnStartHover()
+    void BitmapButton::ApplyStyle()
+    {
+        Invalidate();
+        StyleState state = StyleState::Default;
+        if (m_wasClicked) {
+            state = StyleState::Pressed;
+        } else if (m_isMouseOver) {
+            state = StyleState::Hover;
+        }
+        ShowState(state);
+        m_sprite.SetBorders(GetStyle().GetBorders(StylePart::Body));
+        m_sprite.SetColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
+        SetSize(m_size);
+    }
+
+    void BitmapButton::ShowState(StyleState state)
     {
-        if (m_sound.getBuffer() == m_OnStartHoverBuffer.get()) {
-            m_sound.play();
+        Invalidate();
+        if (const sf::Texture* texture = GetStyle().GetTexture(StylePart::Body, state)) {
+            m_sprite.SetTexture(texture);
+            if (m_isPixelHitTest) {
+                m_hitMask = HitMask::Get(GetStyle().GetDesc().textures[static_cast<size_t>(StylePart::Body)][static_cast<size_t>(state)],
+                                         m_alphaThreshold);
+            }
         }
-        else if(m_OnStartHoverBuffer)
-        {
-            m_sound.setBuffer(*m_OnStartHoverBuffer);
-            m_sound.play();
+    }
+
+    sf::FloatRect BitmapButton::GetGlobalBounds() const
+    {
+        return m_sprite.GetGlobalBounds();
+    }
+
+    const sf::Texture* BitmapButton::GetMaterial() const
+    {
+        return m_sprite.GetTexture();
+    }
+
+    const char* BitmapButton::GetTypeName() const
+    {
+        return "BitmapButton";
+    }
+
+    MemoryUsage BitmapButton::GetMemoryUsage() const
+    {
+        MemoryUsage usage = Button::GetMemoryUsage();
+        usage.objectBytes = sizeof(BitmapButton);
+        if (m_hitMask) {
+            usage.sharedBytes += m_hitMask->GetMemoryBytes() / m_hitMask.use_count();
         }
+        return usage;
+    }
+
+    void BitmapButton::OnStartHover()
+    {
+        PlaySound(SoundEvent::StartHover);
     
         m_isMouseOver = true;
-        m_sprite.setTexture(m_hoverTexture);
+        ShowState(StyleState::Hover);
     }
 
     void BitmapButton::OnEndHover()
     {
-        if (m_sound.getBuffer() == m_OnEndHoverBuffer.get()) {
-            m_sound.play();
-        }
-        else if(m_OnEndHoverBuffer)
-        {
-            m_sound.setBuffer(*m_OnEndHoverBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::EndHover);
     
         m_isMouseOver = false;
-        m_sprite.setTexture(m_defaultTexture);
+        ShowState(StyleState::Default);
     }
 
     void BitmapButton::OnClick()
     {
-        if (m_sound .getBuffer() == m_OnClickBuffer.get()) {
-            m_sound.play();
-        }
-        else if(m_OnClickBuffer)
-        {
-            m_sound.setBuffer(*m_OnClickBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::Press);
     
         m_wasClicked = true;
-        m_sprite.setTexture(m_clickTexture);
+        ShowState(StyleState::Pressed);
     }
 
     void BitmapButton::OnReleased(bool away)
     {
-        if (m_sound.getBuffer() == m_OnReleasedBuffer.get()) {
-            m_sound.play();
-        }
-        else if(m_OnReleasedBuffer)
-        {
-            m_sound.setBuffer(*m_OnReleasedBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::Release);
     
         m_wasClicked = false;
 
         if(m_isResetOnClicks) {
             m_isMouseOver = false;
-            m_sprite.setTexture(m_defaultTexture);
+            ShowState(StyleState::Default);
         }
         else
         {
-            m_sprite.setTexture(m_hoverTexture);
+            ShowState(StyleState::Hover);
         }
 
         if (m_delegate && !away) {
-            m_delegate(m_delegateArgs);
+            GUICPP_PROFILE_WIDGET(this, Delegate);
+            GUICPP_TRACE_SCOPE("delegate", GetTypeName());
+            m_delegate();
         }
     }
     
@@ -1,28 +1,30 @@
 #include "Widgets/BitmapCheckBox.h"
 
-#include <iostream>
+#include "AssetCache.h"
+#include "HitMask.h"
 
 namespace GUICPP
 {
     
-    BitmapCheckBox::BitmapCheckBox(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& color): CheckBox(position, size, color)
+    BitmapCheckBox::BitmapCheckBox(const sf::Vector2f& position, const sf::Vector2f& size, const std::optional<sf::Color>& color): CheckBox(position, size, color)
     {
+        BindStyle("BitmapCheckBox");
+        EditStyle([&color](StyleOverrides& overrides) { overrides.bodyColor = color; });
+
         m_sprite.setPosition(position);
-        m_sprite.setColor(color);
+        m_sprite.SetColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
     }
 
     bool BitmapCheckBox::HandleEvents(const sf::Event& e)
     {
         if(m_window == nullptr)
             throw std::runtime_error("Window is nullptr");
+        BindResources();
     
-        const sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-
-        // convert it to world coordinates
-        const sf::Vector2f worldPos = m_window->mapPixelToCoords(mousePos);
+        const sf::Vector2f worldPos = GetPointerPosition();
 
         // Check if the mouse is outside the button bounds
-        if (!m_sprite.getGlobalBounds().contains(static_cast<float>(worldPos.x), static_cast<float>(worldPos.y)))
+        if (!m_sprite.Contains(worldPos, m_hitMask.get()))
         {
             if(m_isMouseOver)
             {
@@ -53,35 +55,40 @@ namespace GUICPP
     // DrawCheckBox
     void BitmapCheckBox::Draw(sf::RenderStates& states)
     {
-        if(m_window == nullptr) {
-            throw std::runtime_error("Window is nullptr");
+        if(m_sink == nullptr) {
+            throw std::runtime_error("Render sink is nullptr");
         }
-        m_window->draw(m_sprite, states);
+        BindResources();
+        m_sink->Draw(m_sprite, states);
     }
 
     // MoveCheckBox
     void BitmapCheckBox::Move(const sf::Vector2f& position)
     {
+        Invalidate();
         m_position = position;
         m_sprite.setPosition(position);
     }
 
     void BitmapCheckBox::SetColor(const sf::Color& color)
     {
+        Invalidate();
         m_color = color;
-        m_sprite.setColor(color);
+        EditStyle([&color](StyleOverrides& overrides) { overrides.bodyColor = color; });
+        m_sprite.SetColor(color);
     }
 
     // SetCheckBoxSize
     void BitmapCheckBox::SetSize(const sf::Vector2f& size)
     {
+        Invalidate();
         m_size = size;
-        const sf::Rect rect = m_sprite.getTextureRect();
-        m_sprite.setScale(size.x / static_cast<float>(rect.width), size.y / static_cast<float>(rect.height));
+        m_sprite.SetSize(size);
     }
 
     void BitmapCheckBox::SetPosition(sf::Vector2f position)
     {
+        Invalidate();
         m_position = position;
         m_sprite.setPosition(position); 
     }
@@ -89,61 +96,135 @@ namespace GUICPP
     // SetCheckBoxState
     void BitmapCheckBox::SetChecked(bool state)
     {
+        Invalidate();
         m_isChecked = state;
     }
 
     void BitmapCheckBox::SetBitmapFolder(const std::string& pathToFolder, const std::string& extension)
     {
-        //They are 4 variant of the checkbox : Checked, CheckedMouseOver, Unchecked, UncheckedMouseOver
-        const std::string checkedPath = pathToFolder + "/Checked." + extension;
-        if(!m_CheckedTexture.loadFromFile(checkedPath))
-        {
-            std::cout << "Error while loading texture from file : " << checkedPath << std::endl;
-        }
-        const std::string checkedMouseOverPath = pathToFolder + "/CheckedMouseOver." + extension;
-        if(!m_CheckedMouseOverTexture.loadFromFile(checkedMouseOverPath))
-        {
-            std::cout << "Error while loading texture from file : " << checkedMouseOverPath << std::endl;
+        // the textures are loaded when the checkbox is about to be shown
+        m_bitmapFolder = pathToFolder;
+        m_bitmapExtension = extension;
+        m_hasPendingResources = true;
+    }
+
+    bool BitmapCheckBox::ReleaseResources()
+    {
+        if (m_bitmapFolder.empty())
+            return false;
+
+        // drop the textures of the widget, the cache frees them once no other widget uses them
+        EditStyle([](StyleOverrides& overrides) { overrides.textures[static_cast<size_t>(StylePart::Body)] = {}; });
+        m_sprite.SetTexture(nullptr);
+        m_hitMask = nullptr;
+        return true;
+    }
+
+    void BitmapCheckBox::SetPixelHitTest(bool isEnabled, sf::Uint8 alphaThreshold)
+    {
+        m_isPixelHitTest = isEnabled;
+        m_alphaThreshold = alphaThreshold;
+        m_hitMask = nullptr;
+        if (!m_hasPendingResources) {
+            ShowState();
         }
-        const std::string uncheckedPath = pathToFolder + "/Unchecked." + extension;
-        if(!m_UncheckedTexture.loadFromFile(uncheckedPath))
-        {
-            std::cout << "Error while loading texture from file : " << uncheckedPath << std::endl;
+    }
+
+    void BitmapCheckBox::CollectResources(std::vector<std::string>& paths) const
+    {
+        if (!m_hasPendingResources)
+            return;
+        for (const char* name : { "Checked", "CheckedMouseOver", "Unchecked", "UncheckedMouseOver" }) {
+            paths.push_back(m_bitmapFolder + "/" + name + "." + m_bitmapExtension);
         }
-        const std::string uncheckedMouseOverPath = pathToFolder + "/UncheckedMouseOver." + extension;
-        if(!m_UncheckedMouseOverTexture.loadFromFile(uncheckedMouseOverPath))
-        {
-            std::cout << "Error while loading texture from file : " << uncheckedMouseOverPath << std::endl;
+    }
+
+    void BitmapCheckBox::LoadResources()
+    {
+        //They are 4 variant of the checkbox : Checked, CheckedMouseOver, Unchecked, UncheckedMouseOver
+        AssetCache& cache = AssetCache::GetInstance();
+        EditStyle([&](StyleOverrides& overrides) {
+            auto& textures = overrides.textures[static_cast<size_t>(StylePart::Body)];
+            textures[static_cast<size_t>(StyleState::Checked)] = cache.GetTexture(m_bitmapFolder + "/Checked." + m_bitmapExtension);
+            textures[static_cast<size_t>(StyleState::CheckedHover)] = cache.GetTexture(m_bitmapFolder + "/CheckedMouseOver." + m_bitmapExtension);
+            textures[static_cast<size_t>(StyleState::Default)] = cache.GetTexture(m_bitmapFolder + "/Unchecked." + m_bitmapExtension);
+            textures[static_cast<size_t>(StyleState::Hover)] = cache.GetTexture(m_bitmapFolder + "/UncheckedMouseOver." + m_bitmapExtension);
+        });
+
+        // generate the hit masks of every state now rather than on the first hover
+        if (m_isPixelHitTest) {
+            for (const auto& texture : GetStyle().GetDesc().textures[static_cast<size_t>(StylePart::Body)]) {
+                HitMask::Get(texture, m_alphaThreshold);
+            }
         }
 
-        m_sprite = sf::Sprite(m_isChecked ? m_CheckedTexture : m_UncheckedTexture);
-        sf::Rect rect = m_sprite.getTextureRect();
+        ShowState();
+        m_sprite.SetBorders(GetStyle().GetBorders(StylePart::Body));
         m_sprite.setPosition(m_position);
-        m_sprite.setScale(m_size.x / static_cast<float>(rect.width),
-                            m_size.y / static_cast<float>(rect.height));
+        m_sprite.SetSize(m_size);
+    }
+
+    sf::FloatRect BitmapCheckBox::GetGlobalBounds() const
+    {
+        return m_sprite.GetGlobalBounds();
+    }
+
+    const sf::Texture* BitmapCheckBox::GetMaterial() const
+    {
+        return m_sprite.GetTexture();
+    }
+
+    const char* BitmapCheckBox::GetTypeName() const
+    {
+        return "BitmapCheckBox";
+    }
+
+    MemoryUsage BitmapCheckBox::GetMemoryUsage() const
+    {
+        MemoryUsage usage = CheckBox::GetMemoryUsage();
+        usage.objectBytes = sizeof(BitmapCheckBox);
+        if (m_hitMask) {
+            usage.sharedBytes += m_hitMask->GetMemoryBytes() / m_hitMask.use_count();
+        }
+        return usage;
+    }
+
+    void BitmapCheckBox::ApplyStyle()
+    {
+        Invalidate();
+        ShowState();
+        m_sprite.SetBorders(GetStyle().GetBorders(StylePart::Body));
+        m_sprite.SetColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
+    }
+
+    void BitmapCheckBox::ShowState()
+    {
+        Invalidate();
+        const StyleState state = GetStyleState();
+        if (const sf::Texture* texture = GetStyle().GetTexture(StylePart::Body, state)) {
+            m_sprite.SetTexture(texture);
+            if (m_isPixelHitTest) {
+                m_hitMask = HitMask::Get(GetStyle().GetDesc().textures[static_cast<size_t>(StylePart::Body)][static_cast<size_t>(state)],
+                                         m_alphaThreshold);
+            }
+        }
     }
 
     void BitmapCheckBox::OnStartHover()
     {
         m_isMouseOver = true;
     
-        if (m_sound.getBuffer() == m_OnStartHoverBuffer.get()) {
-            m_sound.play();
-        }
-        else if (m_OnStartHoverBuffer) {
-            m_sound.setBuffer(*m_OnStartHoverBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::StartHover);
 
         // action when mouse over
-        m_sprite.setTexture(m_isChecked ? m_CheckedMouseOverTexture : m_UncheckedMouseOverTexture);
+        ShowState();
     }
 
     void BitmapCheckBox::OnEndHover()
     {
         m_isMouseOver = false;
         // action when mouse not over
-        m_sprite.setTexture(m_isChecked ? m_CheckedTexture : m_UncheckedTexture);
+        ShowState();
     }
 
     void BitmapCheckBox::OnClick()
@@ -159,57 +240,17 @@ namespace GUICPP
             m_isChecked = !m_isChecked;
 
             // play sound
-            if(m_isChecked)
-            {
-                if(m_OnCheckedBuffer)
-                {
-                    if(m_sound.getBuffer() == m_OnCheckedBuffer.get())
-                    {
-                        m_sound.play();
-                    }
-                    else if(m_OnCheckedBuffer)
-                    {
-                        m_sound.setBuffer(*m_OnCheckedBuffer);
-                        m_sound.play();
-                    }
-                }
-            }
-            else
-            {
-                if(m_OnUncheckedBuffer)
-                {
-                    if(m_sound.getBuffer() == m_OnUncheckedBuffer.get())
-                    {
-                        m_sound.play();
-                    }
-                    else if(m_OnUncheckedBuffer)
-                    {
-                        m_sound.setBuffer(*m_OnUncheckedBuffer);
-                        m_sound.play();
-                    }
-                }
-            }
+            PlaySound(m_isChecked ? SoundEvent::Press : SoundEvent::Release);
         }
         m_wasClicked = false;
 
         // change sprite
-        if(m_isChecked)
-        {
-            if(m_isMouseOver)
-                m_sprite.setTexture(m_CheckedMouseOverTexture);
-            else
-                m_sprite.setTexture(m_CheckedTexture);
-        }
-        else
-        {
-            if(m_isMouseOver)
-                m_sprite.setTexture(m_UncheckedMouseOverTexture);
-            else
-                m_sprite.setTexture(m_UncheckedTexture);
-        }
+        ShowState();
 
         if(m_delegate && !away)
         {
+            GUICPP_PROFILE_WIDGET(this, Delegate);
+            GUICPP_TRACE_SCOPE("delegate", GetTypeName());
             m_delegate(m_isChecked);
         }
     }
@@ -1,67 +1,74 @@
 #include "Widgets/BitmapSlider.h"
 
-#include <iostream>
+#include <algorithm>
+
+#include "AssetCache.h"
 
 namespace GUICPP
 {
     
-    BitmapSlider::BitmapSlider(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& barColor,
-                               const sf::Color& sliderColor, bool isVertical): Slider(position, size, barColor, sliderColor, isVertical)
+    BitmapSlider::BitmapSlider(const sf::Vector2f& position, const sf::Vector2f& size, const std::optional<sf::Color>& barColor,
+                               const std::optional<sf::Color>& sliderColor, bool isVertical): Slider(position, size, barColor, sliderColor, isVertical)
     {
-        m_bar.setScale(size);
-        m_bar.setColor(barColor);
+        BindStyle("BitmapSlider");
+        EditStyle([&](StyleOverrides& overrides) {
+            overrides.bodyColor = barColor;
+            overrides.accentColor = sliderColor;
+        });
+
+        m_bar.SetSize(size);
+        m_bar.SetColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
         m_bar.setPosition(position);
         m_bar.setOrigin(size.x / 2, size.y / 2);
     
         if(m_isVertical)
         {
-            m_cursor.setScale({ size.x * 1.2f, size.y / 10 });
+            m_cursor.SetSize({ size.x * 1.2f, size.y / 10 });
         }
         else
         {
-            m_cursor.setScale({ size.x / 10, size.y * 1.2f });
+            m_cursor.SetSize({ size.x / 10, size.y * 1.2f });
         }
-        m_cursor.setOrigin(m_cursor.getGlobalBounds().width / 2, m_cursor.getGlobalBounds().height / 2);
+        m_cursor.setOrigin(m_cursor.GetSize().x / 2, m_cursor.GetSize().y / 2);
     
-        m_cursor.setColor(sliderColor);
+        m_cursor.SetColor(GetStyle().GetColor(StylePart::Accent, StyleState::Default));
         BitmapSlider::SetCursorPosition(position);
     }
 
     void BitmapSlider::Move(const sf::Vector2f& position)
     {
+        Invalidate();
         m_bar.setPosition(position);
         SetCursorPosition(position);
     }
 
     void BitmapSlider::SetColor(const sf::Color& color)
     {
-        m_bar.setColor(color);
-        m_cursor.setColor(color);
+        Invalidate();
+        m_bar.SetColor(color);
+        m_cursor.SetColor(color);
     }
 
     void BitmapSlider::SetSize(const sf::Vector2f& size)
     {
-
-        m_bar.setScale(m_size.x / static_cast<float>(m_bar.getTexture()->getSize().x),
-                            m_size.y / static_cast<float>(m_bar.getTexture()->getSize().y));
+        Invalidate();
+        m_size = size;
         if(m_isVertical)
         {
             m_cursorSize = { size.x * 1.2f, size.y / 10 };
-            m_bar.setScale(m_cursorSize.x / static_cast<float>(m_bar.getTexture()->getSize().x),
-                            m_cursorSize.y / static_cast<float>(m_bar.getTexture()->getSize().y));
         }
         else
         {
             m_cursorSize = { size.x / 10, size.y * 1.2f };
-            m_cursor.setScale(m_cursorSize.x / static_cast<float>(m_cursor.getTexture()->getSize().x),
-                            m_cursorSize.y / static_cast<float>(m_cursor.getTexture()->getSize().y));
         }
+        ApplySizes();
     
         SetCursorPosition(m_position);
     }
 
     void BitmapSlider::SetPosition(sf::Vector2f position)
     {
+        Invalidate();
         m_position = position;
         m_bar.setPosition(position);
         SetCursorPosition(position); 
@@ -70,36 +77,41 @@ namespace GUICPP
 
     void BitmapSlider::SetBarColor(const sf::Color& color)
     {
-        m_barColor = color;
+        Invalidate();
+        m_color = color;
+        EditStyle([&color](StyleOverrides& overrides) { overrides.bodyColor = color; });
         if (!m_isMouseOver) {
-            m_bar.setColor(color);
+            m_bar.SetColor(color);
         }
     }
 
     void BitmapSlider::SetSliderColor(const sf::Color& color)
     {
-        m_sliderColor = color;
+        Invalidate();
+        EditStyle([&color](StyleOverrides& overrides) { overrides.accentColor = color; });
         if (!m_isMouseOver) {
-            m_cursor.setColor(color);
+            m_cursor.SetColor(color);
         }
     }
 
     void BitmapSlider::SetCursorSize(const sf::Vector2f& size)
     {
+        Invalidate();
         m_cursorSize = size;
-        m_cursor.setScale(size.x / static_cast<float>(m_cursor.getTexture()->getSize().x),
-                            size.y / static_cast<float>(m_cursor.getTexture()->getSize().y));
+        ApplySizes();
         SetCursorPosition(m_bar.getPosition());
     }
 
     void BitmapSlider::SetSliderValue(const sf::Vector2f& position, float value)
     {
+        Invalidate();
         m_value = value;
         SetCursorPosition(position);
     }
 
     void BitmapSlider::SetSliderVertical(bool isVertical)
     {
+        Invalidate();
         if(m_isVertical == isVertical)
         {
             return;
@@ -120,17 +132,65 @@ namespace GUICPP
 
     void BitmapSlider::SetOffset(float minOffset, float maxOffset)
     {
+        Invalidate();
         m_minOffset = minOffset;
         m_maxOffset = maxOffset;
     }
 
-    bool BitmapSlider::HandleEvents(const sf::Event& e) {
-        const sf::FloatRect hitboxBar = m_bar.getGlobalBounds();
-        const sf::FloatRect hitboxIndicator = m_cursor.getGlobalBounds();
-        const sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
+    sf::FloatRect BitmapSlider::GetGlobalBounds() const
+    {
+        // the cursor overhangs the bar
+        const sf::FloatRect bar = m_bar.GetGlobalBounds();
+        const sf::FloatRect cursor = m_cursor.GetGlobalBounds();
+        const float left = std::min(bar.left, cursor.left);
+        const float top = std::min(bar.top, cursor.top);
+        return { left, top, std::max(bar.left + bar.width, cursor.left + cursor.width) - left,
+                 std::max(bar.top + bar.height, cursor.top + cursor.height) - top };
+    }
 
-        // convert it to world coordinates
-        const sf::Vector2f worldPos = m_window->mapPixelToCoords(mousePos);
+    const sf::Texture* BitmapSlider::GetMaterial() const
+    {
+        return m_bar.GetTexture();
+    }
+
+    const char* BitmapSlider::GetTypeName() const
+    {
+        return "BitmapSlider";
+    }
+
+    MemoryUsage BitmapSlider::GetMemoryUsage() const
+    {
+        MemoryUsage usage = Slider::GetMemoryUsage();
+        usage.objectBytes = sizeof(BitmapSlider);
+        return usage;
+    }
+
+    void BitmapSlider::ApplyStyle()
+    {
+        Invalidate();
+        ShowState(m_isMouseOver ? StyleState::Hover : StyleState::Default);
+        m_bar.SetBorders(GetStyle().GetBorders(StylePart::Body));
+        m_cursor.SetBorders(GetStyle().GetBorders(StylePart::Accent));
+        m_bar.SetColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
+        m_cursor.SetColor(GetStyle().GetColor(StylePart::Accent, StyleState::Default));
+    }
+
+    void BitmapSlider::ShowState(StyleState state)
+    {
+        Invalidate();
+        if (const sf::Texture* texture = GetStyle().GetTexture(StylePart::Body, state)) {
+            m_bar.SetTexture(texture);
+        }
+        if (const sf::Texture* texture = GetStyle().GetTexture(StylePart::Accent, state)) {
+            m_cursor.SetTexture(texture);
+        }
+    }
+
+    bool BitmapSlider::HandleEvents(const sf::Event& e) {
+        BindResources();
+        const sf::FloatRect hitboxBar = m_bar.GetGlobalBounds();
+        const sf::FloatRect hitboxIndicator = m_cursor.GetGlobalBounds();
+        const sf::Vector2f worldPos = GetPointerPosition();
 
         const bool isBarHovered = hitboxBar.contains(static_cast<float>(worldPos.x), static_cast<float>(worldPos.y));
         const bool isCursorHovered = hitboxIndicator.contains(static_cast<float>(worldPos.x), static_cast<float>(worldPos.y));
@@ -167,123 +227,117 @@ namespace GUICPP
     }
 
     void BitmapSlider::Draw(sf::RenderStates& states) {
-        m_window->draw(m_bar, states);
-        m_window->draw(m_cursor, states);
+        BindResources();
+        m_sink->Draw(m_bar, states);
+        m_sink->Draw(m_cursor, states);
     }
 
     void BitmapSlider::OnStartHover() {
         m_isMouseOver = true;
 
-        if(m_sound.getBuffer() == m_OnEndHoverBuffer.get())
-        {
-            m_sound.play();
-        }
-        else if (m_OnStartHoverBuffer) {
-            m_sound.setBuffer(*m_OnStartHoverBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::StartHover);
     
-        m_bar.setTexture(m_barHoverTexture);
-        m_cursor.setTexture(m_cursorHoverTexture);
+        ShowState(StyleState::Hover);
     }
 
     void BitmapSlider::OnEndHover()
     {
         m_isMouseOver = false;
     
-        if (m_sound.getBuffer() == m_OnStartHoverBuffer.get()) {
-            m_sound.stop();
-        }
-        else if (m_OnEndHoverBuffer) {
-            m_sound.setBuffer(*m_OnEndHoverBuffer);
-            m_sound.play();
+        // cut the hover sound short, or play the end hover one if it already finished
+        if (!StopSound(SoundEvent::StartHover)) {
+            PlaySound(SoundEvent::EndHover);
         }
     
-        m_bar.setTexture(m_barDefaultTexture);
-        m_cursor.setTexture(m_cursorDefaultTexture);
+        ShowState(StyleState::Default);
     }
 
     void BitmapSlider::OnClick(bool isCursorClicked) {
         m_isMousePressed = true;
-        if (m_sound.getBuffer() == m_OnEndHoverBuffer.get()) {
-            m_sound.play();
-        }
-        else if (m_OnClickBuffer) {
-            m_sound.setBuffer(*m_OnClickBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::Press);
 
         if(!isCursorClicked)
         {
             // project mouse position on bar and place cursor there if isCursorClicked is false
-            const sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-            // convert it to world coordinates
-            const sf::Vector2f worldPos = m_window->mapPixelToCoords(mousePos);
+            const sf::Vector2f worldPos = GetPointerPosition();
     
             ComputeValue(sf::Vector2f(static_cast<float>(worldPos.x), static_cast<float>(worldPos.y)));
 
             SetCursorPosition(m_position);
 
             if(m_delegate)
+            {
+                GUICPP_PROFILE_WIDGET(this, Delegate);
+                GUICPP_TRACE_SCOPE("delegate", GetTypeName());
                 m_delegate(m_value);
+            }
         }
     }
 
     void BitmapSlider::OnReleased(bool away) {
         m_isMousePressed = false;
 
-        if(m_sound.getBuffer() == m_OnClickBuffer.get())
-        {
-            m_sound.play();
-        }
-        else if (m_OnReleasedBuffer) {
-            m_sound.setBuffer(*m_OnReleasedBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::Release);
     
         if (away) {
             m_isMouseOver = false;
-            m_bar.setTexture(m_barDefaultTexture);
-            m_cursor.setTexture(m_cursorDefaultTexture);
+            ShowState(StyleState::Default);
         }
     }
 
     void BitmapSlider::OnMouseHold()
     {
         // move slider to mouse position projected on bar
-        const sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-        const sf::Vector2f worldPos = m_window->mapPixelToCoords(mousePos);
+        const sf::Vector2f worldPos = GetPointerPosition();
 
         ComputeValue(worldPos);
 
         SetCursorPosition(m_position);
     
         if(m_delegate)
+        {
+            GUICPP_PROFILE_WIDGET(this, Delegate);
+            GUICPP_TRACE_SCOPE("delegate", GetTypeName());
             m_delegate(m_value);
+        }
     }
 
     void BitmapSlider::SetCursorPosition(const sf::Vector2f& position) {
+        Invalidate();
         sf::Vector2f midSliderPosition;
         if (m_isVertical) {
             midSliderPosition.x = position.x;
-            midSliderPosition.y = (m_minOffset + position.y - m_bar.getGlobalBounds().height / 2.0f)
-                + ((1 - m_value) * (m_bar.getGlobalBounds().height - m_maxOffset - m_minOffset));
+            midSliderPosition.y = (m_minOffset + position.y - m_bar.GetGlobalBounds().height / 2.0f)
+                + ((1 - m_value) * (m_bar.GetGlobalBounds().height - m_maxOffset - m_minOffset));
         } else {
-            midSliderPosition.x = (m_minOffset + position.x - m_bar.getGlobalBounds().width / 2.0f)
-                + (m_value * (m_bar.getGlobalBounds().width - m_maxOffset - m_minOffset));
+            midSliderPosition.x = (m_minOffset + position.x - m_bar.GetGlobalBounds().width / 2.0f)
+                + (m_value * (m_bar.GetGlobalBounds().width - m_maxOffset - m_minOffset));
             midSliderPosition.y = position.y;
         }
         m_cursor.setPosition(midSliderPosition);
     }
 
+    void BitmapSlider::ApplySizes()
+    {
+        // along the sprite axes, which are turned once the slider was made vertical
+        const bool isTurned = static_cast<int>(m_bar.getRotation()) % 180 != 0;
+        const sf::Vector2f barSize = isTurned ? sf::Vector2f(m_size.y, m_size.x) : m_size;
+        const sf::Vector2f cursorSize = isTurned ? sf::Vector2f(m_cursorSize.y, m_cursorSize.x) : m_cursorSize;
+
+        m_bar.SetSize(barSize);
+        m_bar.setOrigin(barSize.x / 2.0f, barSize.y / 2.0f);
+        m_cursor.SetSize(cursorSize);
+        m_cursor.setOrigin(cursorSize.x / 2.0f, cursorSize.y / 2.0f);
+    }
+
     void BitmapSlider::ComputeValue(sf::Vector2f position)
     {
         if(m_isVertical) {
-            m_value = 1 - ((position.y - m_bar.getPosition().y + m_bar.getGlobalBounds().height / 2.0f) / m_bar.getGlobalBounds().height);
+            m_value = 1 - ((position.y - m_bar.getPosition().y + m_bar.GetGlobalBounds().height / 2.0f) / m_bar.GetGlobalBounds().height);
             if(m_value < 0) m_value = 0;
             if(m_value > 1) m_value = 1;
         } else {
-            m_value = (position.x - m_bar.getPosition().x + m_bar.getGlobalBounds().width / 2.0f) / m_bar.getGlobalBounds().width;
+            m_value = (position.x - m_bar.getPosition().x + m_bar.GetGlobalBounds().width / 2.0f) / m_bar.GetGlobalBounds().width;
             if(m_value < 0) m_value = 0;
             if(m_value > 1) m_value = 1;
         }
@@ -291,36 +345,57 @@ namespace GUICPP
 
     void BitmapSlider::SetBitmapFolder(const std::string& pathToFolder, const std::string& extension)
     {
-        // load the "Default", "Clicked" and "MouseOver" textures
-        const std::string defaultBarPath = pathToFolder + "/BarDefault." + extension;
-        if(m_barDefaultTexture.loadFromFile(defaultBarPath))
-            std::cout << "Failed to load texture from " << defaultBarPath << std::endl;
-        const std::string hoverBarPath = pathToFolder + "/BarMouseOver." + extension;
-        if(m_barHoverTexture.loadFromFile(hoverBarPath))
-            std::cout << "Failed to load texture from " << hoverBarPath << std::endl;
-        const std::string defaultCursorPath = pathToFolder + "/CursorDefault." + extension;
-        if(m_cursorDefaultTexture.loadFromFile(defaultCursorPath))
-            std::cout << "Failed to load texture from " << defaultCursorPath << std::endl;
-        const std::string hoverCursorPath = pathToFolder + "/CursorMouseOver." + extension;
-        if(m_cursorHoverTexture.loadFromFile(hoverCursorPath))
-            std::cout << "Failed to load texture from " << hoverCursorPath << std::endl;
+        // the textures are loaded when the slider is about to be shown
+        m_bitmapFolder = pathToFolder;
+        m_bitmapExtension = extension;
+        m_hasPendingResources = true;
+    }
 
-        // set the default texture
-        m_bar.setTexture(m_barDefaultTexture);
-        m_cursor.setTexture(m_cursorDefaultTexture);
+    bool BitmapSlider::ReleaseResources()
+    {
+        if (m_bitmapFolder.empty())
+            return false;
+
+        // drop the textures of the widget, the cache frees them once no other widget uses them
+        EditStyle([](StyleOverrides& overrides) {
+            overrides.textures[static_cast<size_t>(StylePart::Body)] = {};
+            overrides.textures[static_cast<size_t>(StylePart::Accent)] = {};
+        });
+
+        // the sprites keep their placement and size, LoadResources only gives them their textures back
+        m_bar.SetTexture(nullptr);
+        m_cursor.SetTexture(nullptr);
+        return true;
+    }
 
-        // set size and origin
-        m_bar.setScale(m_size.x / static_cast<float>(m_bar.getTexture()->getSize().x),
-                            m_size.y / static_cast<float>(m_bar.getTexture()->getSize().y));
+    void BitmapSlider::CollectResources(std::vector<std::string>& paths) const
+    {
+        if (!m_hasPendingResources)
+            return;
+        for (const char* name : { "BarDefault", "BarMouseOver", "CursorDefault", "CursorMouseOver" }) {
+            paths.push_back(m_bitmapFolder + "/" + name + "." + m_bitmapExtension);
+        }
+    }
 
-        m_cursor.setScale(m_cursorSize.x / static_cast<float>(m_cursor.getTexture()->getSize().x),
-                            m_cursorSize.y / static_cast<float>(m_cursor.getTexture()->getSize().y));
+    void BitmapSlider::LoadResources()
+    {
+        // load the bar and cursor textures, shared with every slider using the same folder
+        AssetCache& cache = AssetCache::GetInstance();
+        EditStyle([&](StyleOverrides& overrides) {
+            auto& barTextures = overrides.textures[static_cast<size_t>(StylePart::Body)];
+            barTextures[static_cast<size_t>(StyleState::Default)] = cache.GetTexture(m_bitmapFolder + "/BarDefault." + m_bitmapExtension);
+            barTextures[static_cast<size_t>(StyleState::Hover)] = cache.GetTexture(m_bitmapFolder + "/BarMouseOver." + m_bitmapExtension);
+            auto& cursorTextures = overrides.textures[static_cast<size_t>(StylePart::Accent)];
+            cursorTextures[static_cast<size_t>(StyleState::Default)] = cache.GetTexture(m_bitmapFolder + "/CursorDefault." + m_bitmapExtension);
+            cursorTextures[static_cast<size_t>(StyleState::Hover)] = cache.GetTexture(m_bitmapFolder + "/CursorMouseOver." + m_bitmapExtension);
+        });
 
+        // set the default texture
+        ShowState(StyleState::Default);
+        m_bar.SetBorders(GetStyle().GetBorders(StylePart::Body));
+        m_cursor.SetBorders(GetStyle().GetBorders(StylePart::Accent));
 
-        m_bar.setOrigin(static_cast<float>(m_bar.getTexture()->getSize().x) / 2.0f, static_cast<float>(m_bar.getTexture()->getSize().y) / 2.0f);
-    
-        m_cursor.setOrigin(static_cast<float>(m_cursor.getTexture()->getSize().x) / 2.0f, static_cast<float>(m_cursor.getTexture()->getSize().y) / 2.0f);
-    
+        ApplySizes();
         m_bar.setPosition(m_position);
 
         SetCursorPosition(m_position);
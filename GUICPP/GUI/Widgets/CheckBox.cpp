@@ -3,15 +3,18 @@
 namespace GUICPP
 {
     
-    CheckBox::CheckBox(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& color): Widget(position, size, color)
+    CheckBox::CheckBox(const sf::Vector2f& position, const sf::Vector2f& size, const std::optional<sf::Color>& color): Widget(position, size, color.value_or(sf::Color::White))
     {
+        BindStyle("CheckBox");
+        EditStyle([&color](StyleOverrides& overrides) { overrides.bodyColor = color; });
+
         m_backrect.setPosition(position);
         m_backrect.setSize(size);
-        m_backrect.setFillColor(color);
+        m_backrect.setFillColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
 
         m_checkrect.setPosition(position + size / 7.f);
         m_checkrect.setSize(size - size / 3.5f);
-        m_checkrect.setFillColor(sf::Color::Black);
+        m_checkrect.setFillColor(GetStyle().GetColor(StylePart::Accent, StyleState::Default));
     }
 
     bool CheckBox::HandleEvents(const sf::Event& e)
@@ -19,10 +22,7 @@ namespace GUICPP
         if(m_window == nullptr)
             throw std::runtime_error("Window is nullptr");
     
-        const sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-
-        // convert it to world coordinates
-        const sf::Vector2f worldPos = m_window->mapPixelToCoords(mousePos);
+        const sf::Vector2f worldPos = GetPointerPosition();
 
         // Check if the mouse is outside the button bounds
         if (!m_backrect.getGlobalBounds().contains(static_cast<float>(worldPos.x), static_cast<float>(worldPos.y)))
@@ -56,18 +56,19 @@ namespace GUICPP
     // DrawCheckBox
     void CheckBox::Draw(sf::RenderStates& states)
     {
-        if(m_window == nullptr) {
-            throw std::runtime_error("Window is nullptr");
+        if(m_sink == nullptr) {
+            throw std::runtime_error("Render sink is nullptr");
         }
-        m_window->draw(m_backrect, states);
+        m_sink->Draw(m_backrect, states);
         if(m_isChecked) {
-            m_window->draw(m_checkrect, states);
+            m_sink->Draw(m_checkrect, states);
         }
     }
 
     // MoveCheckBox
     void CheckBox::Move(const sf::Vector2f& position)
     {
+        Invalidate();
         m_position = position;
         m_backrect.setPosition(position);
         m_checkrect.setPosition(position + m_size / 7.f);
@@ -75,13 +76,16 @@ namespace GUICPP
 
     void CheckBox::SetColor(const sf::Color& color)
     {
+        Invalidate();
         m_color = color;
+        EditStyle([&color](StyleOverrides& overrides) { overrides.bodyColor = color; });
         m_backrect.setFillColor(color);
     }
 
     // SetCheckBoxSize
     void CheckBox::SetSize(const sf::Vector2f& size)
     {
+        Invalidate();
         m_size = size;
         m_backrect.setSize(size);
         m_checkrect.setSize(size * 5.f / 7.f);
@@ -89,6 +93,7 @@ namespace GUICPP
 
     void CheckBox::SetPosition(sf::Vector2f position)
     {
+        Invalidate();
         m_position = position;
         m_backrect.setPosition(position);
         m_checkrect.setPosition(position + m_size / 7.f);
@@ -97,6 +102,7 @@ namespace GUICPP
     // SetCheckBoxState
     void CheckBox::SetChecked(bool state)
     {
+        Invalidate();
         m_isChecked = state;
     }
 
@@ -105,47 +111,53 @@ namespace GUICPP
             const std::shared_ptr<sf::SoundBuffer>& OnStartHoverBuffer,
             const std::shared_ptr<sf::SoundBuffer>& OnEndHoverBuffer)
     {
-        if(OnCheckedBuffer != nullptr)
-        {
-            m_OnCheckedBuffer = OnCheckedBuffer;
-        }
-        if(OnUncheckedBuffer != nullptr)
-        {
-            m_OnUncheckedBuffer = OnUncheckedBuffer;
-        }
-        if(OnStartHoverBuffer != nullptr)
-        {
-            m_OnStartHoverBuffer = OnStartHoverBuffer;
-        }
-        if(OnEndHoverBuffer != nullptr)
-        {
-            m_OnEndHoverBuffer = OnEndHoverBuffer;
+        m_sounds = SoundSet::Merge(m_sounds, OnCheckedBuffer, OnUncheckedBuffer, OnStartHoverBuffer, OnEndHoverBuffer);
+    }
+
+    sf::FloatRect CheckBox::GetGlobalBounds() const
+    {
+        return m_backrect.getGlobalBounds();
+    }
+
+    const char* CheckBox::GetTypeName() const
+    {
+        return "CheckBox";
+    }
+
+    MemoryUsage CheckBox::GetMemoryUsage() const
+    {
+        MemoryUsage usage = Widget::GetMemoryUsage();
+        usage.objectBytes = sizeof(CheckBox);
+        // both rectangles are drawn as triangle fans
+        usage.heapBytes += (m_backrect.getPointCount() + 2) * sizeof(sf::Vertex);
+        usage.heapBytes += (m_checkrect.getPointCount() + 2) * sizeof(sf::Vertex);
+        return usage;
+    }
+
+    void CheckBox::ApplyStyle()
+    {
+        Invalidate();
+        m_backrect.setFillColor(GetStyle().GetColor(StylePart::Body, GetStyleState()));
+        m_checkrect.setFillColor(GetStyle().GetColor(StylePart::Accent, StyleState::Default));
+    }
+
+    StyleState CheckBox::GetStyleState() const
+    {
+        if (m_isChecked) {
+            return m_isMouseOver ? StyleState::CheckedHover : StyleState::Checked;
         }
+        return m_isMouseOver ? StyleState::Hover : StyleState::Default;
     }
 
     void CheckBox::OnStartHover()
     {
         m_isMouseOver = true;
     
-        if (m_sound.getBuffer() == m_OnStartHoverBuffer.get())
-        {
-            m_sound.play();
-        }
-        else if (m_OnStartHoverBuffer)
-        {
-            m_sound.setBuffer(*m_OnStartHoverBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::StartHover);
 
         // action when mouse over
         // darken the check box
-        const sf::Color darkColor = sf::Color(
-            static_cast<sf::Uint8>(static_cast<float>(m_color.r) * 0.75f),
-            static_cast<sf::Uint8>(static_cast<float>(m_color.g) * 0.75f),
-            static_cast<sf::Uint8>(static_cast<float>(m_color.b) * 0.75f),
-            m_color.a
-        );
-        m_backrect.setFillColor(darkColor);
+        m_backrect.setFillColor(GetStyle().GetColor(StylePart::Body, GetStyleState()));
     }
 
     void CheckBox::OnEndHover()
@@ -153,7 +165,7 @@ namespace GUICPP
         m_isMouseOver = false;
         // action when mouse not over
         // reset color of the check box
-        SetColor(m_color);
+        m_backrect.setFillColor(GetStyle().GetColor(StylePart::Body, GetStyleState()));
     }
 
     void CheckBox::OnClick()
@@ -166,41 +178,15 @@ namespace GUICPP
         if (m_wasClicked && !away)
         {
             m_isChecked = !m_isChecked;
-            if(m_isChecked)
-            {
-                if(m_OnCheckedBuffer)
-                {
-                    if(m_sound.getBuffer() == m_OnCheckedBuffer.get())
-                    {
-                        m_sound.play();
-                    }
-                    else if(m_OnCheckedBuffer)
-                    {
-                        m_sound.setBuffer(*m_OnCheckedBuffer);
-                        m_sound.play();
-                    }
-                }
-            }
-            else
-            {
-                if(m_OnUncheckedBuffer)
-                {
-                    if(m_sound.getBuffer() == m_OnUncheckedBuffer.get())
-                    {
-                        m_sound.play();
-                    }
-                    else if(m_OnUncheckedBuffer)
-                    {
-                        m_sound.setBuffer(*m_OnUncheckedBuffer);
-                        m_sound.play();
-                    }
-                }
-            }
+
+            PlaySound(m_isChecked ? SoundEvent::Press : SoundEvent::Release);
         }
         m_wasClicked = false;
 
         if(m_delegate && !away)
         {
+            GUICPP_PROFILE_WIDGET(this, Delegate);
+            GUICPP_TRACE_SCOPE("delegate", GetTypeName());
             m_delegate(m_isChecked);
         }
     }
@@ -0,0 +1,135 @@
+#include "Widgets/ProfilerOverlay.h"
+
+#include <cstdio>
+
+#include "FontRegistry.h"
+
+namespace GUICPP
+{
+
+    namespace
+    {
+        constexpr float Padding = 4.f;
+        const sf::Time RefreshInterval = sf::milliseconds(250);
+
+        double ToMilliseconds(std::chrono::nanoseconds time)
+        {
+            return std::chrono::duration<double, std::milli>(time).count();
+        }
+
+        double GetTotal(const std::array<std::chrono::nanoseconds, static_cast<size_t>(ProfileSection::Count)>& times)
+        {
+            std::chrono::nanoseconds total{ 0 };
+            for (const std::chrono::nanoseconds time : times) {
+                total += time;
+            }
+            return ToMilliseconds(total);
+        }
+    }
+
+    ProfilerOverlay::ProfilerOverlay(const sf::Vector2f& position, size_t widgetCount, unsigned int characterSize)
+        : Widget(position, {}, sf::Color::White), m_widgetCount(widgetCount), m_characterSize(characterSize),
+          m_font(FontRegistry::GetInstance().GetFont(FontRegistry::DefaultFamily))
+    {
+        m_background.setPosition(position);
+        m_background.setFillColor(sf::Color(0, 0, 0, 160));
+    }
+
+    bool ProfilerOverlay::HandleEvents(const sf::Event& /*e*/)
+    {
+        return false;
+    }
+
+    void ProfilerOverlay::Draw(sf::RenderStates& states)
+    {
+        if(m_sink == nullptr) {
+            throw std::runtime_error("Render sink is nullptr");
+        }
+        if (!m_textLayout || (m_refreshClock.getElapsedTime() >= RefreshInterval
+                              && Profiler::GetInstance().GetLastFrame().frame != m_shownFrame)) {
+            Refresh();
+        }
+        if (!m_textLayout)
+            return;
+
+        m_sink->Draw(m_background, states);
+        sf::RenderStates textStates = states;
+        textStates.transform.translate(m_position + sf::Vector2f(Padding, Padding));
+        m_sink->Draw(*m_textLayout, textStates);
+    }
+
+    void ProfilerOverlay::Refresh()
+    {
+        m_refreshClock.restart();
+        if (!m_font)
+            return;
+
+        std::string text;
+        char line[128];
+        if (!Profiler::IsEnabled()) {
+            text = "Profiler compiled out, build with GUICPP_PROFILE";
+        } else {
+            const FrameProfile& frame = Profiler::GetInstance().GetLastFrame();
+            m_shownFrame = frame.frame;
+            const auto events = static_cast<size_t>(ProfileSection::HandleEvents);
+            const auto draw = static_cast<size_t>(ProfileSection::Draw);
+            std::snprintf(line, sizeof(line), "frame %zu\n%zu events, %zu widgets visited, %.3f ms\n",
+                          frame.frame, frame.eventCount, frame.widgetsVisited, ToMilliseconds(frame.times[events]));
+            text += line;
+            std::snprintf(line, sizeof(line), "draw %.3f ms, %zu draw calls, %zu texture switches",
+                          ToMilliseconds(frame.times[draw]), frame.drawCalls, frame.textureSwitches);
+            text += line;
+            for (const WidgetProfile& widget : Profiler::GetInstance().GetSlowestWidgets(m_widgetCount)) {
+                std::snprintf(line, sizeof(line), "\n%s %p: %.3f ms", widget.typeName,
+                              static_cast<const void*>(widget.widget), GetTotal(widget.times));
+                text += line;
+            }
+        }
+
+        // a new layout each refresh, the cache of TextLayout::Get would fill with stale frames
+        m_textLayout = std::make_shared<const TextLayout>(text, *m_font, m_characterSize, m_color);
+        const sf::FloatRect& bounds = m_textLayout->GetBounds();
+        m_size = { bounds.left + bounds.width + Padding * 2.f, bounds.top + bounds.height + Padding * 2.f };
+        m_background.setSize(m_size);
+    }
+
+    void ProfilerOverlay::Move(const sf::Vector2f& position)
+    {
+        Invalidate();
+        m_position = position;
+        m_background.setPosition(position);
+    }
+
+    void ProfilerOverlay::SetColor(const sf::Color& color)
+    {
+        Invalidate();
+        m_color = color;
+        m_textLayout.reset();
+    }
+
+    void ProfilerOverlay::SetSize(const sf::Vector2f& /*size*/)
+    {
+    }
+
+    void ProfilerOverlay::SetPosition(sf::Vector2f position)
+    {
+        Move(position);
+    }
+
+    const char* ProfilerOverlay::GetTypeName() const
+    {
+        return "ProfilerOverlay";
+    }
+
+    MemoryUsage ProfilerOverlay::GetMemoryUsage() const
+    {
+        MemoryUsage usage = Widget::GetMemoryUsage();
+        usage.objectBytes = sizeof(ProfilerOverlay);
+        usage.heapBytes += (m_background.getPointCount() + 2) * sizeof(sf::Vertex);
+        if (m_textLayout) {
+            usage.heapBytes += m_textLayout->GetMemoryBytes();
+        }
+        return usage;
+    }
+
+}
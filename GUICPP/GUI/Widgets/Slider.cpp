@@ -1,15 +1,22 @@
 #include "Widgets/Slider.h"
 
+#include <algorithm>
+
 namespace GUICPP
 {
     
     Slider::Slider(const sf::Vector2f& position, const sf::Vector2f& size, 
-                   const sf::Color& barColor, const sf::Color& sliderColor, bool isVertical): Widget(position, size, barColor),
-                                                                                              m_barColor(barColor), m_sliderColor(sliderColor),
-                                                                                              m_isVertical(isVertical)
+                   const std::optional<sf::Color>& barColor, const std::optional<sf::Color>& sliderColor, bool isVertical)
+        : Widget(position, size, barColor.value_or(sf::Color::White)), m_isVertical(isVertical)
     {
+        BindStyle("Slider");
+        EditStyle([&](StyleOverrides& overrides) {
+            overrides.bodyColor = barColor;
+            overrides.accentColor = sliderColor;
+        });
+
         m_bar.setSize(size);
-        m_bar.setFillColor(barColor);
+        m_bar.setFillColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
         m_bar.setPosition(position);
         m_bar.setOrigin(size.x / 2, size.y / 2);
 
@@ -26,24 +33,27 @@ namespace GUICPP
         }
         m_cursor.setOrigin(m_cursor.getSize().x / 2, m_cursor.getSize().y / 2);
     
-        m_cursor.setFillColor(sliderColor);
+        m_cursor.setFillColor(GetStyle().GetColor(StylePart::Accent, StyleState::Default));
         Slider::SetCursorPosition(position);
     }
 
     void Slider::Move(const sf::Vector2f& position)
     {
+        Invalidate();
         m_bar.setPosition(position);
         SetCursorPosition(position);
     }
 
     void Slider::SetColor(const sf::Color& color)
     {
+        Invalidate();
         m_bar.setFillColor(color);
         m_cursor.setFillColor(color);
     }
 
     void Slider::SetSize(const sf::Vector2f& size)
     {
+        Invalidate();
 
         m_bar.setSize(size);
         if(m_isVertical)
@@ -60,6 +70,7 @@ namespace GUICPP
 
     void Slider::SetPosition(sf::Vector2f position)
     {
+        Invalidate();
         m_bar.setPosition(position);
         SetCursorPosition(position);
     }
@@ -67,7 +78,9 @@ namespace GUICPP
 
     void Slider::SetBarColor(const sf::Color& color)
     {
-        m_barColor = color;
+        Invalidate();
+        m_color = color;
+        EditStyle([&color](StyleOverrides& overrides) { overrides.bodyColor = color; });
         if (!m_isMouseOver) {
             m_bar.setFillColor(color);
         }
@@ -75,7 +88,8 @@ namespace GUICPP
 
     void Slider::SetSliderColor(const sf::Color& color)
     {
-        m_sliderColor = color;
+        Invalidate();
+        EditStyle([&color](StyleOverrides& overrides) { overrides.accentColor = color; });
         if (!m_isMouseOver) {
             m_cursor.setFillColor(color);
         }
@@ -83,18 +97,21 @@ namespace GUICPP
 
     void Slider::SetCursorSize(const sf::Vector2f& size)
     {
+        Invalidate();
         m_cursor.setSize(size);
         SetCursorPosition(m_bar.getPosition());
     }
 
     void Slider::SetSliderValue(const sf::Vector2f& position, float value)
     {
+        Invalidate();
         m_value = value;
         SetCursorPosition(position);
     }
 
     void Slider::SetSliderVertical(bool isVertical)
     {
+        Invalidate();
 
         if(m_isVertical == isVertical)
         {
@@ -117,17 +134,41 @@ namespace GUICPP
         const std::shared_ptr<sf::SoundBuffer>& OnStartHoverBuffer,
         const std::shared_ptr<sf::SoundBuffer>& OnEndHoverBuffer)
     {
-        if(OnClickedBuffer)
-            m_OnClickBuffer = OnClickedBuffer;
-    
-        if(OnReleasedBuffer)
-            m_OnReleasedBuffer = OnReleasedBuffer;
+        m_sounds = SoundSet::Merge(m_sounds, OnClickedBuffer, OnReleasedBuffer, OnStartHoverBuffer, OnEndHoverBuffer);
+    }
 
-        if(OnStartHoverBuffer)
-            m_OnStartHoverBuffer = OnStartHoverBuffer;
+    sf::FloatRect Slider::GetGlobalBounds() const
+    {
+        // the cursor overhangs the bar
+        const sf::FloatRect bar = m_bar.getGlobalBounds();
+        const sf::FloatRect cursor = m_cursor.getGlobalBounds();
+        const float left = std::min(bar.left, cursor.left);
+        const float top = std::min(bar.top, cursor.top);
+        return { left, top, std::max(bar.left + bar.width, cursor.left + cursor.width) - left,
+                 std::max(bar.top + bar.height, cursor.top + cursor.height) - top };
+    }
 
-        if(OnEndHoverBuffer)
-            m_OnEndHoverBuffer = OnEndHoverBuffer;
+    const char* Slider::GetTypeName() const
+    {
+        return "Slider";
+    }
+
+    MemoryUsage Slider::GetMemoryUsage() const
+    {
+        MemoryUsage usage = Widget::GetMemoryUsage();
+        usage.objectBytes = sizeof(Slider);
+        // both rectangles are drawn as triangle fans
+        usage.heapBytes += (m_bar.getPointCount() + 2) * sizeof(sf::Vertex);
+        usage.heapBytes += (m_cursor.getPointCount() + 2) * sizeof(sf::Vertex);
+        return usage;
+    }
+
+    void Slider::ApplyStyle()
+    {
+        Invalidate();
+        const StyleState state = m_isMouseOver ? StyleState::Hover : StyleState::Default;
+        m_bar.setFillColor(GetStyle().GetColor(StylePart::Body, state));
+        m_cursor.setFillColor(GetStyle().GetColor(StylePart::Accent, state));
     }
 
     void Slider::ComputeValue(const sf::Vector2f position)
@@ -146,10 +187,7 @@ namespace GUICPP
     bool Slider::HandleEvents(const sf::Event& e) {
         const sf::FloatRect hitboxBar = m_bar.getGlobalBounds();
         const sf::FloatRect hitboxIndicator = m_cursor.getGlobalBounds();
-        const sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-
-        // convert it to world coordinates
-        const sf::Vector2f worldPos = m_window->mapPixelToCoords(mousePos);
+        const sf::Vector2f worldPos = GetPointerPosition();
 
         const bool isBarHovered = hitboxBar.contains(static_cast<float>(worldPos.x), static_cast<float>(worldPos.y));
         const bool isCursorHovered = hitboxIndicator.contains(static_cast<float>(worldPos.x), static_cast<float>(worldPos.y));
@@ -186,111 +224,85 @@ namespace GUICPP
     }
 
     void Slider::Draw(sf::RenderStates& states) {
-        m_window->draw(m_bar, states);
-        m_window->draw(m_cursor, states);
+        m_sink->Draw(m_bar, states);
+        m_sink->Draw(m_cursor, states);
     }
 
     void Slider::OnStartHover() {
         m_isMouseOver = true;
 
-        if(m_sound.getBuffer() == m_OnEndHoverBuffer.get())
-        {
-            m_sound.play();
-        }
-        else if (m_OnStartHoverBuffer) {
-            m_sound.setBuffer(*m_OnStartHoverBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::StartHover);
     
-        m_bar.setFillColor(sf::Color(
-            static_cast<sf::Uint8>(static_cast<float>(m_barColor.r) * 0.925f),
-            static_cast<sf::Uint8>(static_cast<float>(m_barColor.g) * 0.925f),
-            static_cast<sf::Uint8>(static_cast<float>(m_barColor.b) * 0.925f),
-            m_barColor.a));
-
-        m_cursor.setFillColor(sf::Color(
-            static_cast<sf::Uint8>(static_cast<float>(m_sliderColor.r) * 0.925f),
-            static_cast<sf::Uint8>(static_cast<float>(m_sliderColor.g) * 0.925f),
-            static_cast<sf::Uint8>(static_cast<float>(m_sliderColor.b) * 0.925f),
-            m_sliderColor.a));
+        m_bar.setFillColor(GetStyle().GetColor(StylePart::Body, StyleState::Hover));
+        m_cursor.setFillColor(GetStyle().GetColor(StylePart::Accent, StyleState::Hover));
     }
 
     void Slider::OnEndHover()
     {
         m_isMouseOver = false;
     
-        if (m_sound.getBuffer() == m_OnStartHoverBuffer.get()) {
-            m_sound.stop();
-        }
-        else if (m_OnEndHoverBuffer) {
-            m_sound.setBuffer(*m_OnEndHoverBuffer);
-            m_sound.play();
+        // cut the hover sound short, or play the end hover one if it already finished
+        if (!StopSound(SoundEvent::StartHover)) {
+            PlaySound(SoundEvent::EndHover);
         }
     
-        m_bar.setFillColor(m_barColor);
-        m_cursor.setFillColor(m_sliderColor);
+        m_bar.setFillColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
+        m_cursor.setFillColor(GetStyle().GetColor(StylePart::Accent, StyleState::Default));
     }
 
     void Slider::OnClick(bool isCursorClicked) {
         m_isMousePressed = true;
-        if (m_sound.getBuffer() == m_OnEndHoverBuffer.get()) {
-            m_sound.play();
-        }
-        else if (m_OnClickBuffer) {
-            m_sound.setBuffer(*m_OnClickBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::Press);
 
         if(!isCursorClicked)
         {
             // project mouse position on bar and place cursor there if isCursorClicked is false
-            const sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-            // convert it to world coordinates
-            const sf::Vector2f worldPos = m_window->mapPixelToCoords(mousePos);
+            const sf::Vector2f worldPos = GetPointerPosition();
     
             ComputeValue(sf::Vector2f(static_cast<float>(worldPos.x), static_cast<float>(worldPos.y)));
 
             SetCursorPosition(m_position);
 
             if(m_delegate)
+            {
+                GUICPP_PROFILE_WIDGET(this, Delegate);
+                GUICPP_TRACE_SCOPE("delegate", GetTypeName());
                 m_delegate(m_value);
+            }
         }
     }
 
     void Slider::OnReleased(bool away) {
         m_isMousePressed = false;
 
-        if(m_sound.getBuffer() == m_OnClickBuffer.get())
-        {
-            m_sound.play();
-        }
-        else if (m_OnReleasedBuffer) {
-            m_sound.setBuffer(*m_OnReleasedBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::Release);
     
         if (away) {
             m_isMouseOver = false;
-            m_bar.setFillColor(m_barColor);
-            m_cursor.setFillColor(m_sliderColor);
+            m_bar.setFillColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
+            m_cursor.setFillColor(GetStyle().GetColor(StylePart::Accent, StyleState::Default));
         }
     }
 
     void Slider::OnMouseHold()
     {
         // move slider to mouse position projected on bar
-        const sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-        const sf::Vector2f worldPos = m_window->mapPixelToCoords(mousePos);
+        const sf::Vector2f worldPos = GetPointerPosition();
 
         ComputeValue(worldPos);
 
         SetCursorPosition(m_position);
     
         if(m_delegate)
+        {
+            GUICPP_PROFILE_WIDGET(this, Delegate);
+            GUICPP_TRACE_SCOPE("delegate", GetTypeName());
             m_delegate(m_value);
+        }
     }
 
     void Slider::SetCursorPosition(const sf::Vector2f& position) {
+        Invalidate();
         sf::Vector2f midSliderPosition;
         if (m_isVertical) {
             midSliderPosition.x = position.x;
@@ -1,30 +1,33 @@
 #include "Widgets/button.h"
 
+#include "FontRegistry.h"
+#include "TextBatch.h"
+
 namespace GUICPP
 {
     
-    Button::Button(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& color,
-                   const std::string& text, unsigned int characterSize): Widget(position, size, color)
+    Button::Button(const sf::Vector2f& position, const sf::Vector2f& size, const std::optional<sf::Color>& color,
+                   const std::string& text, unsigned int characterSize): Widget(position, size, color.value_or(sf::Color::White))
     {
+        BindStyle("Button");
+        // only a colour given by the caller is kept over the theme
+        EditStyle([&color](StyleOverrides& overrides) { overrides.bodyColor = color; });
+
         m_rect.setSize(m_size);
         m_rect.setPosition(m_position);
-        m_rect.setFillColor(m_color);
+        m_rect.setFillColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
     
-        m_text.setString(text);
-        m_text.setCharacterSize(characterSize);
-        m_text.setFillColor(sf::Color::Black);
-        m_text.setOrigin(m_text.getLocalBounds().width / 2.0f, m_text.getLocalBounds().height / 2.0f);
-        m_text.setPosition(m_position.x + (m_size.x / 2.0f), m_position.y + (m_size.y / 2.0f));
+        m_string = text;
+        m_characterSize = characterSize;
+        m_textColor = GetStyle().GetColor(StylePart::Accent, StyleState::Default);
+        m_textTransform.setPosition(m_position.x + (m_size.x / 2.0f), m_position.y + (m_size.y / 2.0f));
     }
 
     bool Button::HandleEvents(const sf::Event& e) {
         if(m_window == nullptr)
             throw std::runtime_error("Window is nullptr");
     
-        const sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-    
-        // convert it to world coordinates
-        const sf::Vector2f worldPos = m_window->mapPixelToCoords(mousePos);
+        const sf::Vector2f worldPos = GetPointerPosition();
 
         // Check if the mouse is outside the button bounds
         if (!m_rect.getGlobalBounds().contains(static_cast<float>(worldPos.x), static_cast<float>(worldPos.y)))
@@ -56,104 +59,140 @@ namespace GUICPP
     }
 
     void Button::Draw(sf::RenderStates& states) {
-        if(m_window == nullptr) {
-            throw std::runtime_error("Window is nullptr");
+        if(m_sink == nullptr) {
+            throw std::runtime_error("Render sink is nullptr");
+        }
+        m_sink->Draw(m_rect, states);
+        if (!m_textLayout)
+            return;
+
+        sf::Transform textTransform = states.transform;
+        textTransform.combine(m_textTransform.getTransform());
+        if (m_textBatch != nullptr) {
+            m_textBatch->Add(*m_textLayout, textTransform);
+        } else {
+            sf::RenderStates textStates = states;
+            textStates.transform = textTransform;
+            m_sink->Draw(*m_textLayout, textStates);
         }
-        m_window->draw(m_rect, states);
-        m_window->draw(m_text, states);
     }
 
     void Button::Move(const sf::Vector2f& position) {
+        Invalidate();
         m_position = position;
         m_rect.setPosition(position);
-        m_text.setPosition(position.x + (m_size.x / 2.0f), position.y + (m_size.y / 2.0f));
+        m_textTransform.setPosition(position.x + (m_size.x / 2.0f), position.y + (m_size.y / 2.0f));
     }
 
     void Button::SetColor(const sf::Color& color) {
+        Invalidate();
         m_color = color;
+        EditStyle([&color](StyleOverrides& overrides) { overrides.bodyColor = color; });
         m_rect.setFillColor(color);
     }
 
     void Button::SetSize(const sf::Vector2f& size) {
+        Invalidate();
         m_size = size;
         m_rect.setSize(size);
     }
 
     void Button::SetPosition(sf::Vector2f position)
     {
+        Invalidate();
         m_position = position;
         m_rect.setPosition(position);
-        m_text.setPosition(position.x + (m_size.x / 2.0f), position.y + (m_size.y / 2.0f));
+        m_textTransform.setPosition(position.x + (m_size.x / 2.0f), position.y + (m_size.y / 2.0f));
     }
 
     void Button::SetSound(const std::shared_ptr<sf::SoundBuffer>& OnClickBuffer, const std::shared_ptr<sf::SoundBuffer>& OnReleasedBuffer,
                           const std::shared_ptr<sf::SoundBuffer>& OnStartHoverBuffer, const std::shared_ptr<sf::SoundBuffer>& OnEndHoverBuffer)
     {
-        if (OnClickBuffer)
-        {
-            m_OnClickBuffer = OnClickBuffer;
+        m_sounds = SoundSet::Merge(m_sounds, OnClickBuffer, OnReleasedBuffer, OnStartHoverBuffer, OnEndHoverBuffer);
+    }
+
+    sf::FloatRect Button::GetGlobalBounds() const
+    {
+        return m_rect.getGlobalBounds();
+    }
+
+    const char* Button::GetTypeName() const
+    {
+        return "Button";
+    }
+
+    MemoryUsage Button::GetMemoryUsage() const
+    {
+        MemoryUsage usage = Widget::GetMemoryUsage();
+        usage.objectBytes = sizeof(Button);
+        // the string is kept as UTF-32, the rectangle is a triangle fan
+        usage.heapBytes += m_string.getSize() * sizeof(sf::Uint32);
+        usage.heapBytes += (m_rect.getPointCount() + 2) * sizeof(sf::Vertex);
+        // the laid out texts are shared by every Button showing the same string, this one may hold each up to three times
+        const auto addShare = [&](const std::shared_ptr<const TextLayout>& layout) {
+            const long holders = (m_textLayout == layout) + (m_releasedTextLayout == layout) + (m_pressedTextLayout == layout);
+            usage.sharedBytes += layout->GetMemoryBytes() * holders / layout.use_count();
+        };
+        if (m_releasedTextLayout) {
+            addShare(m_releasedTextLayout);
         }
-        if (OnReleasedBuffer)
-        {
-            m_OnReleasedBuffer = OnReleasedBuffer;
+        if (m_pressedTextLayout && m_pressedTextLayout != m_releasedTextLayout) {
+            addShare(m_pressedTextLayout);
         }
-        if (OnStartHoverBuffer)
-        {
-            m_OnStartHoverBuffer = OnStartHoverBuffer;
+        return usage;
+    }
+
+    void Button::ApplyStyle()
+    {
+        Invalidate();
+        const Style& style = GetStyle();
+        if (const sf::Font* font = style.GetFont()) {
+            SetFont(*font);
         }
-        if (OnEndHoverBuffer)
-        {
-            m_OnEndHoverBuffer = OnEndHoverBuffer;
+        const sf::Color textColor = style.GetColor(StylePart::Accent, StyleState::Default);
+        if (textColor != m_textColor) {
+            m_textColor = textColor;
+            UpdateText();
+        }
+
+        StyleState state = StyleState::Default;
+        if (m_wasClicked) {
+            state = StyleState::Pressed;
+        } else if (m_isMouseOver) {
+            state = StyleState::Hover;
         }
+        m_rect.setFillColor(style.GetColor(StylePart::Body, state));
     }
 
     void Button::OnStartHover() {
-        if (m_sound.getBuffer() == m_OnStartHoverBuffer.get()) {
-            m_sound.play();
-        }
-        else if(m_OnStartHoverBuffer)
-        {
-            m_sound.setBuffer(*m_OnStartHoverBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::StartHover);
 
         m_isMouseOver = true;
-        m_rect.setFillColor(sf::Color(static_cast<sf::Uint8>(static_cast<float>(m_color.r) * 0.75f),
-                                      static_cast<sf::Uint8>(static_cast<float>(m_color.g) * 0.75f),
-                                      static_cast<sf::Uint8>(static_cast<float>(m_color.b) * 0.75f),
-                                      m_color.a));
+        m_rect.setFillColor(GetStyle().GetColor(StylePart::Body, StyleState::Hover));
     }
 
     void Button::OnEndHover()
     {
-        if (m_sound.getBuffer() == m_OnEndHoverBuffer.get()) {
-            m_sound.play();
-        }
-        else if(m_OnEndHoverBuffer)
-        {
-            m_sound.setBuffer(*m_OnEndHoverBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::EndHover);
         
         m_isMouseOver = false;
-        m_rect.setFillColor(m_color);
+        m_rect.setFillColor(GetStyle().GetColor(StylePart::Body, StyleState::Default));
     }
 
     void Button::OnClick() {
-        if (m_sound.getBuffer() == m_OnClickBuffer.get()) {
-            m_sound.play();
-        }
-        else if (m_OnClickBuffer)
-        {
-            m_sound.setBuffer(*m_OnClickBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::Press);
     
-        const unsigned int cSize = m_text.getCharacterSize();
-        m_text.setCharacterSize(cSize - 1);
-        m_text.setOrigin(m_text.getLocalBounds().width / 2.0f, m_text.getLocalBounds().height / 2.0f);
         m_wasClicked = true;
+        if (m_pressFeedback == PressFeedback::Transform) {
+            // one character size smaller, without looking up any glyph
+            const float scale = m_characterSize > 1 ? static_cast<float>(m_characterSize - 1) / m_characterSize : 1.f;
+            m_textTransform.setScale(scale, scale);
+        } else {
+            SelectTextLayout();
+        }
 
+        m_rect.setFillColor(GetStyle().GetColor(StylePart::Body, StyleState::Pressed));
+        Invalidate();
         m_rect.setScale(0.975f, 0.975f);
         m_rect.move(3, 3);
     }
@@ -161,53 +200,128 @@ namespace GUICPP
     void Button::OnReleased(bool away) {
         m_wasClicked = false;
     
-        if (m_sound.getBuffer() == m_OnReleasedBuffer.get())
-        {
-            m_sound.play();        
-        }
-        else if(m_OnReleasedBuffer)
-        {
-            m_sound.setBuffer(*m_OnReleasedBuffer);
-            m_sound.play();
-        }
+        PlaySound(SoundEvent::Release);
 
-        const unsigned int cSize = m_text.getCharacterSize();
-        m_text.setCharacterSize(cSize + 1);
-        m_text.setOrigin(m_text.getLocalBounds().width / 2.0f, m_text.getLocalBounds().height / 2.0f);
+        if (m_pressFeedback == PressFeedback::Transform) {
+            m_textTransform.setScale(1.f, 1.f);
+        } else {
+            SelectTextLayout();
+        }
 
+        Invalidate();
         m_rect.setScale(1.025f, 1.025f);
         m_rect.move(-3, -3);
 
         if (m_isResetOnClicks) {
-            m_rect.setFillColor(m_color);
             m_isMouseOver = false;
         }
+        m_rect.setFillColor(GetStyle().GetColor(StylePart::Body, m_isMouseOver ? StyleState::Hover : StyleState::Default));
 
         if (m_delegate && !away) {
-            m_delegate(m_delegateArgs);
+            GUICPP_PROFILE_WIDGET(this, Delegate);
+            GUICPP_TRACE_SCOPE("delegate", GetTypeName());
+            m_delegate();
         }
     }
 
     void Button::SetFont(const sf::Font& font)
     {
-        m_text.setFont(font);
-        m_text.setPosition(m_position.x + (m_size.x / 2.0f), m_position.y + (m_size.y / 2.0f));
-        m_text.setOrigin(m_text.getLocalBounds().width / 2.0f, m_text.getLocalBounds().height / 2.0f);
+        // not owned, the cached layouts of the font are dropped once no button holds it
+        SetFont(std::shared_ptr<const sf::Font>(&font, [](const sf::Font*) {}));
     }
 
-    void Button::SetText(const std::string& text)
+    void Button::SetFont(std::shared_ptr<const sf::Font> font)
     {
-        m_text.setString(text);
+        m_font = std::move(font);
+        UpdateText();
+        PrewarmText();
+    }
 
-        m_text.setPosition(m_position.x + (m_size.x / 2.0f), m_position.y + (m_size.y / 2.0f));
-        m_text.setOrigin(m_text.getLocalBounds().width / 2.0f, m_text.getLocalBounds().height / 2.0f);
+    void Button::SetText(const std::string& text)
+    {
+        m_string = text;
+        UpdateText();
+        PrewarmText();
     }
 
     void Button::SetFontSize(unsigned size)
     {
-        m_text.setCharacterSize(size);
-        m_text.setPosition(m_position.x + (m_size.x / 2.0f), m_position.y + (m_size.y / 2.0f));
-        m_text.setOrigin(m_text.getLocalBounds().width / 2.0f, m_text.getLocalBounds().height / 2.0f);
+        m_characterSize = size;
+        UpdateText();
+        PrewarmText();
+    }
+
+    void Button::SetSdfFont(std::shared_ptr<SdfFont> font)
+    {
+        m_sdfFont = std::move(font);
+        UpdateText();
+        PrewarmText();
+    }
+
+    void Button::SetTextStyle(sf::Uint32 style)
+    {
+        m_textStyle = style;
+        UpdateText();
+        PrewarmText();
+    }
+
+    void Button::SetPressFeedback(PressFeedback feedback)
+    {
+        m_pressFeedback = feedback;
+        m_textTransform.setScale(1.f, 1.f);
+        UpdateText();
+        if (m_wasClicked && feedback == PressFeedback::Transform) {
+            const float scale = m_characterSize > 1 ? static_cast<float>(m_characterSize - 1) / m_characterSize : 1.f;
+            m_textTransform.setScale(scale, scale);
+        }
+        PrewarmText();
+    }
+
+    void Button::UpdateText()
+    {
+        Invalidate();
+        const bool isSdf = m_sdfFont && m_sdfFont->IsAvailable();
+        if (m_font == nullptr && !isSdf)
+            return;
+
+        const auto layOut = [&](unsigned int size) {
+            return isSdf ? TextLayout::Get(m_string, m_sdfFont, size, m_textColor, m_textStyle)
+                         : TextLayout::Get(m_string, m_font, size, m_textColor, m_textStyle);
+        };
+        // the pressed size is laid out now, pressing only swaps the layouts
+        m_releasedTextLayout = layOut(m_characterSize);
+        m_pressedTextLayout = m_pressFeedback == PressFeedback::Resize && m_characterSize > 1
+            ? layOut(m_characterSize - 1) : m_releasedTextLayout;
+        SelectTextLayout();
+    }
+
+    void Button::SelectTextLayout()
+    {
+        Invalidate();
+        m_textLayout = m_wasClicked ? m_pressedTextLayout : m_releasedTextLayout;
+        if (!m_textLayout)
+            return;
+
+        const sf::FloatRect& bounds = m_textLayout->GetBounds();
+        m_textTransform.setOrigin(bounds.width / 2.0f, bounds.height / 2.0f);
+        m_textTransform.setPosition(m_position.x + (m_size.x / 2.0f), m_position.y + (m_size.y / 2.0f));
+    }
+
+    void Button::PrewarmText() const
+    {
+        // one atlas serves every size
+        if (m_sdfFont && m_sdfFont->IsAvailable()) {
+            m_sdfFont->AddGlyphs(m_string);
+            return;
+        }
+        if (m_font == nullptr)
+            return;
+        // only the resize feedback draws the pressed size
+        std::vector<unsigned int> sizes = { m_characterSize };
+        if (m_pressFeedback == PressFeedback::Resize && m_characterSize > 1) {
+            sizes.push_back(m_characterSize - 1);
+        }
+        FontRegistry::Prewarm(*m_font, m_string, sizes, (m_textStyle & sf::Text::Bold) != 0);
     }
     
 }
\ No newline at end of file
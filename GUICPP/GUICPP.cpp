@@ -2,6 +2,7 @@
 //
 
 #include <ctime>
+#include <filesystem>
 #include <iostream>
 #include <SFML/Graphics.hpp>
 #include <SFML/OpenGL.hpp>
@@ -24,35 +25,54 @@ int main()
     // seed random number generator
     srand(static_cast<unsigned>(time(nullptr)) );  // NOLINT(cert-msc51-cpp)
 
+    // load the assets from the packed archive when it was built, from the Assets folder otherwise
+    if (std::filesystem::exists("./Assets.gcpk"))
+    {
+        GUICPP::AssetCache::GetInstance().MountPack("./Assets.gcpk");
+    }
+
     auto  window = sf::RenderWindow(sf::VideoMode(1024, 768), "GUI CPP");
 
     sf::Clock clock;
 
     Game game(window);
 
-    while (window.isOpen())
+    // the window is drawn by its own thread, replaying the frames recorded by this one
+    GUICPP::RenderThread renderThread(window);
+    renderThread.SetClearColor(sf::Color(100,149,237));
+
+    bool isRunning = true;
+    while (isRunning)
     {
-        //Get delta time
-        float dt = clock.restart().asSeconds();
-        
+        // sleep until an event comes or the GUI has something to draw
         sf::Event event{};
-        while (window.pollEvent(event))
+        while (isRunning && game.WaitEvent(event))
         {
             game.HandleEvents(event);
+            // the window is closed once the render thread has released it
             if (event.type == sf::Event::Closed) 
             {
-                window.close();
+                isRunning = false;
             }
         }
+        if (!isRunning)
+        {
+            break;
+        }
+
+        //Get delta time
+        float dt = clock.restart().asSeconds();
 
         if(dt  < 0.1f || IsDebuggerPresent())
         {
             game.Update(dt);
         }
 
-        //Draw
-        window.clear(sf::Color(100,149,237));
-        game.Draw();
-        window.display();  
+        //Record what changed since the last frame, drawn while the next events are handled
+        if (game.NeedsRedraw())
+        {
+            game.Record(renderThread.GetRecordList());
+            renderThread.Submit();
+        }
     }
 }
@@ -27,21 +27,21 @@ void sayValue(float val)
 
 Game::Game(sf::RenderWindow& window): m_window(window), m_gui(window)
 {
-    const auto buff0 = std::make_shared<sf::SoundBuffer>();
-    if(!buff0->loadFromFile("./Assets/Sounds/jump.ogg"))
-    {
-        std::cout << "Error loading sound" << std::endl; 
-    }
-    const auto buff1 = std::make_shared<sf::SoundBuffer>();
-    if(buff1->loadFromFile("./Assets/Sounds/gold.ogg"))
-    {
-        std::cout << "Error loading sound" << std::endl;
-    }
-    const auto buff2 = std::make_shared<sf::SoundBuffer>();
-    if(buff2->loadFromFile("./Assets/Sounds/gold_ground.ogg"))
-    {
-        std::cout << "Error loading sound" << std::endl;
-    }
+    // decode every asset in parallel before building the widgets, which then find them in the cache
+    m_preloader.Add({
+        "./Assets/Sounds/jump.ogg", "./Assets/Sounds/gold.ogg", "./Assets/Sounds/gold_ground.ogg",
+        "Assets/ButtonImg/Default.png", "Assets/ButtonImg/MouseOver.png", "Assets/ButtonImg/Clicked.png",
+        "Assets/CheckBoxImg/Unchecked.png", "Assets/CheckBoxImg/UncheckedMouseOver.png",
+        "Assets/CheckBoxImg/Checked.png", "Assets/CheckBoxImg/CheckedMouseOver.png",
+        "Assets/SliderImg/BarDefault.png", "Assets/SliderImg/BarMouseOver.png",
+        "Assets/SliderImg/CursorDefault.png", "Assets/SliderImg/CursorMouseOver.png"
+    });
+    m_preloader.Wait();
+
+    GUICPP::AssetCache& assets = GUICPP::AssetCache::GetInstance();
+    const auto buff0 = assets.GetSoundBuffer("./Assets/Sounds/jump.ogg");
+    const auto buff1 = assets.GetSoundBuffer("./Assets/Sounds/gold.ogg");
+    const auto buff2 = assets.GetSoundBuffer("./Assets/Sounds/gold_ground.ogg");
 
 
     const auto button1 = std::make_shared<GUICPP::Button>(sf::Vector2f(200, 200), sf::Vector2f(200, 75));
@@ -108,5 +108,21 @@ void Game::Draw() const
     m_gui.Draw(states);
 }
 
+void Game::Record(GUICPP::RenderSink& sink) const
+{
+    sf::RenderStates states = sf::RenderStates::Default;
+    m_gui.Record(sink, states);
+}
+
+bool Game::WaitEvent(sf::Event& evt) const
+{
+    return m_gui.WaitEvent(evt);
+}
+
+bool Game::NeedsRedraw() const
+{
+    return m_gui.NeedsRedraw();
+}
+
 
 
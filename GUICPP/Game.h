@@ -11,9 +11,13 @@ public:
     void HandleEvents(sf::Event evt);
     void Update(float dt);
     void Draw() const;
+    void Record(GUICPP::RenderSink& sink) const;
+    bool WaitEvent(sf::Event& evt) const;
+    bool NeedsRedraw() const;
 private:
     sf::RenderWindow& m_window;
     GUICPP::GUI m_gui;
+    GUICPP::AssetPreloader m_preloader;
 
     
     
@@ -0,0 +1,210 @@
+// AssetPacker.cpp : Offline tool building the asset pack mounted with GUICPP::AssetCache::MountPack.
+//
+// Usage: AssetPacker <assets folder> <output pack> [--decode] [--file <path>]...
+//
+// Every file of the assets folder is stored under its path relative to the parent of the folder,
+// so "Assets/Sounds/jump.ogg" is found by the same path the game loads it with. --file adds a
+// file stored under the path as given, for assets outside the folder such as the default font.
+// --decode stores images as RGBA pixels and sounds as PCM samples, trading file size for startup
+// time. Build it as a console application linked against sfml-graphics and sfml-audio, with
+// GUI/Include in the include path.
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+
+#include "AssetPack.h"
+
+namespace
+{
+    struct PackedAsset
+    {
+        std::string path;
+        GUICPP::AssetPackEntry entry{};
+        std::vector<char> data;
+    };
+
+    bool ReadFile(const std::filesystem::path& file, std::vector<char>& data)
+    {
+        std::ifstream stream(file, std::ios::binary);
+        if (!stream)
+            return false;
+        data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool DecodeImage(const std::vector<char>& encoded, PackedAsset& asset)
+    {
+        sf::Image image;
+        if (!image.loadFromMemory(encoded.data(), encoded.size()))
+            return false;
+
+        const sf::Vector2u size = image.getSize();
+        const auto* pixels = reinterpret_cast<const char*>(image.getPixelsPtr());
+        asset.data.assign(pixels, pixels + static_cast<size_t>(size.x) * size.y * 4);
+        asset.entry.payload = GUICPP::AssetPackPayload::Rgba;
+        asset.entry.width = size.x;
+        asset.entry.height = size.y;
+        return true;
+    }
+
+    bool DecodeSound(const std::vector<char>& encoded, PackedAsset& asset)
+    {
+        sf::InputSoundFile file;
+        if (!file.openFromMemory(encoded.data(), encoded.size()))
+            return false;
+
+        std::vector<sf::Int16> samples(static_cast<size_t>(file.getSampleCount()));
+        samples.resize(static_cast<size_t>(file.read(samples.data(), samples.size())));
+        const auto* bytes = reinterpret_cast<const char*>(samples.data());
+        asset.data.assign(bytes, bytes + samples.size() * sizeof(sf::Int16));
+        asset.entry.payload = GUICPP::AssetPackPayload::Pcm;
+        asset.entry.width = file.getChannelCount();
+        asset.entry.height = file.getSampleRate();
+        return true;
+    }
+
+    bool AddAsset(const std::filesystem::path& file, const std::string& path, bool decode, std::vector<PackedAsset>& assets)
+    {
+        PackedAsset asset;
+        asset.path = GUICPP::AssetPack::NormalizePath(path);
+        std::vector<char> encoded;
+        if (!ReadFile(file, encoded))
+        {
+            std::cout << "Failed to read " << file.string() << std::endl;
+            return false;
+        }
+
+        std::string extension = file.extension().string();
+        std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        bool decoded = false;
+        if (decode && (extension == ".png" || extension == ".jpg" || extension == ".bmp" || extension == ".tga"))
+            decoded = DecodeImage(encoded, asset);
+        else if (decode && (extension == ".ogg" || extension == ".wav" || extension == ".flac"))
+            decoded = DecodeSound(encoded, asset);
+
+        if (!decoded)
+        {
+            asset.data = std::move(encoded);
+            asset.entry.payload = GUICPP::AssetPackPayload::Encoded;
+        }
+        assets.push_back(std::move(asset));
+        return true;
+    }
+
+    uint64_t Align(uint64_t offset)
+    {
+        return (offset + GUICPP::AssetPack::Alignment - 1) / GUICPP::AssetPack::Alignment * GUICPP::AssetPack::Alignment;
+    }
+
+    bool WritePack(const std::string& output, std::vector<PackedAsset>& assets)
+    {
+        std::ranges::sort(assets, {}, &PackedAsset::path);
+
+        std::string pathTable;
+        for (auto& asset : assets)
+        {
+            asset.entry.pathOffset = static_cast<uint32_t>(pathTable.size());
+            asset.entry.pathLength = static_cast<uint32_t>(asset.path.size());
+            pathTable += asset.path;
+        }
+
+        GUICPP::AssetPackHeader header{};
+        std::memcpy(header.magic, "GCPK", 4);
+        header.version = GUICPP::AssetPack::Version;
+        header.entryCount = static_cast<uint32_t>(assets.size());
+        header.pathTableSize = static_cast<uint32_t>(pathTable.size());
+
+        uint64_t offset = sizeof(header) + assets.size() * sizeof(GUICPP::AssetPackEntry) + pathTable.size();
+        for (auto& asset : assets)
+        {
+            offset = Align(offset);
+            asset.entry.dataOffset = offset;
+            asset.entry.dataSize = asset.data.size();
+            offset += asset.data.size();
+        }
+
+        std::ofstream stream(output, std::ios::binary | std::ios::trunc);
+        if (!stream)
+            return false;
+
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& asset : assets)
+        {
+            stream.write(reinterpret_cast<const char*>(&asset.entry), sizeof(asset.entry));
+        }
+        stream.write(pathTable.data(), static_cast<std::streamsize>(pathTable.size()));
+        for (const auto& asset : assets)
+        {
+            const std::vector<char> padding(asset.entry.dataOffset - static_cast<uint64_t>(stream.tellp()), 0);
+            stream.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+            stream.write(asset.data.data(), static_cast<std::streamsize>(asset.data.size()));
+        }
+        return static_cast<bool>(stream);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: AssetPacker <assets folder> <output pack> [--decode] [--file <path>]..." << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path root = std::filesystem::path(argv[1]).lexically_normal();
+    if (!root.has_filename())
+        root = root.parent_path();
+    const std::string output = argv[2];
+    bool decode = false;
+    std::vector<std::string> extraFiles;
+    for (int i = 3; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--decode") == 0)
+            decode = true;
+        else if (std::strcmp(argv[i], "--file") == 0 && i + 1 < argc)
+            extraFiles.emplace_back(argv[++i]);
+        else
+        {
+            std::cout << "Unknown option " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    if (!std::filesystem::is_directory(root))
+    {
+        std::cout << root.string() << " is not a folder" << std::endl;
+        return 1;
+    }
+
+    std::vector<PackedAsset> assets;
+    const std::filesystem::path base = root.has_parent_path() ? root.parent_path() : std::filesystem::path(".");
+    for (const auto& file : std::filesystem::recursive_directory_iterator(root))
+    {
+        if (file.is_regular_file()
+            && !AddAsset(file.path(), file.path().lexically_relative(base).generic_string(), decode, assets))
+            return 1;
+    }
+    for (const auto& file : extraFiles)
+    {
+        if (!AddAsset(file, file, decode, assets))
+            return 1;
+    }
+
+    if (!WritePack(output, assets))
+    {
+        std::cout << "Failed to write " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Packed " << assets.size() << " assets into " << output << std::endl;
+    return 0;
+}
@@ -0,0 +1,268 @@
+// GUIBenchmark.cpp : Benchmark of the event dispatch and drawing of a GUI as its widget count grows.
+//
+// Usage: GUIBenchmark [largest widget count] [events per scene] [--null]
+//
+// For widget counts growing fourfold from 64, builds a synthetic scene of buttons, sliders and
+// checkboxes, one block of widgets out of two spread over groups nested four deep. A scripted
+// stream of mouse events is then replayed through GUI::HandleEvents: moves from widget to widget,
+// clicks on the buttons and checkboxes, drags along the sliders. A frame is recorded after each
+// gesture with GUI::Record into an sf::RenderTexture, waiting for the GPU, or only into a NullSink
+// with --null. The p50 and p99 times per event and per frame are printed for each widget count.
+//
+// The window of the GUI is created hidden, it only maps the pointer to the world; an X display is
+// still needed for the OpenGL context, run it with xvfb-run on a box without one. The CMake build
+// at the root of the repository builds it with the GUI library.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <SFML/OpenGL.hpp>
+
+#include "GUI.h"
+#include "Widgets/CheckBox.h"
+#include "Widgets/Slider.h"
+#include "Widgets/button.h"
+
+namespace
+{
+    constexpr unsigned int WindowWidth = 1280;
+    constexpr unsigned int WindowHeight = 720;
+    constexpr float CellWidth = 140.f;
+    constexpr float CellHeight = 50.f;
+    constexpr size_t BlockSize = 32;
+    constexpr size_t GroupDepth = 4;
+
+    enum class WidgetKind { Button, Slider, CheckBox };
+
+    // the delegates are called as in an application, doing nothing
+    void OnButtonReleased() {}
+    void OnSliderMoved(float) {}
+    void OnCheckBoxToggled(bool) {}
+
+    struct Scene
+    {
+        std::unique_ptr<GUICPP::GUI> gui;
+        std::vector<std::shared_ptr<GUICPP::Widget>> widgets;
+        std::vector<WidgetKind> kinds;
+    };
+
+    struct Percentiles
+    {
+        double p50;
+        double p99;
+    };
+
+    Percentiles ComputePercentiles(std::vector<double>& samples)
+    {
+        if (samples.empty())
+            return { 0.0, 0.0 };
+        std::ranges::sort(samples);
+        const auto at = [&samples](double ratio) {
+            return samples[std::min(samples.size() - 1, static_cast<size_t>(ratio * static_cast<double>(samples.size())))];
+        };
+        return { at(0.5), at(0.99) };
+    }
+
+    Scene BuildScene(sf::RenderWindow& window, size_t widgetCount)
+    {
+        Scene scene;
+        scene.gui = std::make_unique<GUICPP::GUI>(window);
+
+        // a grid filling the view, every widget is shown
+        const size_t columns = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(widgetCount * (WindowWidth / CellWidth) / (WindowHeight / CellHeight)))));
+        const size_t rows = (widgetCount + columns - 1) / columns;
+        window.setView(sf::View(sf::FloatRect(0.f, 0.f, columns * CellWidth, rows * CellHeight)));
+
+        std::vector<std::shared_ptr<GUICPP::Group>> groups;
+        for (size_t i = 0; i < widgetCount; ++i)
+        {
+            const sf::Vector2f cell((i % columns) * CellWidth + 10.f, (i / columns) * CellHeight + 10.f);
+            const auto kind = static_cast<WidgetKind>(i % 3);
+            std::shared_ptr<GUICPP::Widget> widget;
+            switch (kind)
+            {
+            case WidgetKind::Button: {
+                const auto button = std::make_shared<GUICPP::Button>(cell, sf::Vector2f(120.f, 30.f), sf::Color::White, "Button", 14);
+                button->SetDelegate(OnButtonReleased);
+                widget = button;
+                break;
+            }
+            case WidgetKind::Slider: {
+                const auto slider = std::make_shared<GUICPP::Slider>(cell + sf::Vector2f(0.f, 10.f), sf::Vector2f(120.f, 10.f));
+                slider->SetDelegate(OnSliderMoved);
+                widget = slider;
+                break;
+            }
+            case WidgetKind::CheckBox: {
+                const auto checkBox = std::make_shared<GUICPP::CheckBox>(cell, sf::Vector2f(30.f, 30.f));
+                checkBox->SetDelegate(OnCheckBoxToggled);
+                widget = checkBox;
+                break;
+            }
+            }
+            scene.widgets.push_back(widget);
+            scene.kinds.push_back(kind);
+
+            // every other block goes down a chain of nested groups
+            const size_t block = i / BlockSize;
+            if (block % 2 == 0)
+            {
+                scene.gui->AddWidgetToGui(widget);
+                continue;
+            }
+            if (i % BlockSize == 0)
+            {
+                groups.clear();
+                for (size_t depth = 0; depth < GroupDepth; ++depth)
+                {
+                    groups.push_back(std::make_shared<GUICPP::Group>());
+                }
+            }
+            groups[i % GroupDepth]->AddWidgetToGroup(widget);
+            if (i % BlockSize == BlockSize - 1 || i == widgetCount - 1)
+            {
+                for (size_t depth = GroupDepth - 1; depth > 0; --depth)
+                {
+                    groups[depth - 1]->AddChildGroup(groups[depth]);
+                }
+                scene.gui->AddGroupToGui(groups.front());
+            }
+        }
+        return scene;
+    }
+
+    sf::Event MakeMouseEvent(sf::Event::EventType type, const sf::Vector2i& pixel)
+    {
+        sf::Event event{};
+        event.type = type;
+        if (type == sf::Event::MouseMoved)
+        {
+            event.mouseMove = { pixel.x, pixel.y };
+        }
+        else
+        {
+            event.mouseButton = { sf::Mouse::Left, pixel.x, pixel.y };
+        }
+        return event;
+    }
+
+    // one gesture per step: reach a widget, then click it or drag along it
+    std::vector<std::vector<sf::Event>> ScriptGestures(const sf::RenderWindow& window, const Scene& scene, size_t eventCount)
+    {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<size_t> pickWidget(0, scene.widgets.size() - 1);
+        std::vector<std::vector<sf::Event>> gestures;
+        size_t scripted = 0;
+        while (scripted < eventCount)
+        {
+            const size_t index = pickWidget(random);
+            const sf::FloatRect bounds = scene.widgets[index]->GetGlobalBounds();
+            const sf::Vector2f center(bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f);
+            const sf::Vector2i pixel = window.mapCoordsToPixel(center);
+
+            std::vector<sf::Event> gesture;
+            gesture.push_back(MakeMouseEvent(sf::Event::MouseMoved, pixel));
+            gesture.push_back(MakeMouseEvent(sf::Event::MouseButtonPressed, pixel));
+            if (scene.kinds[index] == WidgetKind::Slider)
+            {
+                const sf::Vector2i end = window.mapCoordsToPixel({ bounds.left + bounds.width * 0.9f, center.y });
+                for (int step = 1; step <= 4; ++step)
+                {
+                    gesture.push_back(MakeMouseEvent(sf::Event::MouseMoved, pixel + (end - pixel) * step / 4));
+                }
+                gesture.push_back(MakeMouseEvent(sf::Event::MouseButtonReleased, end));
+            }
+            else
+            {
+                gesture.push_back(MakeMouseEvent(sf::Event::MouseButtonReleased, pixel));
+            }
+            scripted += gesture.size();
+            gestures.push_back(std::move(gesture));
+        }
+        return gestures;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t largestCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    const size_t eventCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+    const bool isNullSink = argc > 3 && std::strcmp(argv[3], "--null") == 0;
+    if (largestCount == 0 || eventCount == 0)
+    {
+        std::cout << "Usage: GUIBenchmark [largest widget count] [events per scene] [--null]" << std::endl;
+        return 1;
+    }
+
+    sf::RenderWindow window(sf::VideoMode(WindowWidth, WindowHeight), "GUIBenchmark", sf::Style::None);
+    window.setVisible(false);
+    sf::RenderTexture texture;
+    if (!isNullSink && !texture.create(WindowWidth, WindowHeight))
+    {
+        std::cout << "Error creating the render texture" << std::endl;
+        return 1;
+    }
+
+    std::cout << (isNullSink ? "Frames counted by a NullSink" : "Frames drawn into a RenderTexture") << ", times in microseconds\n";
+    std::cout << std::setw(8) << "Widgets" << std::setw(12) << "Event p50" << std::setw(12) << "Event p99"
+              << std::setw(12) << "Frame p50" << std::setw(12) << "Frame p99" << std::setw(12) << "Draw calls" << "\n";
+
+    for (size_t widgetCount = std::min<size_t>(64, largestCount); widgetCount <= largestCount; widgetCount *= 4)
+    {
+        Scene scene = BuildScene(window, widgetCount);
+        texture.setView(window.getView());
+        const auto gestures = ScriptGestures(window, scene, eventCount);
+
+        GUICPP::TargetSink textureSink(texture);
+        GUICPP::NullSink nullSink;
+        GUICPP::RenderSink& sink = isNullSink ? static_cast<GUICPP::RenderSink&>(nullSink) : textureSink;
+        sf::RenderStates states = sf::RenderStates::Default;
+        const auto drawFrame = [&] {
+            sink.ResetCounters();
+            if (!isNullSink)
+            {
+                texture.clear();
+            }
+            scene.gui->Record(sink, states);
+            if (!isNullSink)
+            {
+                texture.display();
+                glFinish();
+            }
+        };
+        // the first frame loads the glyphs and textures
+        drawFrame();
+
+        std::vector<double> eventTimes;
+        std::vector<double> frameTimes;
+        eventTimes.reserve(eventCount + 8);
+        frameTimes.reserve(gestures.size());
+        for (const auto& gesture : gestures)
+        {
+            for (const sf::Event& event : gesture)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                scene.gui->HandleEvents(event);
+                eventTimes.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            }
+            const auto start = std::chrono::steady_clock::now();
+            drawFrame();
+            frameTimes.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        const Percentiles events = ComputePercentiles(eventTimes);
+        const Percentiles frames = ComputePercentiles(frameTimes);
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(8) << widgetCount << std::setw(12) << events.p50 << std::setw(12) << events.p99
+                  << std::setw(12) << frames.p50 << std::setw(12) << frames.p99 << std::setw(12) << sink.GetDrawCallCount() << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+// HitTestBenchmark.cpp : Microbenchmark of GUICPP::HitTestBatch against testing the widgets one by one.
+//
+// Usage: HitTestBenchmark [widget count] [query count]
+//
+// Lays out a toolbar grid of buttons, then finds the topmost button under random points, first by
+// asking each widget for its bounds from the top as the event loop does, then with the packed
+// bounds of a HitTestBatch. Both must find the same buttons. The CMake build at the root of the
+// repository builds it with the GUI library; configure it with -DGUICPP_NO_SIMD=ON
+// to measure the scalar fallback.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "HitTestBatch.h"
+#include "Widgets/button.h"
+
+namespace
+{
+    constexpr float ButtonSize = 24.f;
+    constexpr float ButtonSpacing = 28.f;
+    constexpr unsigned int ButtonsPerRow = 64;
+
+    template <typename Function>
+    double MeasureNanoseconds(const std::vector<sf::Vector2f>& points, std::vector<size_t>& hits, Function&& find)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            hits[i] = find(points[i]);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(points.size());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t widgetCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2048;
+    const size_t queryCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+    if (widgetCount == 0 || queryCount == 0)
+    {
+        std::cout << "Usage: HitTestBenchmark [widget count] [query count]" << std::endl;
+        return 1;
+    }
+
+    // a toolbar grid, the gaps between the buttons are misses
+    std::vector<std::shared_ptr<GUICPP::Widget>> widgets;
+    GUICPP::HitTestBatch batch;
+    widgets.reserve(widgetCount);
+    batch.Reserve(widgetCount);
+    for (size_t i = 0; i < widgetCount; ++i)
+    {
+        const sf::Vector2f position((i % ButtonsPerRow) * ButtonSpacing, (i / ButtonsPerRow) * ButtonSpacing);
+        widgets.push_back(std::make_shared<GUICPP::Button>(position, sf::Vector2f(ButtonSize, ButtonSize), sf::Color::White, "", 12));
+        batch.Add(widgets.back()->GetGlobalBounds());
+    }
+
+    const size_t rowCount = (widgetCount + ButtonsPerRow - 1) / ButtonsPerRow;
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> x(0.f, ButtonsPerRow * ButtonSpacing);
+    std::uniform_real_distribution<float> y(0.f, rowCount * ButtonSpacing);
+    std::vector<sf::Vector2f> points(queryCount);
+    for (auto& point : points)
+    {
+        point = { x(random), y(random) };
+    }
+
+    std::vector<size_t> widgetHits(queryCount);
+    const double widgetTime = MeasureNanoseconds(points, widgetHits, [&widgets](sf::Vector2f point)
+    {
+        for (size_t index = widgets.size(); index > 0; --index)
+        {
+            if (widgets[index - 1]->GetGlobalBounds().contains(point))
+                return index - 1;
+        }
+        return GUICPP::HitTestBatch::NoHit;
+    });
+
+    std::vector<size_t> batchHits(queryCount);
+    const double batchTime = MeasureNanoseconds(points, batchHits, [&batch](sf::Vector2f point)
+    {
+        return batch.FindTopmost(point);
+    });
+
+    std::vector<size_t> scalarHits(queryCount);
+    const double scalarTime = MeasureNanoseconds(points, scalarHits, [&batch](sf::Vector2f point)
+    {
+        return batch.FindTopmostScalar(point);
+    });
+
+    if (batchHits != widgetHits || scalarHits != widgetHits)
+    {
+        std::cout << "Error: the hit test batch disagrees with the widgets" << std::endl;
+        return 1;
+    }
+
+    std::cout << widgetCount << " widgets, " << queryCount << " queries" << std::endl;
+    std::cout << "Per widget: " << widgetTime << " ns/query" << std::endl;
+    std::cout << "Batch, scalar: " << scalarTime << " ns/query" << std::endl;
+    std::cout << "Batch, " << GUICPP::HitTestBatch::GetInstructionSet() << ": " << batchTime << " ns/query" << std::endl;
+    return 0;
+}